@@ -55,12 +55,110 @@ HashMap<ClassDB::APIType, uint32_t> ClassDB::api_hashes_cache;
 void ClassDB::set_current_api(APIType p_api) {
 	DEV_ASSERT(!api_hashes_cache.has(p_api)); // This API type may not be suitable for caching of hash if it can change later.
 	current_api = p_api;
+	// Registering APIs is done, so lookups can be flattened without being rebuilt all the time.
+	lookup_tables_enabled = p_api == API_NONE;
 }
 
 ClassDB::APIType ClassDB::get_current_api() {
 	return current_api;
 }
 
+void ClassDB::_resolve_lookup_entry(const ClassInfo *p_class, const StringName &p_name, LookupEntry &r_entry) {
+	for (const ClassInfo *check = p_class; check; check = check->inherits_ptr) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_name);
+		if (psg) {
+			if (!r_entry.setget) {
+				r_entry.setget = psg;
+			}
+			if (r_entry.member == LookupEntry::MEMBER_NONE) {
+				r_entry.member = LookupEntry::MEMBER_PROPERTY;
+			}
+		}
+
+		if (r_entry.member == LookupEntry::MEMBER_NONE) {
+			const int64_t *constant = check->constant_map.getptr(p_name);
+			if (constant) {
+				r_entry.member = LookupEntry::MEMBER_CONSTANT;
+				r_entry.constant = *constant;
+			}
+		}
+
+		MethodBind *const *method = check->method_map.getptr(p_name);
+		if (method) {
+			if (!r_entry.method) {
+				r_entry.method = *method;
+			}
+			if (r_entry.member == LookupEntry::MEMBER_NONE) {
+				r_entry.member = LookupEntry::MEMBER_METHOD;
+			}
+		}
+
+		if (r_entry.member == LookupEntry::MEMBER_NONE && check->signal_map.has(p_name)) {
+			r_entry.member = LookupEntry::MEMBER_SIGNAL;
+		}
+	}
+}
+
+ClassDB::LookupTable *ClassDB::_build_lookup_table(const ClassInfo *p_class) {
+	HashSet<StringName> names;
+	for (const ClassInfo *check = p_class; check; check = check->inherits_ptr) {
+		for (const KeyValue<StringName, PropertySetGet> &E : check->property_setget) {
+			names.insert(E.key);
+		}
+		for (const KeyValue<StringName, int64_t> &E : check->constant_map) {
+			names.insert(E.key);
+		}
+		for (const KeyValue<StringName, MethodBind *> &E : check->method_map) {
+			names.insert(E.key);
+		}
+		for (const KeyValue<StringName, MethodInfo> &E : check->signal_map) {
+			names.insert(E.key);
+		}
+	}
+
+	LocalVector<Pair<StringName, LookupEntry>> entries;
+	entries.reserve(names.size());
+	for (const StringName &name : names) {
+		LookupEntry entry;
+		_resolve_lookup_entry(p_class, name, entry);
+		entries.push_back(Pair<StringName, LookupEntry>(name, entry));
+	}
+
+	LookupTable *table = memnew(LookupTable);
+	table->valid = table->entries.build(entries);
+	return table;
+}
+
+const ClassDB::LookupTable *ClassDB::_get_lookup_table(ClassInfo *p_class) {
+	if (!p_class || !lookup_tables_enabled) {
+		return nullptr;
+	}
+
+	LookupTable *table = p_class->lookup_table.table.load(std::memory_order_acquire);
+	if (unlikely(!table)) {
+		MutexLock lock(lookup_tables_mutex);
+		table = p_class->lookup_table.table.load(std::memory_order_relaxed);
+		if (!table) {
+			table = _build_lookup_table(p_class);
+			p_class->lookup_table.table.store(table, std::memory_order_release);
+			lookup_tables_count++;
+		}
+	}
+	return table->valid ? table : nullptr;
+}
+
+void ClassDB::_invalidate_lookup_tables() {
+	// Called with the write lock held, or while nothing else uses ClassDB.
+	MutexLock lock(lookup_tables_mutex);
+	if (lookup_tables_count == 0) {
+		return;
+	}
+	for (KeyValue<StringName, ClassInfo> &E : classes) {
+		E.value.lookup_table.reset();
+	}
+	lookup_tables_count = 0;
+}
+
 HashMap<StringName, ClassDB::ClassInfo> ClassDB::classes;
 HashMap<StringName, StringName> ClassDB::resource_base_extensions;
 HashMap<StringName, StringName> ClassDB::compat_classes;
@@ -842,6 +940,7 @@ use_script:
 
 void ClassDB::_add_class(const StringName &p_class, const StringName &p_inherits) {
 	Locker::Lock lock(Locker::STATE_WRITE);
+	_invalidate_lookup_tables();
 
 	const StringName &name = p_class;
 
@@ -1044,6 +1143,12 @@ MethodBind *ClassDB::get_method(const StringName &p_class, const StringName &p_n
 
 	ClassInfo *type = classes.getptr(p_class);
 
+	const LookupTable *table = _get_lookup_table(type);
+	if (table) {
+		const LookupEntry *entry = table->entries.getptr(p_name);
+		return entry ? entry->method : nullptr;
+	}
+
 	while (type) {
 		MethodBind **method = type->method_map.getptr(p_name);
 		if (method && *method) {
@@ -1110,6 +1215,7 @@ MethodBind *ClassDB::get_method_with_compatibility(const StringName &p_class, co
 
 void ClassDB::bind_integer_constant(const StringName &p_class, const StringName &p_enum, const StringName &p_name, int64_t p_constant, bool p_is_bitfield) {
 	Locker::Lock lock(Locker::STATE_WRITE);
+	_invalidate_lookup_tables();
 
 	ClassInfo *type = classes.getptr(p_class);
 
@@ -1344,6 +1450,7 @@ bool ClassDB::is_enum_bitfield(const StringName &p_class, const StringName &p_na
 
 void ClassDB::add_signal(const StringName &p_class, const MethodInfo &p_signal) {
 	Locker::Lock lock(Locker::STATE_WRITE);
+	_invalidate_lookup_tables();
 
 	ClassInfo *type = classes.getptr(p_class);
 	ERR_FAIL_NULL(type);
@@ -1457,6 +1564,7 @@ void ClassDB::add_property_array(const StringName &p_class, const StringName &p_
 // NOTE: For implementation simplicity reasons, this method doesn't allow setters to have optional arguments at the end.
 void ClassDB::add_property(const StringName &p_class, const PropertyInfo &p_pinfo, const StringName &p_setter, const StringName &p_getter, int p_index) {
 	Locker::Lock lock(Locker::STATE_WRITE);
+	_invalidate_lookup_tables();
 
 	ClassInfo *type = classes.getptr(p_class);
 
@@ -1605,100 +1713,126 @@ bool ClassDB::get_property_info(const StringName &p_class, const StringName &p_p
 bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
 	ERR_FAIL_NULL_V(p_object, false);
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (!psg->setter) {
-				if (r_valid) {
-					*r_valid = false;
-				}
-				return true; //return true but do nothing
+	// Copied out under the lock, tables and classes may be replaced while the setter runs.
+	PropertySetGet psg;
+	{
+		Locker::Lock lock(Locker::STATE_READ);
+
+		ClassInfo *type = classes.getptr(p_object->get_class_name());
+		const PropertySetGet *found = nullptr;
+		const LookupTable *table = _get_lookup_table(type);
+		if (table) {
+			const LookupEntry *entry = table->entries.getptr(p_property);
+			found = entry ? entry->setget : nullptr;
+		} else {
+			for (ClassInfo *check = type; check && !found; check = check->inherits_ptr) {
+				found = check->property_setget.getptr(p_property);
 			}
+		}
 
-			Callable::CallError ce;
+		if (!found) {
+			return false;
+		}
+		psg = *found;
+	}
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[2] = { &index, &p_value };
-				//p_object->call(psg->setter,arg,2,ce);
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 2, ce);
-				} else {
-					p_object->callp(psg->setter, arg, 2, ce);
-				}
+	if (!psg.setter) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		return true; //return true but do nothing
+	}
 
-			} else {
-				const Variant *arg[1] = { &p_value };
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 1, ce);
-				} else {
-					p_object->callp(psg->setter, arg, 1, ce);
-				}
-			}
+	Callable::CallError ce;
 
-			if (r_valid) {
-				*r_valid = ce.error == Callable::CallError::CALL_OK;
-			}
+	if (psg.index >= 0) {
+		Variant index = psg.index;
+		const Variant *arg[2] = { &index, &p_value };
+		//p_object->call(psg.setter,arg,2,ce);
+		if (psg._setptr) {
+			psg._setptr->call(p_object, arg, 2, ce);
+		} else {
+			p_object->callp(psg.setter, arg, 2, ce);
+		}
 
-			return true;
+	} else {
+		const Variant *arg[1] = { &p_value };
+		if (psg._setptr) {
+			psg._setptr->call(p_object, arg, 1, ce);
+		} else {
+			p_object->callp(psg.setter, arg, 1, ce);
 		}
+	}
 
-		check = check->inherits_ptr;
+	if (r_valid) {
+		*r_valid = ce.error == Callable::CallError::CALL_OK;
 	}
 
-	return false;
+	return true;
 }
 
 bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
 	ERR_FAIL_NULL_V(p_object, false);
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (!psg->getter) {
+	// Copied out under the lock, tables and classes may be replaced while the getter runs.
+	LookupEntry entry;
+	PropertySetGet psg;
+	{
+		Locker::Lock lock(Locker::STATE_READ);
+
+		ClassInfo *type = classes.getptr(p_object->get_class_name());
+		const LookupTable *table = _get_lookup_table(type);
+		if (table) {
+			const LookupEntry *found = table->entries.getptr(p_property);
+			if (found) {
+				entry = *found;
+			}
+		} else {
+			_resolve_lookup_entry(type, p_property, entry);
+		}
+		if (entry.member == LookupEntry::MEMBER_PROPERTY) {
+			psg = *entry.setget;
+		}
+	}
+
+	switch (entry.member) {
+		case LookupEntry::MEMBER_PROPERTY: {
+			if (!psg.getter) {
 				return true; //return true but do nothing
 			}
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
+			if (psg.index >= 0) {
+				Variant index = psg.index;
 				const Variant *arg[1] = { &index };
 				Callable::CallError ce;
-				const Variant value = p_object->callp(psg->getter, arg, 1, ce);
+				const Variant value = p_object->callp(psg.getter, arg, 1, ce);
 				r_value = (ce.error == Callable::CallError::CALL_OK) ? value : Variant();
 
 			} else {
 				Callable::CallError ce;
-				if (psg->_getptr) {
-					r_value = psg->_getptr->call(p_object, nullptr, 0, ce);
+				if (psg._getptr) {
+					r_value = psg._getptr->call(p_object, nullptr, 0, ce);
 				} else {
-					const Variant value = p_object->callp(psg->getter, nullptr, 0, ce);
+					const Variant value = p_object->callp(psg.getter, nullptr, 0, ce);
 					r_value = (ce.error == Callable::CallError::CALL_OK) ? value : Variant();
 				}
 			}
 			return true;
 		}
-
-		const int64_t *c = check->constant_map.getptr(p_property); //constants count
-		if (c) {
-			r_value = *c;
+		case LookupEntry::MEMBER_CONSTANT: { //constants count
+			r_value = entry.constant;
 			return true;
 		}
-
-		if (check->method_map.has(p_property)) { //methods count
+		case LookupEntry::MEMBER_METHOD: { //methods count
 			r_value = Callable(p_object, p_property);
 			return true;
 		}
-
-		if (check->signal_map.has(p_property)) { //signals count
+		case LookupEntry::MEMBER_SIGNAL: { //signals count
 			r_value = Signal(p_object, p_property);
 			return true;
 		}
-
-		check = check->inherits_ptr;
+		case LookupEntry::MEMBER_NONE: {
+		} break;
 	}
 
 	// The "free()" method is special, so we assume it exists and return a Callable.
@@ -1867,6 +2001,7 @@ void ClassDB::_bind_compatibility(ClassInfo *type, MethodBind *p_method) {
 
 void ClassDB::_bind_method_custom(const StringName &p_class, MethodBind *p_method, bool p_compatibility) {
 	Locker::Lock lock(Locker::STATE_WRITE);
+	_invalidate_lookup_tables();
 
 	StringName method_name = p_method->get_name();
 
@@ -1917,6 +2052,7 @@ MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p
 		// Overloading not supported
 		ERR_FAIL_V_MSG(nullptr, vformat("Method already bound: '%s::%s'.", instance_type, p_name));
 	}
+	_invalidate_lookup_tables();
 	type->method_map[p_name] = bind;
 #ifdef DEBUG_METHODS_ENABLED
 	// FIXME: <reduz> set_return_type is no longer in MethodBind, so I guess it should be moved to vararg method bind
@@ -1936,6 +2072,7 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, bool p_
 #endif
 
 	Locker::Lock lock(Locker::STATE_WRITE);
+	_invalidate_lookup_tables();
 	ERR_FAIL_NULL_V(p_bind, nullptr);
 	p_bind->set_name(mdname);
 
@@ -2306,6 +2443,8 @@ void ClassDB::register_extension_class(ObjectGDExtension *p_extension) {
 void ClassDB::unregister_extension_class(const StringName &p_class, bool p_free_method_binds) {
 	ClassInfo *c = classes.getptr(p_class);
 	ERR_FAIL_NULL_MSG(c, vformat("Class '%s' does not exist.", String(p_class)));
+	_invalidate_lookup_tables();
+	method_bind_epoch.fetch_add(1, std::memory_order_acq_rel);
 	if (p_free_method_binds) {
 		for (KeyValue<StringName, MethodBind *> &F : c->method_map) {
 			memdelete(F.value);
@@ -38,7 +38,10 @@
 // Needs to come after method_bind and object have been included.
 #include "core/object/callable_method_pointer.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/perfect_hash_map.h"
+#include "core/templates/swiss_hash_map.h"
 
+#include <atomic>
 #include <type_traits>
 
 #define DEFVAL(m_defval) (m_defval)
@@ -99,6 +102,47 @@ public:
 		Variant::Type type;
 	};
 
+	// What a name resolves to in a class, with inherited classes merged in.
+	struct LookupEntry {
+		enum Member : uint8_t {
+			MEMBER_NONE,
+			MEMBER_PROPERTY,
+			MEMBER_CONSTANT,
+			MEMBER_METHOD,
+			MEMBER_SIGNAL,
+		};
+
+		MethodBind *method = nullptr; // Closest non-null method, as found by get_method().
+		const PropertySetGet *setget = nullptr; // Closest property, as found by set_property().
+		Member member = MEMBER_NONE; // Closest class member of any kind, as found by get_property().
+		int64_t constant = 0;
+	};
+
+	struct LookupTable {
+		PerfectHashMap<StringName, LookupEntry> entries;
+		bool valid = false; // Names had colliding hashes, lookups walk the inheritance chain instead.
+	};
+
+	// Built on first use once registration is done, see set_current_api(). Copies start without one.
+	struct LookupTablePtr {
+		std::atomic<LookupTable *> table = nullptr;
+
+		void reset() {
+			LookupTable *old = table.exchange(nullptr);
+			if (old) {
+				memdelete(old);
+			}
+		}
+
+		LookupTablePtr() {}
+		LookupTablePtr(const LookupTablePtr &) {}
+		LookupTablePtr &operator=(const LookupTablePtr &) {
+			reset();
+			return *this;
+		}
+		~LookupTablePtr() { reset(); }
+	};
+
 	struct ClassInfo {
 		APIType api = API_NONE;
 		ClassInfo *inherits_ptr = nullptr;
@@ -106,9 +150,10 @@ public:
 
 		ObjectGDExtension *gdextension = nullptr;
 
-		HashMap<StringName, MethodBind *> method_map;
+		// Looked up often, in insertion order like HashMap so listing them doesn't change.
+		SwissHashMap<StringName, MethodBind *, HashMapHasherDefault, HashMapComparatorDefault<StringName>, true> method_map;
 		HashMap<StringName, LocalVector<MethodBind *>> method_map_compatibility;
-		HashMap<StringName, int64_t> constant_map;
+		SwissHashMap<StringName, int64_t, HashMapHasherDefault, HashMapComparatorDefault<StringName>, true> constant_map;
 		struct EnumInfo {
 			List<StringName> constants;
 			bool is_bitfield = false;
@@ -140,6 +185,8 @@ public:
 		// The bool argument indicates the need to postinitialize.
 		Object *(*creation_func)(bool) = nullptr;
 
+		LookupTablePtr lookup_table;
+
 		ClassInfo() {}
 		~ClassInfo() {}
 	};
@@ -215,6 +262,15 @@ private:
 	static StringName _get_parent_class(const StringName &p_class);
 	static bool _is_parent_class(const StringName &p_class, const StringName &p_inherits);
 	static void _bind_compatibility(ClassInfo *type, MethodBind *p_method);
+
+	static inline bool lookup_tables_enabled = false;
+	static inline uint32_t lookup_tables_count = 0;
+	static inline BinaryMutex lookup_tables_mutex;
+	static inline std::atomic<uint32_t> method_bind_epoch = 0;
+	static void _resolve_lookup_entry(const ClassInfo *p_class, const StringName &p_name, LookupEntry &r_entry);
+	static LookupTable *_build_lookup_table(const ClassInfo *p_class);
+	static const LookupTable *_get_lookup_table(ClassInfo *p_class);
+	static void _invalidate_lookup_tables();
 	static MethodBind *_bind_vararg_method(MethodBind *p_bind, const StringName &p_name, const Vector<Variant> &p_default_args, bool p_compatibility);
 	static void _bind_method_custom(const StringName &p_class, MethodBind *p_method, bool p_compatibility);
 
@@ -285,6 +341,9 @@ public:
 
 	static void register_extension_class(ObjectGDExtension *p_extension);
 	static void unregister_extension_class(const StringName &p_class, bool p_free_method_binds = true);
+	// Changes whenever extension classes are unregistered (and their method binds possibly freed),
+	// so MethodBind pointers cached along with it must be resolved again when it differs.
+	static uint32_t get_method_bind_epoch() { return method_bind_epoch.load(std::memory_order_acquire); }
 
 	template <typename T>
 	static Object *_create_ptr_func(bool p_notify_postinitialize) {
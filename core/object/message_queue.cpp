@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
 
 #include <stdio.h>
 
@@ -58,6 +59,30 @@
 		mutex.unlock();                           \
 	}
 
+SafeNumeric<uint64_t> CallQueue::last_id;
+
+// Releases the buffers of a thread when it exits. The queues free them once they have been drained.
+struct CallQueueThreadProducers {
+	struct Slot {
+		CallQueue *queue = nullptr;
+		uint64_t queue_id = 0;
+		CallQueue::ProducerBuffer *buffer = nullptr;
+	};
+
+	LocalVector<Slot> slots;
+
+	~CallQueueThreadProducers() {
+		for (const Slot &slot : slots) {
+			slot.buffer->thread_exited.set();
+			if (slot.buffer->refcount.unref()) {
+				memdelete(slot.buffer);
+			}
+		}
+	}
+};
+
+static thread_local CallQueueThreadProducers thread_producers;
+
 void CallQueue::_add_page() {
 	if (pages_used == page_bytes.size()) {
 		pages.push_back(allocator->alloc());
@@ -67,6 +92,265 @@ void CallQueue::_add_page() {
 	pages_used++;
 }
 
+uint8_t *CallQueue::_reserve(uint32_t p_room_needed) {
+	_ensure_first_page();
+
+	if ((page_bytes[pages_used - 1] + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used == max_pages) {
+			return nullptr;
+		}
+		_add_page();
+	}
+
+	uint8_t *buffer_end = &pages[pages_used - 1]->data[page_bytes[pages_used - 1]];
+	page_bytes[pages_used - 1] += p_room_needed;
+	return buffer_end;
+}
+
+bool CallQueue::_is_producer_thread() const {
+	// The thread owning a thread singleton override, and the main thread, write to the pages directly.
+	return this != MessageQueue::thread_singleton && !Thread::is_main_thread();
+}
+
+CallQueue::ProducerPage *CallQueue::_alloc_producer_page() {
+	static_assert(sizeof(ProducerPage) == sizeof(Page));
+	ProducerPage *page = memnew_placement(allocator->alloc(), ProducerPage);
+	page->committed.store(0, std::memory_order_relaxed);
+	page->next.store(nullptr, std::memory_order_relaxed);
+	producer_pages.increment();
+	return page;
+}
+
+CallQueue::ProducerBuffer *CallQueue::_get_producer_buffer() {
+	LocalVector<CallQueueThreadProducers::Slot> &slots = thread_producers.slots;
+	for (const CallQueueThreadProducers::Slot &slot : slots) {
+		if (slot.queue == this && slot.queue_id == id) {
+			return slot.buffer;
+		}
+	}
+
+	// First message from this thread, drop the buffers of deleted queues and register a new one.
+	for (uint32_t i = 0; i < slots.size(); i++) {
+		if (slots[i].buffer->queue_released.is_set()) {
+			if (slots[i].buffer->refcount.unref()) {
+				memdelete(slots[i].buffer);
+			}
+			slots.remove_at_unordered(i);
+			i--;
+		}
+	}
+
+	ProducerBuffer *buffer = memnew(ProducerBuffer);
+	buffer->refcount.init(2);
+	buffer->write_page = _alloc_producer_page();
+	buffer->read_page = buffer->write_page;
+	{
+		MutexLock lock(producers_mutex);
+		producers.push_back(buffer);
+	}
+
+	CallQueueThreadProducers::Slot slot;
+	slot.queue = this;
+	slot.queue_id = id;
+	slot.buffer = buffer;
+	slots.push_back(slot);
+	return buffer;
+}
+
+uint8_t *CallQueue::_producer_reserve(ProducerBuffer *p_buffer, uint32_t p_room_needed) {
+	if (p_buffer->write_offset + p_room_needed > uint32_t(PRODUCER_PAGE_BYTES)) {
+		if (producer_pages.get() >= max_pages) {
+			return nullptr;
+		}
+		ProducerPage *page = _alloc_producer_page();
+		// Everything written to the previous page is committed, the reader moves on once it sees this.
+		p_buffer->write_page->next.store(page, std::memory_order_release);
+		p_buffer->write_page = page;
+		p_buffer->write_offset = 0;
+	}
+	return &p_buffer->write_page->data[p_buffer->write_offset];
+}
+
+CallQueue::Message *CallQueue::_peek_producer(ProducerBuffer *p_buffer) {
+	ProducerPage *page = p_buffer->read_page;
+	while (true) {
+		const uint32_t committed = page->committed.load(std::memory_order_acquire);
+		if (p_buffer->read_offset < committed) {
+			return (Message *)&page->data[p_buffer->read_offset];
+		}
+
+		ProducerPage *next = page->next.load(std::memory_order_acquire);
+		if (!next) {
+			return nullptr;
+		}
+		if (page->committed.load(std::memory_order_acquire) != committed) {
+			continue; // Written to right before moving on to the next page.
+		}
+
+		allocator->free(reinterpret_cast<Page *>(page));
+		producer_pages.decrement();
+		page = next;
+		p_buffer->read_page = page;
+		p_buffer->read_offset = 0;
+	}
+}
+
+bool CallQueue::_pull_producers(bool p_discard) {
+	if (!producers_pending.load(std::memory_order_acquire)) {
+		return false;
+	}
+
+	MutexLock lock(producers_mutex);
+	// Cleared first, so anything committed from now on sets it again. Exchanging also makes
+	// everything committed before it was last set visible here.
+	producers_pending.exchange(false, std::memory_order_acq_rel);
+
+	bool pulled = false;
+	uint32_t from = 0;
+	while (true) {
+		// Merge the buffers by sequence, a thread usually posts several messages in a row.
+		ProducerBuffer *buffer = nullptr;
+		Message *message = nullptr;
+		bool any_committed = false;
+		for (uint32_t i = 0; i < producers.size(); i++) {
+			const uint32_t index = (from + i) % producers.size();
+			Message *head = _peek_producer(producers[index]);
+			if (!head) {
+				continue;
+			}
+			any_committed = true;
+			if (head->sequence == pulled_sequence) {
+				buffer = producers[index];
+				message = head;
+				from = index;
+				break;
+			}
+		}
+
+		if (!message) {
+			if (!any_committed) {
+				break;
+			}
+			// The next message was numbered but its thread has yet to commit it, which it does right away.
+			Thread::yield();
+			continue;
+		}
+
+		const uint32_t size = _get_message_size(message);
+		if (p_discard) {
+			_destroy_message(message);
+		} else {
+			uint8_t *to = _reserve(size);
+			if (!to) {
+				// Out of pages, keep the rest for the next flush.
+				producers_pending.store(true, std::memory_order_release);
+				return pulled;
+			}
+			_move_message(message, to, size);
+			pulled = true;
+		}
+		buffer->read_offset += size;
+		pulled_sequence++;
+	}
+
+	for (uint32_t i = 0; i < producers.size(); i++) {
+		ProducerBuffer *buffer = producers[i];
+		// Everything the thread posted is committed before it exits.
+		if (buffer->thread_exited.is_set() && !_peek_producer(buffer)) {
+			_release_producer(buffer);
+			producers.remove_at_unordered(i);
+			i--;
+		}
+	}
+	return pulled;
+}
+
+void CallQueue::_release_producer(ProducerBuffer *p_buffer) {
+	ProducerPage *page = p_buffer->read_page;
+	while (page) {
+		ProducerPage *next = page->next.load(std::memory_order_acquire);
+		allocator->free(reinterpret_cast<Page *>(page));
+		producer_pages.decrement();
+		page = next;
+	}
+	p_buffer->read_page = nullptr;
+	p_buffer->queue_released.set();
+	if (p_buffer->refcount.unref()) {
+		memdelete(p_buffer);
+	}
+}
+
+uint8_t *CallQueue::_push_begin(uint32_t p_room_needed, ProducerBuffer *&r_buffer) {
+	if (_is_producer_thread() && p_room_needed <= uint32_t(PRODUCER_PAGE_BYTES)) {
+		r_buffer = _get_producer_buffer();
+		return _producer_reserve(r_buffer, p_room_needed);
+	}
+
+	r_buffer = nullptr;
+	LOCK_MUTEX;
+	// Messages from other threads go first, they may have been posted before this one.
+	_pull_producers();
+	return _reserve(p_room_needed);
+}
+
+void CallQueue::_push_end(ProducerBuffer *p_buffer, uint32_t p_room_needed) {
+	if (p_buffer) {
+		((Message *)&p_buffer->write_page->data[p_buffer->write_offset])->sequence = producer_sequence.postincrement();
+		p_buffer->write_offset += p_room_needed;
+		p_buffer->write_page->committed.store(p_buffer->write_offset, std::memory_order_release);
+		producers_pending.store(true, std::memory_order_release);
+	} else {
+		UNLOCK_MUTEX;
+	}
+}
+
+uint32_t CallQueue::_get_message_size(const Message *p_message) {
+	switch (p_message->type & FLAG_MASK) {
+		case TYPE_NOTIFICATION:
+			return sizeof(Message);
+		case TYPE_NATIVE_CALL:
+			return sizeof(Message) + p_message->args;
+		default:
+			return sizeof(Message) + sizeof(Variant) * p_message->args;
+	}
+}
+
+void CallQueue::_move_message(Message *p_message, uint8_t *p_to, uint32_t p_size) {
+	Message *msg = memnew_placement(p_to, Message);
+	msg->callable = p_message->callable;
+	msg->type = p_message->type;
+	msg->args = p_message->args; // Also copies the notification.
+
+	switch (p_message->type & FLAG_MASK) {
+		case TYPE_NOTIFICATION: {
+		} break;
+		case TYPE_NATIVE_CALL: {
+			memcpy((uint8_t *)(msg + 1), (const uint8_t *)(p_message + 1), p_size - sizeof(Message));
+		} break;
+		default: {
+			Variant *from = (Variant *)(p_message + 1);
+			uint8_t *to = (uint8_t *)(msg + 1);
+			for (int k = 0; k < p_message->args; k++) {
+				memnew_placement(to + sizeof(Variant) * k, Variant(std::move(from[k])));
+			}
+		} break;
+	}
+
+	_destroy_message(p_message);
+}
+
+void CallQueue::_destroy_message(Message *p_message) {
+	const int type = p_message->type & FLAG_MASK;
+	if (type != TYPE_NOTIFICATION && type != TYPE_NATIVE_CALL) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
+	}
+
+	p_message->~Message();
+}
+
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
 	return push_callablep(Callable(p_id, p_method), p_args, p_argcount, p_show_error);
 }
@@ -88,24 +372,18 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
+	ProducerBuffer *producer = nullptr;
+	uint8_t *buffer_end = _push_begin(room_needed, producer);
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+	if (!buffer_end) {
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		if (!producer) {
 			statistics();
 			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
 		}
-		_add_page();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
@@ -126,37 +404,30 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	_push_end(producer, room_needed);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
+	ProducerBuffer *producer = nullptr;
+	uint8_t *buffer_end = _push_begin(room_needed, producer);
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+	if (!buffer_end) {
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
+		}
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		if (!producer) {
 			statistics();
-
 			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
 		}
-		_add_page();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
@@ -167,32 +438,27 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_push_end(producer, room_needed);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
+	ProducerBuffer *producer = nullptr;
+	uint8_t *buffer_end = _push_begin(room_needed, producer);
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+	if (!buffer_end) {
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		if (!producer) {
 			statistics();
 			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
 		}
-		_add_page();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 
 	msg->type = TYPE_NOTIFICATION;
@@ -200,8 +466,36 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_push_end(producer, room_needed);
+
+	return OK;
+}
+
+Error CallQueue::_push_native(const NativeCallHeader *p_call, uint32_t p_size) {
+	const uint32_t payload_size = (p_size + 7) & ~7u;
+	uint32_t room_needed = sizeof(Message) + payload_size;
+
+	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PRODUCER_PAGE_BYTES), ERR_INVALID_PARAMETER, "Native call is too large to fit on a page (" + itos(PRODUCER_PAGE_BYTES) + " bytes), consider passing less arguments.");
+
+	ProducerBuffer *producer = nullptr;
+	uint8_t *buffer_end = _push_begin(room_needed, producer);
+
+	if (!buffer_end) {
+		fprintf(stderr, "Failed native call target ID: %s. Message queue out of memory. %s\n", itos(p_call->id).utf8().get_data(), error_text.utf8().get_data());
+		if (!producer) {
+			statistics();
+			UNLOCK_MUTEX;
+		}
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	Message *msg = memnew_placement(buffer_end, Message);
+	msg->args = payload_size;
+	msg->type = TYPE_NATIVE_CALL;
+
+	memcpy((uint8_t *)(msg + 1), (const uint8_t *)p_call, p_size);
+
+	_push_end(producer, room_needed);
 
 	return OK;
 }
@@ -226,7 +520,7 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 Error CallQueue::flush() {
 	LOCK_MUTEX;
 
-	if (pages.is_empty()) {
+	if (pages.is_empty() && !producers_pending.load(std::memory_order_acquire)) {
 		// Never allocated
 		UNLOCK_MUTEX;
 		return OK; // Do nothing.
@@ -239,23 +533,34 @@ Error CallQueue::flush() {
 
 	flushing = true;
 
+	_ensure_first_page();
+	_pull_producers();
+
 	uint32_t i = 0;
 	uint32_t offset = 0;
 
-	while (i < pages_used && offset < page_bytes[i]) {
+	while (true) {
+		if (i >= pages_used || offset >= page_bytes[i]) {
+			if (i + 1 < pages_used) {
+				i++;
+				offset = 0;
+				continue;
+			}
+			// Reached the end, take in what other threads posted meanwhile.
+			if (i < pages_used && offset == page_bytes[i] && _pull_producers()) {
+				continue;
+			}
+			break;
+		}
+
 		Page *page = pages[i];
 
 		//lock on each iteration, so a call can re-add itself to the message queue
 
 		Message *message = (Message *)&page->data[offset];
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
-
 		//pre-advance so this function is reentrant
-		offset += advance;
+		offset += _get_message_size(message);
 
 		Object *target = message->callable.get_object();
 
@@ -279,22 +584,18 @@ Error CallQueue::flush() {
 					target->set(message->callable.get_method(), *arg);
 				}
 			} break;
+			case TYPE_NATIVE_CALL: {
+				const NativeCallHeader *call = (const NativeCallHeader *)(message + 1);
+				Object *object = ObjectDB::get_instance(call->id);
+				if (object) {
+					call->invoke(object, call);
+				}
+			} break;
 		}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
-			}
-		}
-
-		message->~Message();
+		_destroy_message(message);
 
 		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
-		}
 	}
 
 	page_bytes[0] = 0;
@@ -308,6 +609,8 @@ Error CallQueue::flush() {
 void CallQueue::clear() {
 	LOCK_MUTEX;
 
+	_pull_producers(true);
+
 	if (pages.is_empty()) {
 		UNLOCK_MUTEX;
 		return; // Nothing to clear.
@@ -322,21 +625,9 @@ void CallQueue::clear() {
 
 			Message *message = (Message *)&page->data[offset];
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
+			offset += _get_message_size(message);
 
-			message->~Message();
+			_destroy_message(message);
 		}
 	}
 
@@ -351,6 +642,7 @@ void CallQueue::statistics() {
 	HashMap<StringName, int> set_count;
 	HashMap<int, int> notify_count;
 	HashMap<Callable, int> call_count;
+	int native_count = 0;
 	int null_count = 0;
 
 	for (uint32_t i = 0; i < pages_used; i++) {
@@ -362,10 +654,7 @@ void CallQueue::statistics() {
 
 			Message *message = (Message *)&page->data[offset];
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+			uint32_t advance = _get_message_size(message);
 
 			Object *target = message->callable.get_object();
 
@@ -402,6 +691,12 @@ void CallQueue::statistics() {
 						null_target = false;
 					}
 				} break;
+				case TYPE_NATIVE_CALL: {
+					if (ObjectDB::get_instance(((const NativeCallHeader *)(message + 1))->id)) {
+						native_count++;
+						null_target = false;
+					}
+				} break;
 			}
 			if (null_target) {
 				// Object was deleted.
@@ -412,19 +707,14 @@ void CallQueue::statistics() {
 
 			offset += advance;
 
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
-
-			message->~Message();
+			_destroy_message(message);
 		}
 	}
 
 	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	fprintf(stdout, "THREAD PAGES: %d (%d bytes).\n", producer_pages.get(), producer_pages.get() * PAGE_SIZE_BYTES);
 	fprintf(stdout, "NULL count: %d.\n", null_count);
+	fprintf(stdout, "NATIVE CALL count: %d.\n", native_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
 		fprintf(stdout, "SET %s: %d.\n", String(E.key).utf8().get_data(), E.value);
@@ -446,6 +736,9 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
+	if (producers_pending.load(std::memory_order_acquire)) {
+		return true;
+	}
 	if (pages_used == 0) {
 		return false;
 	}
@@ -457,7 +750,7 @@ bool CallQueue::has_messages() const {
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	return (pages.size() + producer_pages.get()) * PAGE_SIZE_BYTES;
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -470,10 +763,19 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 	}
 	max_pages = p_max_pages;
 	error_text = p_error_text;
+	id = last_id.increment();
 }
 
 CallQueue::~CallQueue() {
 	clear();
+	{
+		// Threads still holding a buffer free it when they exit.
+		MutexLock lock(producers_mutex);
+		for (ProducerBuffer *buffer : producers) {
+			_release_producer(buffer);
+		}
+		producers.clear();
+	}
 	// Let go of pages.
 	for (uint32_t i = 0; i < pages.size(); i++) {
 		allocator->free(pages[i]);
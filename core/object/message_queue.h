@@ -34,12 +34,16 @@
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
+#include <type_traits>
+
 class Object;
 
 class CallQueue {
 	friend class MessageQueue;
+	friend struct CallQueueThreadProducers;
 
 public:
 	enum {
@@ -59,6 +63,7 @@ private:
 		TYPE_CALL,
 		TYPE_NOTIFICATION,
 		TYPE_SET,
+		TYPE_NATIVE_CALL,
 		TYPE_END, // End marker.
 		FLAG_NULL_IS_OK = 1 << 13,
 		FLAG_SHOW_ERROR = 1 << 14,
@@ -87,8 +92,97 @@ private:
 			int16_t notification;
 			int16_t args;
 		};
+		uint32_t sequence; // Set for messages posted to a producer buffer.
+	};
+
+	// Typed calls, stored right after the message. Arguments are kept as they are, without Variant conversion.
+	struct NativeCallHeader {
+		ObjectID id;
+		void (*invoke)(Object *p_object, const NativeCallHeader *p_call) = nullptr;
+	};
+
+	template <typename... P>
+	struct NativeArgs {};
+
+	template <typename P0, typename... P>
+	struct NativeArgs<P0, P...> {
+		P0 arg;
+		NativeArgs<P...> next;
+	};
+
+	template <size_t I, typename P0, typename... P>
+	static _FORCE_INLINE_ const auto &_get_native_arg(const NativeArgs<P0, P...> &p_args) {
+		if constexpr (I == 0) {
+			return p_args.arg;
+		} else {
+			return _get_native_arg<I - 1>(p_args.next);
+		}
+	}
+
+	static _FORCE_INLINE_ void _set_native_args(NativeArgs<> &r_args) {}
+
+	template <typename P0, typename... P, typename A0, typename... A>
+	static _FORCE_INLINE_ void _set_native_args(NativeArgs<P0, P...> &r_args, A0 p_arg, A... p_rest) {
+		r_args.arg = p_arg;
+		_set_native_args(r_args.next, p_rest...);
+	}
+
+	template <typename T, typename... P>
+	struct NativeCall {
+		NativeCallHeader header;
+		void (T::*method)(P...) = nullptr;
+		NativeArgs<std::decay_t<P>...> args;
+
+		template <size_t... Is>
+		_FORCE_INLINE_ void call(T *p_instance, IndexSequence<Is...>) const {
+			(p_instance->*method)(_get_native_arg<Is>(args)...);
+		}
+
+		static void invoke(Object *p_object, const NativeCallHeader *p_call) {
+			T *instance = T::template cast_to<T>(p_object);
+			if (instance) {
+				reinterpret_cast<const NativeCall *>(p_call)->call(instance, BuildIndexSequence<sizeof...(P)>{});
+			}
+		}
 	};
 
+	// Messages posted from threads other than the one flushing go to a buffer owned by each thread,
+	// so they never wait on the mutex. A buffer is a chain of pages only written by its thread, and
+	// only read while holding producers_mutex, when moving the messages to the pages of the queue.
+	// Messages are numbered as they are committed and moved in that order, so a message posted
+	// after another one was committed on a different thread also runs after it.
+	enum {
+		PRODUCER_PAGE_BYTES = PAGE_SIZE_BYTES - 16,
+	};
+
+	struct ProducerPage {
+		std::atomic<uint32_t> committed;
+		std::atomic<ProducerPage *> next;
+		uint8_t data[PRODUCER_PAGE_BYTES];
+	};
+
+	struct ProducerBuffer {
+		SafeRefCount refcount; // Held by the queue and by the thread.
+		SafeFlag thread_exited;
+		SafeFlag queue_released;
+		// Only used by the thread.
+		ProducerPage *write_page = nullptr;
+		uint32_t write_offset = 0;
+		// Only used with producers_mutex locked.
+		ProducerPage *read_page = nullptr;
+		uint32_t read_offset = 0;
+	};
+
+	static SafeNumeric<uint64_t> last_id;
+	uint64_t id = 0; // Tells apart queues reusing the address of a deleted one.
+
+	BinaryMutex producers_mutex;
+	LocalVector<ProducerBuffer *> producers;
+	std::atomic<bool> producers_pending = false;
+	SafeNumeric<uint32_t> producer_pages;
+	SafeNumeric<uint32_t> producer_sequence;
+	uint32_t pulled_sequence = 0; // Only used with producers_mutex locked.
+
 	_FORCE_INLINE_ void _ensure_first_page() {
 		if (unlikely(pages.is_empty())) {
 			pages.push_back(allocator->alloc());
@@ -98,6 +192,23 @@ private:
 	}
 
 	void _add_page();
+	uint8_t *_reserve(uint32_t p_room_needed);
+
+	bool _is_producer_thread() const;
+	ProducerBuffer *_get_producer_buffer();
+	ProducerPage *_alloc_producer_page();
+	uint8_t *_producer_reserve(ProducerBuffer *p_buffer, uint32_t p_room_needed);
+	Message *_peek_producer(ProducerBuffer *p_buffer);
+	bool _pull_producers(bool p_discard = false);
+	void _release_producer(ProducerBuffer *p_buffer);
+
+	uint8_t *_push_begin(uint32_t p_room_needed, ProducerBuffer *&r_buffer);
+	void _push_end(ProducerBuffer *p_buffer, uint32_t p_room_needed);
+	Error _push_native(const NativeCallHeader *p_call, uint32_t p_size);
+
+	static uint32_t _get_message_size(const Message *p_message);
+	static void _move_message(Message *p_message, uint8_t *p_to, uint32_t p_size);
+	static void _destroy_message(Message *p_message);
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -143,6 +254,28 @@ public:
 	Error push_notification(Object *p_object, int p_notification);
 	Error push_set(Object *p_object, const StringName &p_prop, const Variant &p_value);
 
+	// Defers a call to a native method, skipping the Variant conversion of the arguments and the method lookup.
+	// Arguments must be trivially copyable.
+	template <typename T, typename... P, typename... VarArgs>
+	Error push_call_native(ObjectID p_id, void (T::*p_method)(P...), VarArgs... p_args) {
+		static_assert(sizeof...(P) == sizeof...(VarArgs), "Wrong argument count for the native method.");
+		static_assert((std::is_trivially_copyable_v<std::decay_t<P>> && ...), "Native deferred calls only take trivially copyable arguments, use push_callable() otherwise.");
+		typedef NativeCall<T, P...> Call;
+		static_assert(alignof(Call) <= alignof(uint64_t));
+
+		Call call;
+		call.header.id = p_id;
+		call.header.invoke = &Call::invoke;
+		call.method = p_method;
+		_set_native_args(call.args, p_args...);
+		return _push_native(&call.header, sizeof(Call));
+	}
+
+	template <typename U, typename T, typename... P, typename... VarArgs>
+	Error push_call_native(U *p_object, void (T::*p_method)(P...), VarArgs... p_args) {
+		return push_call_native(p_object->get_instance_id(), p_method, p_args...);
+	}
+
 	Error flush();
 	void clear();
 	void statistics();
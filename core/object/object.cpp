@@ -42,21 +42,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	ObjectID obj_id;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj_id = p_obj->get_instance_id();
-		p_obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		Object *obj_ptr = ObjectDB::get_instance(obj_id);
-		if (likely(obj_ptr)) {
-			obj_ptr->_lock_index.unref();
-		}
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -1205,14 +1190,76 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+Object::SignalData &Object::SignalData::operator=(const SignalData &p_other) {
+	if (this != &p_other) {
+		user = p_other.user;
+		slot_map = p_other.slot_map;
+		removable = p_other.removable;
+		invalidate_dispatch();
+	}
+	return *this;
+}
+
+void Object::SignalData::invalidate_dispatch() {
+	if (dispatch) {
+		_release_signal_dispatch(dispatch);
+		dispatch = nullptr;
+	}
+}
+
+Object::SignalData::Dispatch *Object::_build_signal_dispatch(const SignalData &p_signal) {
+	SignalData::Dispatch *dispatch = memnew(SignalData::Dispatch);
+	dispatch->refcount.init();
+	dispatch->targets.resize(p_signal.slot_map.size());
+	dispatch->method_bind_epoch = ClassDB::get_method_bind_epoch();
+
+	uint32_t i = 0;
+	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : p_signal.slot_map) {
+		SignalData::Dispatch::Target &target = dispatch->targets[i++];
+		target.callable = slot_kv.value.conn.callable;
+		target.flags = slot_kv.value.conn.flags;
+		dispatch->has_one_shot |= bool(target.flags & CONNECT_ONE_SHOT);
+
+		// Resolve the native method now, so emitting doesn't look it up by name every time.
+		if (target.callable.is_standard() && target.callable.get_method() != CoreStringName(free_)) {
+			Object *target_object = target.callable.get_object();
+			if (target_object) {
+				target.method = ClassDB::get_method(target_object->get_class_name(), target.callable.get_method());
+			}
+		}
+	}
+
+	return dispatch;
+}
+
+void Object::_release_signal_dispatch(SignalData::Dispatch *p_dispatch) {
+	if (p_dispatch->refcount.unref()) {
+		memdelete(p_dispatch);
+	}
+}
+
+// Whether the arguments can be passed to the method as they are, skipping conversions and checks.
+static _FORCE_INLINE_ bool _can_validated_call(const MethodBind *p_method, const Variant **p_args, int p_argcount) {
+	// The return value is discarded, but validated calls need it initialized to the right type.
+	if (p_method->has_return() || p_method->is_vararg() || p_method->get_argument_count() != p_argcount) {
+		return false;
+	}
+	for (int i = 0; i < p_argcount; i++) {
+		const Variant::Type type = p_method->get_argument_type(i);
+		// Object arguments would need a class check.
+		if (type == Variant::OBJECT || (type != Variant::NIL && p_args[i]->get_type() != type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	Callable *slot_callables = nullptr;
-	uint32_t *slot_flags = nullptr;
-	uint32_t slot_count = 0;
+	SignalData::Dispatch *dispatch = nullptr;
 
 	{
 		OBJ_SIGNAL_LOCK
@@ -1233,29 +1280,30 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		Ref<RefCounted> rc = Ref<RefCounted>(Object::cast_to<RefCounted>(this));
 
 		// Ensure that disconnecting the signal or even deleting the object
-		// will not affect the signal calling.
-		slot_callables = (Callable *)alloca(sizeof(Callable) * s->slot_map.size());
-		slot_flags = (uint32_t *)alloca(sizeof(uint32_t) * s->slot_map.size());
-
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
+		// will not affect the signal calling, by holding a reference to the dispatch list.
+		if (s->dispatch && s->dispatch->method_bind_epoch != ClassDB::get_method_bind_epoch()) {
+			// Extension classes were unloaded since it was built, its method binds may have been freed.
+			s->invalidate_dispatch();
 		}
+		if (!s->dispatch) {
+			s->dispatch = _build_signal_dispatch(*s);
+		}
+		dispatch = s->dispatch;
+		dispatch->refcount.ref();
 
-		DEV_ASSERT(slot_count == s->slot_map.size());
-
-		// Disconnect all one-shot connections before emitting to prevent recursion.
-		for (uint32_t i = 0; i < slot_count; ++i) {
-			bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+		if (dispatch->has_one_shot) {
+			// Disconnect all one-shot connections before emitting to prevent recursion.
+			for (const SignalData::Dispatch::Target &target : dispatch->targets) {
+				bool disconnect = target.flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-			if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
-				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
-				disconnect = false;
-			}
+				if (disconnect && (target.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+					// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
+					disconnect = false;
+				}
 #endif
-			if (disconnect) {
-				_disconnect(p_name, slot_callables[i]);
+				if (disconnect) {
+					_disconnect(p_name, target.callable);
+				}
 			}
 		}
 	}
@@ -1264,25 +1312,49 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	Error err = OK;
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+	for (const SignalData::Dispatch::Target &target : dispatch->targets) {
+		const Callable &callable = target.callable;
+		const uint32_t &flags = target.flags;
 
-		if (!callable.is_valid()) {
+		const Variant **args = p_args;
+		int argc = p_argcount;
+
+		Object *target_object = nullptr;
+		if (target.method) {
+			target_object = ObjectDB::get_instance(callable.get_object_id());
+			if (!target_object) {
+				// Target might have been deleted during signal callback, this is expected and OK.
+				continue;
+			}
+			if (target_object->get_script_instance()) {
+				// Scripts can override native methods, go through the regular call.
+				target_object = nullptr;
+			}
+		}
+
+		if (!target_object && !callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
 			continue;
 		}
 
-		const Variant **args = p_args;
-		int argc = p_argcount;
-
 		if (flags & CONNECT_DEFERRED) {
 			MessageQueue::get_singleton()->push_callablep(callable, args, argc, true);
 		} else {
 			Callable::CallError ce;
 			_emitting = true;
-			Variant ret;
-			callable.callp(args, argc, ret, ce);
+			if (target_object) {
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock target_lock(target_object);
+#endif
+				if (_can_validated_call(target.method, args, argc)) {
+					target.method->validated_call(target_object, args, nullptr);
+				} else {
+					target.method->call(target_object, args, argc, ce);
+				}
+			} else {
+				Variant ret;
+				callable.callp(args, argc, ret, ce);
+			}
 			_emitting = false;
 
 			if (ce.error != Callable::CallError::CALL_OK) {
@@ -1291,8 +1363,8 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 					continue;
 				}
 #endif
-				Object *target = callable.get_object();
-				if (ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD && target && !ClassDB::class_exists(target->get_class_name())) {
+				Object *error_target = callable.get_object();
+				if (ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD && error_target && !ClassDB::class_exists(error_target->get_class_name())) {
 					//most likely object is not initialized yet, do not throw error.
 				} else {
 					ERR_PRINT(vformat("Error calling from signal '%s' to callable: %s.", String(p_name), Variant::get_callable_error_text(callable, args, argc, ce)));
@@ -1302,9 +1374,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
+	_release_signal_dispatch(dispatch);
 
 	return err;
 }
@@ -1531,6 +1601,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->invalidate_dispatch();
 
 	return OK;
 }
@@ -1611,6 +1682,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->invalidate_dispatch();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
@@ -39,6 +39,7 @@
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/callable_bind.h"
@@ -604,9 +605,33 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		// Flat copy of the connections used to emit, shared by all emissions in progress.
+		// It's rebuilt after connections change, so emitting doesn't need to copy them every time.
+		struct Dispatch {
+			struct Target {
+				Callable callable;
+				MethodBind *method = nullptr; // Native method of the target, called directly when it has no script.
+				uint32_t flags = 0;
+			};
+
+			SafeRefCount refcount;
+			LocalVector<Target> targets;
+			uint32_t method_bind_epoch = 0; // ClassDB epoch the methods were resolved in.
+			bool has_one_shot = false;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		Dispatch *dispatch = nullptr;
 		bool removable = false;
+
+		void invalidate_dispatch();
+
+		SignalData() {}
+		SignalData(const SignalData &p_other) :
+				user(p_other.user), slot_map(p_other.slot_map), removable(p_other.removable) {}
+		SignalData &operator=(const SignalData &p_other);
+		~SignalData() { invalidate_dispatch(); }
 	};
 	friend struct _ObjectSignalLock;
 	mutable Mutex *signal_mutex = nullptr;
@@ -756,6 +781,8 @@ protected:
 	static void _get_property_list_from_classdb(const StringName &p_class, List<PropertyInfo> *p_list, bool p_no_inheritance, const Object *p_validator);
 
 	bool _disconnect(const StringName &p_signal, const Callable &p_callable, bool p_force = false);
+	static SignalData::Dispatch *_build_signal_dispatch(const SignalData &p_signal);
+	static void _release_signal_dispatch(SignalData::Dispatch *p_dispatch);
 
 	virtual bool _uses_signal_mutex() const;
 
@@ -904,6 +931,8 @@ public:
 #ifdef TOOLS_ENABLED
 	void set_edited(bool p_edited);
 	bool is_edited() const;
+	// Marks the object as edited like `set()` does, without bumping the edited version.
+	_FORCE_INLINE_ void mark_edited() { _edited = true; }
 	// This function is used to check when something changed beyond a point, it's used mainly for generating previews.
 	uint32_t get_edited_version() const;
 #endif
@@ -990,6 +1019,7 @@ public:
 	void clear_internal_resource_paths();
 
 	_ALWAYS_INLINE_ bool is_ref_counted() const { return type_is_reference; }
+	_ALWAYS_INLINE_ bool is_extension_instance() const { return _extension != nullptr; } // Its class, or a base of it, comes from a GDExtension.
 
 	void cancel_free();
 
@@ -1067,3 +1097,22 @@ public:
 	static void debug_objects(DebugFunc p_func);
 	static int get_object_count();
 };
+
+#ifdef DEBUG_ENABLED
+// Keeps the object from freeing itself while it's being called, see Object::callp().
+// Meant for code that calls into an object without going through Object::callp().
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj_id = p_obj->get_instance_id();
+		p_obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		Object *obj_ptr = ObjectDB::get_instance(obj_id);
+		if (likely(obj_ptr)) {
+			obj_ptr->_lock_index.unref();
+		}
+	}
+};
+#endif
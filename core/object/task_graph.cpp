@@ -0,0 +1,319 @@
+/**************************************************************************/
+/*  task_graph.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "task_graph.h"
+
+#include "core/templates/sort_array.h"
+
+TaskGraph::NodeID TaskGraph::_add_node(void (*p_func)(void *), void (*p_group_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_is_group, int p_elements, const String &p_description) {
+	if (unlikely(running || p_elements < 0)) {
+		if (p_template_userdata) {
+			memdelete(p_template_userdata);
+		}
+		ERR_FAIL_COND_V_MSG(running, INVALID_NODE_ID, "Can't add nodes to a running TaskGraph.");
+		ERR_FAIL_V_MSG(INVALID_NODE_ID, "Element count of a group node can't be negative.");
+	}
+
+	Node *node = memnew(Node);
+	node->graph = this;
+	node->self = nodes.size();
+	node->native_func = p_func;
+	node->native_group_func = p_group_func;
+	node->native_func_userdata = p_userdata;
+	node->template_userdata = p_template_userdata;
+	node->is_group = p_is_group;
+	node->elements = p_elements;
+	node->description = p_description;
+	nodes.push_back(node);
+
+	critical_path_dirty = true;
+	return node->self;
+}
+
+TaskGraph::NodeID TaskGraph::add_native_node(void (*p_func)(void *), void *p_userdata, const String &p_description) {
+	return _add_node(p_func, nullptr, p_userdata, nullptr, false, 0, p_description);
+}
+
+TaskGraph::NodeID TaskGraph::add_native_group_node(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const String &p_description) {
+	return _add_node(nullptr, p_func, p_userdata, nullptr, true, p_elements, p_description);
+}
+
+void TaskGraph::set_group_node_elements(NodeID p_node, int p_elements) {
+	ERR_FAIL_INDEX(p_node, (NodeID)nodes.size());
+	ERR_FAIL_COND_MSG(running, "Can't change nodes of a running TaskGraph.");
+	ERR_FAIL_COND_MSG(!nodes[p_node]->is_group, "Only group nodes have elements.");
+	ERR_FAIL_COND(p_elements < 0);
+	nodes[p_node]->elements = p_elements;
+}
+
+void TaskGraph::add_dependency(NodeID p_node, NodeID p_depends_on) {
+	ERR_FAIL_INDEX(p_node, (NodeID)nodes.size());
+	ERR_FAIL_INDEX(p_depends_on, (NodeID)nodes.size());
+	ERR_FAIL_COND_MSG(p_node == p_depends_on, "A node can't depend on itself.");
+	ERR_FAIL_COND_MSG(running, "Can't change dependencies of a running TaskGraph.");
+
+	Node *from = nodes[p_depends_on];
+	if (from->dependents.has(p_node)) {
+		return;
+	}
+	from->dependents.push_back(p_node);
+	nodes[p_node]->dependency_count++;
+	critical_path_dirty = true;
+}
+
+void TaskGraph::set_node_cost(NodeID p_node, float p_cost) {
+	ERR_FAIL_INDEX(p_node, (NodeID)nodes.size());
+	ERR_FAIL_COND_MSG(running, "Can't change nodes of a running TaskGraph.");
+	ERR_FAIL_COND(p_cost < 0.0);
+	nodes[p_node]->cost = p_cost;
+	critical_path_dirty = true;
+}
+
+float TaskGraph::get_node_cost(NodeID p_node) const {
+	ERR_FAIL_INDEX_V(p_node, (NodeID)nodes.size(), 0.0);
+	return nodes[p_node]->cost;
+}
+
+bool TaskGraph::_update_critical_path() {
+	uint32_t node_count = nodes.size();
+
+	// Topological order (Kahn), also catches cycles.
+	LocalVector<uint32_t> remaining;
+	LocalVector<NodeID> order;
+	remaining.resize(node_count);
+	order.reserve(node_count);
+	for (uint32_t i = 0; i < node_count; i++) {
+		remaining[i] = nodes[i]->dependency_count;
+		if (remaining[i] == 0) {
+			order.push_back(i);
+		}
+	}
+	for (uint32_t i = 0; i < order.size(); i++) {
+		for (NodeID dependent : nodes[order[i]]->dependents) {
+			if (--remaining[dependent] == 0) {
+				order.push_back(dependent);
+			}
+		}
+	}
+	ERR_FAIL_COND_V_MSG(order.size() != node_count, false, "TaskGraph dependencies contain a cycle.");
+
+	// Walk backwards so the cost of every dependent is known before the nodes it depends on.
+	for (int64_t i = int64_t(node_count) - 1; i >= 0; i--) {
+		Node *node = nodes[order[i]];
+		node->critical_cost = node->cost;
+		node->critical_next = INVALID_NODE_ID;
+		node->critical = false;
+		for (NodeID dependent : node->dependents) {
+			float cost = node->cost + nodes[dependent]->critical_cost;
+			if (cost > node->critical_cost || node->critical_next == INVALID_NODE_ID) {
+				node->critical_cost = cost;
+				node->critical_next = dependent;
+			}
+		}
+	}
+
+	critical_path_start = INVALID_NODE_ID;
+	for (uint32_t i = 0; i < node_count; i++) {
+		if (nodes[i]->dependency_count == 0 && (critical_path_start == INVALID_NODE_ID || nodes[i]->critical_cost > nodes[critical_path_start]->critical_cost)) {
+			critical_path_start = i;
+		}
+	}
+	for (NodeID id = critical_path_start; id != INVALID_NODE_ID; id = nodes[id]->critical_next) {
+		nodes[id]->critical = true;
+	}
+
+	critical_path_dirty = false;
+	return true;
+}
+
+LocalVector<TaskGraph::NodeID> TaskGraph::get_critical_path() {
+	LocalVector<NodeID> path;
+	if (critical_path_dirty && !_update_critical_path()) {
+		return path;
+	}
+	for (NodeID id = critical_path_start; id != INVALID_NODE_ID; id = nodes[id]->critical_next) {
+		path.push_back(id);
+	}
+	return path;
+}
+
+float TaskGraph::get_critical_path_cost() {
+	if (critical_path_dirty && !_update_critical_path()) {
+		return 0.0;
+	}
+	return critical_path_start != INVALID_NODE_ID ? nodes[critical_path_start]->critical_cost : 0.0;
+}
+
+void TaskGraph::_process_node(void *p_node) {
+	Node *node = (Node *)p_node;
+	if (node->native_func) {
+		node->native_func(node->native_func_userdata);
+	} else {
+		node->template_userdata->callback();
+	}
+	node->graph->_node_finished(node);
+}
+
+void TaskGraph::_process_group_element(void *p_node, uint32_t p_index) {
+	Node *node = (Node *)p_node;
+	if (node->native_group_func) {
+		node->native_group_func(node->native_func_userdata, p_index);
+	} else {
+		node->template_userdata->callback_indexed(p_index);
+	}
+}
+
+void TaskGraph::_group_finished(void *p_node) {
+	Node *node = (Node *)p_node;
+	node->graph->_node_finished(node);
+}
+
+void TaskGraph::_post_nodes(Node **p_nodes, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		Node *node = p_nodes[i];
+		bool node_high_priority = high_priority || node->critical;
+
+		if (!node->is_group) {
+			WorkerThreadPool::TaskID id = pool->add_native_task(&TaskGraph::_process_node, node, node_high_priority, node->description);
+			MutexLock lock(posted_mutex);
+			posted_tasks.push_back(id);
+		} else if (node->elements > 0) {
+			WorkerThreadPool::GroupID id = pool->_add_group_task(Callable(), &TaskGraph::_process_group_element, node, nullptr, node->elements, -1, node_high_priority, node->description, &TaskGraph::_group_finished, node);
+			MutexLock lock(posted_mutex);
+			posted_groups.push_back(id);
+		} else {
+			_node_finished(node); // Nothing to process.
+		}
+
+		_release();
+	}
+}
+
+void TaskGraph::_node_finished(Node *p_node) {
+	uint32_t dependent_count = p_node->dependents.size();
+	Node **ready = (Node **)alloca(sizeof(Node *) * MAX(dependent_count, 1u));
+	uint32_t ready_count = 0;
+	for (NodeID dependent : p_node->dependents) {
+		Node *node = nodes[dependent];
+		if (node->pending_dependencies.decrement() == 0) {
+			ready[ready_count++] = node;
+		}
+	}
+
+	if (ready_count > 1) {
+		SortArray<Node *, NodeCriticalCostSort> sorter;
+		sorter.sort(ready, ready_count);
+	}
+	_post_nodes(ready, ready_count);
+
+	_release(); // Must be last, the graph may be gone after the final release.
+}
+
+void TaskGraph::_release(uint32_t p_count) {
+	if (outstanding.sub(p_count) == 0) {
+		done_semaphore.post();
+	}
+}
+
+Error TaskGraph::run(WorkerThreadPool *p_pool, bool p_high_priority) {
+	ERR_FAIL_COND_V_MSG(running, ERR_BUSY, "TaskGraph is already running, wait() for it first.");
+	if (critical_path_dirty && !_update_critical_path()) {
+		return ERR_CYCLIC_LINK;
+	}
+
+	pool = p_pool ? p_pool : WorkerThreadPool::get_singleton();
+	ERR_FAIL_NULL_V(pool, ERR_UNCONFIGURED);
+	high_priority = p_high_priority;
+	running = true;
+
+	posted_tasks.clear();
+	posted_groups.clear();
+
+	if (nodes.is_empty()) {
+		done_semaphore.post();
+		return OK;
+	}
+
+	outstanding.set(nodes.size() * 2);
+
+	LocalVector<Node *> roots;
+	for (Node *node : nodes) {
+		node->pending_dependencies.set(node->dependency_count);
+		if (node->dependency_count == 0) {
+			roots.push_back(node);
+		}
+	}
+
+	if (roots.size() > 1) {
+		SortArray<Node *, NodeCriticalCostSort> sorter;
+		sorter.sort(roots.ptr(), roots.size());
+	}
+	_post_nodes(roots.ptr(), roots.size());
+
+	return OK;
+}
+
+void TaskGraph::wait() {
+	ERR_FAIL_COND_MSG(!running, "TaskGraph is not running.");
+	ERR_FAIL_COND_MSG(pool->get_thread_index() != -1, "Can't wait for a TaskGraph from a thread of the pool running it.");
+
+	done_semaphore.wait();
+
+	// Everything has run already, this only lets the pool reclaim the tasks and groups.
+	for (WorkerThreadPool::TaskID id : posted_tasks) {
+		pool->wait_for_task_completion(id);
+	}
+	for (WorkerThreadPool::GroupID id : posted_groups) {
+		pool->wait_for_group_task_completion(id);
+	}
+
+	running = false;
+}
+
+void TaskGraph::clear() {
+	ERR_FAIL_COND_MSG(running, "Can't clear a running TaskGraph.");
+
+	for (Node *node : nodes) {
+		if (node->template_userdata) {
+			memdelete(node->template_userdata);
+		}
+		memdelete(node);
+	}
+	nodes.clear();
+	critical_path_start = INVALID_NODE_ID;
+	critical_path_dirty = true;
+}
+
+TaskGraph::~TaskGraph() {
+	if (running) {
+		wait();
+	}
+	clear();
+}
@@ -0,0 +1,179 @@
+/**************************************************************************/
+/*  task_graph.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// A set of tasks and group tasks with dependencies between them, run on a WorkerThreadPool.
+// Each node is posted as soon as all the nodes it depends on are done, so independent stages
+// overlap instead of every stage waiting at a barrier. Nodes on the critical path (the
+// costliest chain to the end of the graph) are posted first and with high priority.
+//
+// A graph is built once and can be run any number of times, but only one run at a time.
+class TaskGraph {
+public:
+	typedef int32_t NodeID;
+
+	enum {
+		INVALID_NODE_ID = -1
+	};
+
+private:
+	struct BaseTemplateUserdata {
+		virtual void callback() {}
+		virtual void callback_indexed(uint32_t p_index) {}
+		virtual ~BaseTemplateUserdata() {}
+	};
+
+	template <typename C, typename M, typename U>
+	struct TaskUserData : public BaseTemplateUserdata {
+		C *instance;
+		M method;
+		U userdata;
+		virtual void callback() override {
+			(instance->*method)(userdata);
+		}
+	};
+
+	template <typename C, typename M, typename U>
+	struct GroupUserData : public BaseTemplateUserdata {
+		C *instance;
+		M method;
+		U userdata;
+		virtual void callback_indexed(uint32_t p_index) override {
+			(instance->*method)(p_index, userdata);
+		}
+	};
+
+	struct Node {
+		TaskGraph *graph = nullptr;
+		NodeID self = INVALID_NODE_ID;
+		void (*native_func)(void *) = nullptr;
+		void (*native_group_func)(void *, uint32_t) = nullptr;
+		void *native_func_userdata = nullptr;
+		BaseTemplateUserdata *template_userdata = nullptr;
+		bool is_group = false;
+		uint32_t elements = 0;
+		String description;
+		float cost = 1.0;
+
+		LocalVector<NodeID> dependents;
+		uint32_t dependency_count = 0;
+
+		// Updated by run().
+		float critical_cost = 0.0; // Cost of the costliest chain from this node to the end of the graph.
+		NodeID critical_next = INVALID_NODE_ID;
+		bool critical = false;
+		SafeNumeric<uint32_t> pending_dependencies;
+	};
+
+	struct NodeCriticalCostSort {
+		_FORCE_INLINE_ bool operator()(const Node *p_a, const Node *p_b) const { return p_a->critical_cost > p_b->critical_cost; }
+	};
+
+	LocalVector<Node *> nodes;
+	NodeID critical_path_start = INVALID_NODE_ID;
+	bool critical_path_dirty = true;
+
+	WorkerThreadPool *pool = nullptr;
+	bool high_priority = false;
+	bool running = false;
+
+	// Two references per node, one released when the node finishes and one when the
+	// thread posting it has recorded its ID, so wait() knows everything can be reclaimed.
+	SafeNumeric<uint32_t> outstanding;
+	Semaphore done_semaphore;
+
+	BinaryMutex posted_mutex;
+	LocalVector<WorkerThreadPool::TaskID> posted_tasks;
+	LocalVector<WorkerThreadPool::GroupID> posted_groups;
+
+	NodeID _add_node(void (*p_func)(void *), void (*p_group_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_is_group, int p_elements, const String &p_description);
+	bool _update_critical_path();
+
+	void _post_nodes(Node **p_nodes, uint32_t p_count);
+	void _node_finished(Node *p_node);
+	void _release(uint32_t p_count = 1);
+
+	static void _process_node(void *p_node);
+	static void _process_group_element(void *p_node, uint32_t p_index);
+	static void _group_finished(void *p_node);
+
+public:
+	template <typename C, typename M, typename U>
+	NodeID add_template_node(C *p_instance, M p_method, U p_userdata, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_node(nullptr, nullptr, nullptr, ud, false, 0, p_description);
+	}
+	NodeID add_native_node(void (*p_func)(void *), void *p_userdata, const String &p_description = String());
+
+	template <typename C, typename M, typename U>
+	NodeID add_template_group_node(C *p_instance, M p_method, U p_userdata, int p_elements, const String &p_description = String()) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_node(nullptr, nullptr, nullptr, ud, true, p_elements, p_description);
+	}
+	NodeID add_native_group_node(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const String &p_description = String());
+
+	// The element count of a group node may change between runs (e.g. number of islands).
+	void set_group_node_elements(NodeID p_node, int p_elements);
+
+	// p_node will only start once p_depends_on is done.
+	void add_dependency(NodeID p_node, NodeID p_depends_on);
+
+	// Relative cost estimate used to find the critical path, 1 by default.
+	void set_node_cost(NodeID p_node, float p_cost);
+	float get_node_cost(NodeID p_node) const;
+
+	int get_node_count() const { return nodes.size(); }
+
+	LocalVector<NodeID> get_critical_path();
+	float get_critical_path_cost();
+
+	Error run(WorkerThreadPool *p_pool = nullptr, bool p_high_priority = false);
+	void wait();
+	bool is_running() const { return running; }
+
+	void clear();
+
+	~TaskGraph();
+};
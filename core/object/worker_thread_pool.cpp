@@ -91,22 +91,21 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// Handling a group
 		bool do_post = false;
 
-		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
-
-			if (work_index >= p_task->group->max) {
-				break;
-			}
-			if (p_task->native_group_func) {
-				p_task->native_group_func(p_task->native_func_userdata, work_index);
-			} else if (p_task->template_userdata) {
-				p_task->template_userdata->callback_indexed(work_index);
-			} else {
-				p_task->callable.call(work_index);
+		uint32_t begin = 0;
+		uint32_t end = 0;
+		while (_take_group_elements(p_task->group, p_task->group_range, begin, end)) {
+			for (uint32_t work_index = begin; work_index < end; work_index++) {
+				if (p_task->native_group_func) {
+					p_task->native_group_func(p_task->native_func_userdata, work_index);
+				} else if (p_task->template_userdata) {
+					p_task->template_userdata->callback_indexed(work_index);
+				} else {
+					p_task->callable.call(work_index);
+				}
 			}
 
 			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
+			uint32_t completed_amount = p_task->group->completed_index.add(end - begin);
 
 			if (completed_amount == p_task->group->max) {
 				do_post = true;
@@ -118,6 +117,9 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
+			if (p_task->group->completion_func) {
+				p_task->group->completion_func(p_task->group->completion_userdata);
+			}
 			p_task->group->done_semaphore.post();
 			p_task->group->completed.set_to(true);
 		}
@@ -180,6 +182,67 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 #endif
 }
 
+bool WorkerThreadPool::_take_group_elements(Group *p_group, uint32_t p_range, uint32_t &r_begin, uint32_t &r_end) {
+	std::atomic<uint64_t> &own_bounds = p_group->ranges[p_range].bounds;
+
+	while (true) {
+		uint64_t bounds = own_bounds.load(std::memory_order_acquire);
+		uint32_t begin = uint32_t(bounds);
+		uint32_t end = uint32_t(bounds >> 32);
+
+		if (begin < end) {
+			// Chunks shrink along with the range, so there is something left to steal until the very end.
+			uint32_t chunk = MAX(1u, (end - begin) / GROUP_CHUNK_DIVISOR);
+			uint64_t new_bounds = (uint64_t(end) << 32) | (begin + chunk);
+			if (own_bounds.compare_exchange_weak(bounds, new_bounds, std::memory_order_acq_rel)) {
+				r_begin = begin;
+				r_end = begin + chunk;
+				return true;
+			}
+			continue; // A thief shrank the range meanwhile.
+		}
+
+		if (!_steal_group_elements(p_group, p_range)) {
+			return false;
+		}
+	}
+}
+
+bool WorkerThreadPool::_steal_group_elements(Group *p_group, uint32_t p_range) {
+	uint32_t range_count = p_group->range_count;
+
+	while (true) {
+		uint32_t victim = UINT32_MAX;
+		uint32_t victim_size = 0;
+		uint64_t victim_bounds = 0;
+		for (uint32_t i = 1; i < range_count; i++) {
+			uint32_t idx = (p_range + i) % range_count;
+			uint64_t bounds = p_group->ranges[idx].bounds.load(std::memory_order_acquire);
+			uint32_t size = uint32_t(bounds >> 32) - uint32_t(bounds);
+			if (size > victim_size) {
+				victim = idx;
+				victim_size = size;
+				victim_bounds = bounds;
+			}
+		}
+
+		if (victim == UINT32_MAX) {
+			// Nothing left. Ranges being moved by other thieves will be processed by them.
+			return false;
+		}
+
+		uint32_t begin = uint32_t(victim_bounds);
+		uint32_t end = uint32_t(victim_bounds >> 32);
+		uint32_t split = end - (victim_size + 1) / 2;
+		if (p_group->ranges[victim].bounds.compare_exchange_strong(victim_bounds, (uint64_t(split) << 32) | begin, std::memory_order_acq_rel)) {
+			// The own range is empty, so nobody else writes it until it holds the stolen elements.
+			p_group->ranges[p_range].bounds.store((uint64_t(end) << 32) | split, std::memory_order_release);
+			return true;
+		}
+		// Lost against the owner or another thief, look again.
+	}
+}
+
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
@@ -619,7 +682,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, void (*p_completion_func)(void *), void *p_completion_userdata) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -631,11 +694,18 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	GroupID id = last_task++;
 	group->max = p_elements;
 	group->self = id;
+	group->completion_func = p_completion_func;
+	group->completion_userdata = p_completion_userdata;
 
 	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
 		// Should really not call it with zero Elements, but at least it should work.
 		group->completed.set_to(true);
+		if (p_completion_func) {
+			lock.temp_unlock();
+			p_completion_func(p_completion_userdata);
+			lock.temp_relock();
+		}
 		group->done_semaphore.post();
 		group->tasks_used = 0;
 		p_tasks = 0;
@@ -644,7 +714,16 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		}
 
 	} else {
+		// More tasks than elements would just find nothing to do.
+		p_tasks = CLAMP(p_tasks, 1, p_elements);
 		group->tasks_used = p_tasks;
+		group->resize_ranges(p_tasks);
+		for (int i = 0; i < p_tasks; i++) {
+			uint64_t begin = uint64_t(p_elements) * i / p_tasks;
+			uint64_t end = uint64_t(p_elements) * (i + 1) / p_tasks;
+			group->ranges[i].bounds.store((end << 32) | begin, std::memory_order_relaxed);
+		}
+
 		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
 		for (int i = 0; i < p_tasks; i++) {
 			Task *task = task_allocator.alloc();
@@ -652,6 +731,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->native_func_userdata = p_userdata;
 			task->description = p_description;
 			task->group = group;
+			task->group_range = i;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
 			tasks_posted[i] = task;
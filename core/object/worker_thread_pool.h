@@ -42,6 +42,8 @@
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
+	friend class TaskGraph;
+
 public:
 	enum {
 		INVALID_TASK_ID = -1
@@ -60,14 +62,36 @@ private:
 	};
 
 	struct Group {
+		// Elements are split in one range per task. Each task takes chunks from the front
+		// of its own range and, once it runs dry, steals the back half of the largest
+		// range left, so work is balanced without all tasks contending on one counter.
+		struct alignas(64) Range { // One range per cache line.
+			std::atomic<uint64_t> bounds; // Begin in the low 32 bits, end in the high ones.
+		};
+
 		GroupID self = -1;
-		SafeNumeric<uint32_t> index;
+		// Ranges live in over-allocated storage, so they start on a cache line boundary
+		// regardless of the alignment the allocator guarantees.
+		LocalVector<uint8_t> range_storage;
+		Range *ranges = nullptr;
+		uint32_t range_count = 0;
 		SafeNumeric<uint32_t> completed_index;
 		uint32_t max = 0;
+		void (*completion_func)(void *) = nullptr; // Run by the thread finishing the last element, before waiters are released.
+		void *completion_userdata = nullptr;
 		Semaphore done_semaphore;
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+
+		void resize_ranges(uint32_t p_count) {
+			range_storage.resize(p_count * sizeof(Range) + alignof(Range) - 1);
+			ranges = (Range *)(((uintptr_t)range_storage.ptr() + alignof(Range) - 1) & ~(uintptr_t)(alignof(Range) - 1));
+			for (uint32_t i = 0; i < p_count; i++) {
+				memnew_placement(&ranges[i], Range);
+			}
+			range_count = p_count;
+		}
 	};
 
 	struct Task {
@@ -87,6 +111,7 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t group_range = 0;
 
 		void free_template_userdata();
 		Task() :
@@ -97,6 +122,7 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t GROUP_CHUNK_DIVISOR = 4; // A task takes this fraction of its remaining range at once.
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -172,6 +198,9 @@ private:
 
 	void _process_task(Task *task);
 
+	static bool _take_group_elements(Group *p_group, uint32_t p_range, uint32_t &r_begin, uint32_t &r_end);
+	static bool _steal_group_elements(Group *p_group, uint32_t p_range);
+
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
@@ -189,7 +218,7 @@ private:
 #endif
 
 	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, void (*p_completion_func)(void *) = nullptr, void *p_completion_userdata = nullptr);
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -0,0 +1,188 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include "core/os/memory.h"
+#include "core/os/spin_lock.h"
+
+thread_local FrameArena::ThreadArena *FrameArena::thread_arena = nullptr;
+FrameArena::ThreadArena *FrameArena::free_arenas = nullptr;
+
+static SpinLock free_arenas_lock;
+
+// Frees the blocks of a thread when it exits and keeps its arena for another thread.
+struct FrameArenaThreadReleaser {
+	~FrameArenaThreadReleaser() {
+		FrameArena::ThreadArena *arena = FrameArena::thread_arena;
+		if (arena) {
+			FrameArena::_free_blocks(arena);
+			arena->epoch.fetch_add(1, std::memory_order_acq_rel);
+			FrameArena::thread_arena = nullptr;
+
+			free_arenas_lock.lock();
+			arena->next_free = FrameArena::free_arenas;
+			FrameArena::free_arenas = arena;
+			free_arenas_lock.unlock();
+		}
+	}
+};
+
+static thread_local FrameArenaThreadReleaser thread_releaser;
+
+FrameArena::ThreadArena *FrameArena::_create_thread_arena() {
+	(void)&thread_releaser; // Makes sure it's constructed, so it's destroyed on exit.
+
+	free_arenas_lock.lock();
+	ThreadArena *arena = free_arenas;
+	if (arena) {
+		free_arenas = arena->next_free;
+		arena->next_free = nullptr;
+	}
+	free_arenas_lock.unlock();
+
+	if (!arena) {
+		arena = memnew(ThreadArena);
+	}
+	thread_arena = arena;
+	return arena;
+}
+
+void FrameArena::_free_blocks(ThreadArena *p_arena) {
+	Block *block = p_arena->blocks;
+	while (block) {
+		Block *next = block->next;
+		Memory::free_static(block);
+		block = next;
+	}
+	p_arena->blocks = nullptr;
+	p_arena->pos = nullptr;
+	p_arena->end = nullptr;
+	p_arena->last_alloc = nullptr;
+	p_arena->used = 0;
+}
+
+void FrameArena::_rewind(ThreadArena *p_arena) {
+	// Containers filled during the ended frame see it changed and drop their storage.
+	p_arena->epoch.fetch_add(1, std::memory_order_acq_rel);
+	p_arena->last_alloc = nullptr;
+	p_arena->used = 0;
+
+	Block *block = p_arena->blocks;
+	if (!block) {
+		return;
+	}
+
+	if (block->next) {
+		// The last frame needed several blocks, replace them with a single one that fits it all.
+		size_t total = 0;
+		for (Block *b = block; b; b = b->next) {
+			total += b->size;
+		}
+		_free_blocks(p_arena);
+
+		block = (Block *)Memory::alloc_static(total);
+		ERR_FAIL_NULL(block);
+		block->next = nullptr;
+		block->size = total;
+		p_arena->blocks = block;
+	}
+
+	p_arena->pos = (uint8_t *)(block + 1);
+	p_arena->end = (uint8_t *)block + block->size;
+}
+
+void *FrameArena::_alloc_slow(ThreadArena *p_arena, size_t p_bytes, size_t p_alignment) {
+	size_t size = MAX(MIN_BLOCK_SIZE, sizeof(Block) + p_bytes + p_alignment);
+	if (p_arena->blocks) {
+		size = MAX(size, p_arena->blocks->size * 2);
+		p_arena->used += p_arena->pos - (uint8_t *)(p_arena->blocks + 1);
+	}
+
+	Block *block = (Block *)Memory::alloc_static(size);
+	ERR_FAIL_NULL_V(block, nullptr);
+	block->next = p_arena->blocks;
+	block->size = size;
+	p_arena->blocks = block;
+
+	uint8_t *ptr = (uint8_t *)(((uintptr_t)(block + 1) + p_alignment - 1) & ~(uintptr_t)(p_alignment - 1));
+	p_arena->pos = ptr + p_bytes;
+	p_arena->end = (uint8_t *)block + size;
+	p_arena->last_alloc = ptr;
+	return ptr;
+}
+
+void *FrameArena::realloc(void *p_memory, size_t p_old_bytes, size_t p_new_bytes, size_t p_alignment) {
+	if (!p_memory) {
+		return alloc(p_new_bytes, p_alignment);
+	}
+
+	ThreadArena *arena = _get_thread_arena();
+	if (p_memory == arena->last_alloc && (uint8_t *)p_memory + p_new_bytes <= arena->end) {
+		arena->pos = (uint8_t *)p_memory + p_new_bytes;
+		return p_memory;
+	}
+
+	void *new_memory = alloc(p_new_bytes, p_alignment);
+	if (new_memory) {
+		memcpy(new_memory, p_memory, MIN(p_old_bytes, p_new_bytes));
+	}
+	return new_memory;
+}
+
+void FrameArena::free(void *p_memory) {
+	ThreadArena *arena = thread_arena;
+	if (arena && p_memory && p_memory == arena->last_alloc) {
+		arena->pos = (uint8_t *)p_memory;
+		arena->last_alloc = nullptr;
+	}
+}
+
+void FrameArena::end_frame() {
+	ThreadArena *arena = thread_arena;
+	if (arena) {
+		_rewind(arena);
+	}
+}
+
+size_t FrameArena::get_thread_usage() {
+	ThreadArena *arena = thread_arena;
+	if (!arena || !arena->blocks) {
+		return 0;
+	}
+	return arena->used + (arena->pos - (uint8_t *)(arena->blocks + 1));
+}
+
+void FrameArena::release_thread_memory() {
+	if (thread_arena) {
+		_free_blocks(thread_arena);
+		thread_arena->epoch.fetch_add(1, std::memory_order_acq_rel);
+	}
+}
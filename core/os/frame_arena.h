@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <atomic>
+
+// Linear allocator for data that only lives during the current frame.
+//
+// Each thread bumps through its own arena, so allocating takes no locks.
+// Frames are owned by threads: end_frame() only rewinds the arena of the
+// calling thread, so work still running on other threads (WorkerThreadPool
+// tasks, physics or rendering threads) keeps its memory. The main loop ends
+// the frame of the main thread once per iteration. Other threads that
+// allocate from the arena end their own frames when their frame-scoped data
+// is no longer needed, their arena keeps growing until they do.
+// Memory must not be used after its thread ended the frame it was allocated
+// in, and destructors are never run for it.
+//
+// Use FrameLocalVector and FrameHashMap to get containers backed by it.
+class FrameArena {
+	static constexpr size_t MIN_BLOCK_SIZE = 64 * 1024;
+
+	struct Block {
+		Block *next = nullptr;
+		size_t size = 0;
+	};
+
+	// Never freed, arenas of exited threads are reused by new ones. This keeps
+	// Frame::arena valid for containers that outlive the thread they allocated on.
+	struct ThreadArena {
+		Block *blocks = nullptr; // Most recent first.
+		uint8_t *pos = nullptr;
+		uint8_t *end = nullptr;
+		uint8_t *last_alloc = nullptr; // Can be resized in place.
+		size_t used = 0; // In previous blocks of this frame.
+		std::atomic<uint64_t> epoch = 1; // Bumped every time the frame of this arena ends.
+		ThreadArena *next_free = nullptr;
+	};
+
+	static thread_local ThreadArena *thread_arena;
+	static ThreadArena *free_arenas;
+
+	friend struct FrameArenaThreadReleaser;
+
+	static ThreadArena *_create_thread_arena();
+	static void _free_blocks(ThreadArena *p_arena);
+	static void _rewind(ThreadArena *p_arena);
+	static void *_alloc_slow(ThreadArena *p_arena, size_t p_bytes, size_t p_alignment);
+
+	_FORCE_INLINE_ static ThreadArena *_get_thread_arena() {
+		ThreadArena *arena = thread_arena;
+		if (unlikely(!arena)) {
+			arena = _create_thread_arena();
+		}
+		return arena;
+	}
+
+public:
+	static constexpr size_t DEFAULT_ALIGNMENT = alignof(max_align_t);
+
+	// The arena frame some memory belongs to. Containers keep it to find out
+	// whether their storage is still theirs.
+	class Frame {
+		friend class FrameArena;
+
+		ThreadArena *arena = nullptr;
+		uint64_t epoch = 0;
+	};
+
+	// Zero-size allocations return a unique pointer, like allocations of one byte.
+	_FORCE_INLINE_ static void *alloc(size_t p_bytes, size_t p_alignment = DEFAULT_ALIGNMENT) {
+		if (unlikely(p_bytes == 0)) {
+			p_bytes = 1;
+		}
+		ThreadArena *arena = _get_thread_arena();
+		// Computed on integers, pos and end are null until the first block is allocated.
+		uintptr_t ptr = ((uintptr_t)arena->pos + p_alignment - 1) & ~(uintptr_t)(p_alignment - 1);
+		if (likely(ptr + p_bytes <= (uintptr_t)arena->end)) {
+			arena->pos = (uint8_t *)(ptr + p_bytes);
+			arena->last_alloc = (uint8_t *)ptr;
+			return (void *)ptr;
+		}
+		return _alloc_slow(arena, p_bytes, p_alignment);
+	}
+
+	// Grows or shrinks in place when p_memory is the latest allocation of this thread.
+	static void *realloc(void *p_memory, size_t p_old_bytes, size_t p_new_bytes, size_t p_alignment = DEFAULT_ALIGNMENT);
+	// Only gives memory back when p_memory is the latest allocation of this thread, the rest waits for the frame to end.
+	static void free(void *p_memory);
+
+	template <typename T>
+	_FORCE_INLINE_ static T *alloc_array(size_t p_count) {
+		return (T *)alloc(sizeof(T) * p_count, alignof(T) > DEFAULT_ALIGNMENT ? alignof(T) : DEFAULT_ALIGNMENT);
+	}
+
+	// Current frame of the calling thread's arena.
+	_FORCE_INLINE_ static Frame get_frame() {
+		Frame frame;
+		frame.arena = _get_thread_arena();
+		frame.epoch = frame.arena->epoch.load(std::memory_order_relaxed);
+		return frame;
+	}
+	// Whether the thread p_frame belongs to hasn't ended it yet. Can be called from any thread.
+	_FORCE_INLINE_ static bool is_current(const Frame &p_frame) {
+		return p_frame.arena && p_frame.arena->epoch.load(std::memory_order_acquire) == p_frame.epoch;
+	}
+	// Ends the frame of the calling thread, its arena is rewound.
+	static void end_frame();
+
+	// Bytes allocated by the current thread during this frame.
+	static size_t get_thread_usage();
+	// Frees the blocks of the current thread, which also ends its frame. They are allocated again when needed.
+	static void release_thread_memory();
+};
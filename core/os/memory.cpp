@@ -32,6 +32,10 @@
 
 #include "core/templates/safe_refcount.h"
 
+#ifdef BUILTIN_ALLOCATOR_ENABLED
+#include "core/os/small_allocator.h"
+#endif
+
 #include <stdlib.h>
 #include <string.h>
 
@@ -57,12 +61,38 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 }
 #endif
 
+#ifndef BUILTIN_ALLOCATOR_ENABLED
 #ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
 #endif
 
 SafeNumeric<uint64_t> Memory::alloc_count;
+#endif
+
+static _FORCE_INLINE_ void *_system_alloc(size_t p_bytes) {
+#ifdef BUILTIN_ALLOCATOR_ENABLED
+	return SmallAllocator::alloc(p_bytes);
+#else
+	return malloc(p_bytes);
+#endif
+}
+
+static _FORCE_INLINE_ void *_system_realloc(void *p_memory, size_t p_bytes) {
+#ifdef BUILTIN_ALLOCATOR_ENABLED
+	return SmallAllocator::realloc(p_memory, p_bytes);
+#else
+	return realloc(p_memory, p_bytes);
+#endif
+}
+
+static _FORCE_INLINE_ void _system_free(void *p_memory) {
+#ifdef BUILTIN_ALLOCATOR_ENABLED
+	SmallAllocator::free(p_memory);
+#else
+	free(p_memory);
+#endif
+}
 
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
 	DEV_ASSERT(is_power_of_2(p_alignment));
@@ -103,11 +133,16 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+	void *mem = _system_alloc(p_bytes + (prepad ? DATA_OFFSET : 0));
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 
+#ifdef BUILTIN_ALLOCATOR_ENABLED
+	// Counted per thread, so allocating doesn't contend on a shared atomic.
+	SmallAllocator::add_usage(0, 1);
+#else
 	alloc_count.increment();
+#endif
 
 	if (prepad) {
 		uint8_t *s8 = (uint8_t *)mem;
@@ -116,8 +151,12 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		*s = p_bytes;
 
 #ifdef DEBUG_ENABLED
+#ifdef BUILTIN_ALLOCATOR_ENABLED
+		SmallAllocator::add_usage(p_bytes, 0);
+#else
 		uint64_t new_mem_usage = mem_usage.add(p_bytes);
 		max_usage.exchange_if_greater(new_mem_usage);
+#endif
 #endif
 		return s8 + DATA_OFFSET;
 	} else {
@@ -143,21 +182,25 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
 
 #ifdef DEBUG_ENABLED
+#ifdef BUILTIN_ALLOCATOR_ENABLED
+		SmallAllocator::add_usage((int64_t)p_bytes - (int64_t)*s, 0);
+#else
 		if (p_bytes > *s) {
 			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
 			max_usage.exchange_if_greater(new_mem_usage);
 		} else {
 			mem_usage.sub(*s - p_bytes);
 		}
+#endif
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			_system_free(mem);
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+			mem = (uint8_t *)_system_realloc(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
@@ -167,7 +210,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 			return mem + DATA_OFFSET;
 		}
 	} else {
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		mem = (uint8_t *)_system_realloc(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 
@@ -186,19 +229,27 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
+#ifdef BUILTIN_ALLOCATOR_ENABLED
+	SmallAllocator::add_usage(0, -1);
+#else
 	alloc_count.decrement();
+#endif
 
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
 #ifdef DEBUG_ENABLED
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+#ifdef BUILTIN_ALLOCATOR_ENABLED
+		SmallAllocator::add_usage(-(int64_t)*s, 0);
+#else
 		mem_usage.sub(*s);
+#endif
 #endif
 
-		free(mem);
+		_system_free(mem);
 	} else {
-		free(mem);
+		_system_free(mem);
 	}
 }
 
@@ -207,7 +258,9 @@ uint64_t Memory::get_mem_available() {
 }
 
 uint64_t Memory::get_mem_usage() {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) && defined(BUILTIN_ALLOCATOR_ENABLED)
+	return SmallAllocator::get_usage();
+#elif defined(DEBUG_ENABLED)
 	return mem_usage.get();
 #else
 	return 0;
@@ -215,13 +268,23 @@ uint64_t Memory::get_mem_usage() {
 }
 
 uint64_t Memory::get_mem_max_usage() {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) && defined(BUILTIN_ALLOCATOR_ENABLED)
+	return SmallAllocator::get_max_usage();
+#elif defined(DEBUG_ENABLED)
 	return max_usage.get();
 #else
 	return 0;
 #endif
 }
 
+uint64_t Memory::get_alloc_count() {
+#ifdef BUILTIN_ALLOCATOR_ENABLED
+	return SmallAllocator::get_alloc_count();
+#else
+	return alloc_count.get();
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
@@ -38,12 +38,14 @@
 #include <type_traits>
 
 class Memory {
+#ifndef BUILTIN_ALLOCATOR_ENABLED
 #ifdef DEBUG_ENABLED
 	static SafeNumeric<uint64_t> mem_usage;
 	static SafeNumeric<uint64_t> max_usage;
 #endif
 
 	static SafeNumeric<uint64_t> alloc_count;
+#endif
 
 public:
 	// Alignment:  ↓ max_align_t        ↓ uint64_t          ↓ max_align_t
@@ -88,6 +90,7 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+	static uint64_t get_alloc_count(); // Number of live allocations.
 };
 
 class DefaultAllocator {
@@ -0,0 +1,441 @@
+/**************************************************************************/
+/*  small_allocator.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_allocator.h"
+
+#include "core/os/spin_lock.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+
+// Everything below must be constant-initialized, since allocations happen
+// before (and after) static constructors run.
+
+static constexpr uint32_t SPAN_SHIFT = 16;
+static constexpr size_t SPAN_SIZE = size_t(1) << SPAN_SHIFT;
+static constexpr uint32_t SPANS_PER_CHUNK = 16;
+
+// Two-level map from span address to size class, covering 48-bit addresses.
+static constexpr uint32_t PAGEMAP_LEAF_BITS = 16;
+static constexpr uint32_t PAGEMAP_ROOT_BITS = 48 - SPAN_SHIFT - PAGEMAP_LEAF_BITS;
+
+static constexpr uint32_t SIZE_CLASS_COUNT = 20;
+static constexpr uint16_t size_classes[SIZE_CLASS_COUNT] = {
+	16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512, 640, 768, 896, 1024
+};
+static_assert(size_classes[SIZE_CLASS_COUNT - 1] == SmallAllocator::MAX_SMALL_SIZE);
+
+struct SizeClassTable {
+	uint8_t index[SmallAllocator::MAX_SMALL_SIZE / 16 + 1] = {};
+	uint16_t batch[SIZE_CLASS_COUNT] = {}; // Blocks moved at once between a thread and the shared lists.
+
+	constexpr SizeClassTable() {
+		uint32_t size_class = 0;
+		for (uint32_t i = 0; i <= SmallAllocator::MAX_SMALL_SIZE / 16; i++) {
+			while (size_classes[size_class] < i * 16) {
+				size_class++;
+			}
+			index[i] = size_class;
+		}
+		for (uint32_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+			uint32_t count = 8192 / size_classes[i];
+			batch[i] = count < 8 ? 8 : (count > 64 ? 64 : count);
+		}
+	}
+};
+static constexpr SizeClassTable size_class_table;
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+struct CentralList {
+	SpinLock lock;
+	FreeBlock *free = nullptr;
+	uint8_t *carve = nullptr; // Part of the newest span not handed out yet.
+	uint8_t *carve_end = nullptr;
+};
+static CentralList central_lists[SIZE_CLASS_COUNT];
+
+static SpinLock span_lock;
+static uint8_t *chunk_next = nullptr;
+static uint8_t *chunk_end = nullptr;
+static std::atomic<uint8_t *> pagemap[size_t(1) << PAGEMAP_ROOT_BITS];
+
+struct ThreadStats {
+	std::atomic<int64_t> usage;
+	std::atomic<int64_t> allocs;
+	ThreadStats *next;
+	bool in_use;
+};
+
+static SpinLock stats_lock;
+static ThreadStats *stats_list = nullptr;
+static std::atomic<int64_t> shared_usage; // Threads that exited or have no cache.
+static std::atomic<int64_t> shared_allocs;
+static std::atomic<int64_t> max_usage;
+
+enum ThreadCacheState : uint8_t {
+	THREAD_CACHE_UNINITIALIZED,
+	THREAD_CACHE_ACTIVE,
+	THREAD_CACHE_DESTROYED,
+};
+
+struct ThreadCache {
+	FreeBlock *free[SIZE_CLASS_COUNT];
+	uint32_t count[SIZE_CLASS_COUNT];
+	ThreadStats *stats;
+	ThreadCacheState state;
+};
+
+// Plain data, so it is usable at any time during the life of the thread.
+static thread_local ThreadCache thread_cache;
+
+// Only its destructor matters: it hands the thread cache back when the thread exits.
+struct ThreadCacheReleaser {
+	~ThreadCacheReleaser();
+};
+static thread_local ThreadCacheReleaser thread_cache_releaser;
+
+static _FORCE_INLINE_ uint32_t _get_size_class(size_t p_bytes) {
+	return size_class_table.index[(p_bytes + 15) >> 4];
+}
+
+static _FORCE_INLINE_ int _find_size_class(const void *p_memory) {
+	uint64_t address = (uint64_t)(uintptr_t)p_memory;
+	if (unlikely(address >> 48)) {
+		return -1;
+	}
+	uint64_t span = address >> SPAN_SHIFT;
+	const uint8_t *leaf = pagemap[span >> PAGEMAP_LEAF_BITS].load(std::memory_order_acquire);
+	if (!leaf) {
+		return -1;
+	}
+	return int(leaf[span & ((1 << PAGEMAP_LEAF_BITS) - 1)]) - 1;
+}
+
+static uint8_t *_alloc_span(uint32_t p_size_class) {
+	span_lock.lock();
+
+	if (chunk_next == chunk_end) {
+		// One spare span to align the chunk to the span size.
+		uint8_t *raw = (uint8_t *)::malloc(SPAN_SIZE * (SPANS_PER_CHUNK + 1));
+		uint64_t aligned = ((uint64_t)(uintptr_t)raw + SPAN_SIZE - 1) & ~(uint64_t)(SPAN_SIZE - 1);
+		if (!raw || ((aligned + SPAN_SIZE * SPANS_PER_CHUNK - 1) >> 48)) {
+			// Out of memory, or out of the range of the map.
+			::free(raw);
+			span_lock.unlock();
+			return nullptr;
+		}
+		chunk_next = (uint8_t *)(uintptr_t)aligned;
+		chunk_end = chunk_next + SPAN_SIZE * SPANS_PER_CHUNK;
+	}
+
+	uint8_t *span = chunk_next;
+	uint64_t span_index = (uint64_t)(uintptr_t)span >> SPAN_SHIFT;
+	std::atomic<uint8_t *> &root = pagemap[span_index >> PAGEMAP_LEAF_BITS];
+	uint8_t *leaf = root.load(std::memory_order_relaxed);
+	if (!leaf) {
+		leaf = (uint8_t *)::calloc(size_t(1) << PAGEMAP_LEAF_BITS, 1);
+		if (!leaf) {
+			span_lock.unlock();
+			return nullptr;
+		}
+		root.store(leaf, std::memory_order_release);
+	}
+	leaf[span_index & ((1 << PAGEMAP_LEAF_BITS) - 1)] = p_size_class + 1;
+	chunk_next += SPAN_SIZE;
+
+	span_lock.unlock();
+	return span;
+}
+
+// Takes up to p_max blocks from the shared list of a size class, returns how many were linked into r_list.
+static uint32_t _central_take(uint32_t p_size_class, uint32_t p_max, FreeBlock *&r_list) {
+	CentralList &central = central_lists[p_size_class];
+	uint32_t size = size_classes[p_size_class];
+	uint32_t taken = 0;
+	FreeBlock *list = nullptr;
+
+	central.lock.lock();
+	while (taken < p_max && central.free) {
+		FreeBlock *block = central.free;
+		central.free = block->next;
+		block->next = list;
+		list = block;
+		taken++;
+	}
+	while (taken < p_max) {
+		if (central.carve == central.carve_end) {
+			uint8_t *span = _alloc_span(p_size_class);
+			if (!span) {
+				break;
+			}
+			central.carve = span;
+			central.carve_end = span + (SPAN_SIZE / size) * size;
+		}
+		FreeBlock *block = (FreeBlock *)central.carve;
+		central.carve += size;
+		block->next = list;
+		list = block;
+		taken++;
+	}
+	central.lock.unlock();
+
+	r_list = list;
+	return taken;
+}
+
+static void _central_give(uint32_t p_size_class, FreeBlock *p_first, FreeBlock *p_last) {
+	CentralList &central = central_lists[p_size_class];
+	central.lock.lock();
+	p_last->next = central.free;
+	central.free = p_first;
+	central.lock.unlock();
+}
+
+static void _thread_cache_init(ThreadCache &p_cache) {
+	(void)&thread_cache_releaser; // Ensures the releaser is constructed, so it is destroyed on exit.
+
+	stats_lock.lock();
+	ThreadStats *stats = stats_list;
+	while (stats && stats->in_use) {
+		stats = stats->next;
+	}
+	if (!stats) {
+		stats = (ThreadStats *)::calloc(1, sizeof(ThreadStats));
+		if (stats) {
+			stats->next = stats_list;
+			stats_list = stats;
+		}
+	}
+	if (stats) {
+		stats->in_use = true;
+	}
+	stats_lock.unlock();
+
+	p_cache.stats = stats;
+	p_cache.state = THREAD_CACHE_ACTIVE;
+}
+
+ThreadCacheReleaser::~ThreadCacheReleaser() {
+	ThreadCache &cache = thread_cache;
+	if (cache.state != THREAD_CACHE_ACTIVE) {
+		return;
+	}
+	cache.state = THREAD_CACHE_DESTROYED;
+
+	for (uint32_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+		FreeBlock *first = cache.free[i];
+		if (!first) {
+			continue;
+		}
+		FreeBlock *last = first;
+		while (last->next) {
+			last = last->next;
+		}
+		_central_give(i, first, last);
+		cache.free[i] = nullptr;
+		cache.count[i] = 0;
+	}
+
+	if (cache.stats) {
+		stats_lock.lock();
+		shared_usage.fetch_add(cache.stats->usage.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		shared_allocs.fetch_add(cache.stats->allocs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		cache.stats->usage.store(0, std::memory_order_relaxed);
+		cache.stats->allocs.store(0, std::memory_order_relaxed);
+		cache.stats->in_use = false;
+		stats_lock.unlock();
+		cache.stats = nullptr;
+	}
+}
+
+void *SmallAllocator::alloc(size_t p_bytes) {
+	if (p_bytes > MAX_SMALL_SIZE) {
+		return ::malloc(p_bytes);
+	}
+
+	uint32_t size_class = _get_size_class(p_bytes);
+	ThreadCache &cache = thread_cache;
+
+	FreeBlock *block = cache.free[size_class];
+	if (likely(block)) {
+		cache.free[size_class] = block->next;
+		cache.count[size_class]--;
+		return block;
+	}
+
+	if (unlikely(cache.state != THREAD_CACHE_ACTIVE)) {
+		if (cache.state == THREAD_CACHE_UNINITIALIZED) {
+			_thread_cache_init(cache);
+		} else {
+			// Thread is exiting, don't cache anything anymore.
+			FreeBlock *list = nullptr;
+			if (_central_take(size_class, 1, list)) {
+				return list;
+			}
+			return ::malloc(size_classes[size_class]);
+		}
+	}
+
+	FreeBlock *list = nullptr;
+	uint32_t taken = _central_take(size_class, size_class_table.batch[size_class], list);
+	if (unlikely(!taken)) {
+		// No more spans, blocks from the system allocator are told apart on free anyway.
+		return ::malloc(size_classes[size_class]);
+	}
+
+	cache.free[size_class] = list->next;
+	cache.count[size_class] = taken - 1;
+	return list;
+}
+
+void SmallAllocator::free(void *p_memory) {
+	if (!p_memory) {
+		return;
+	}
+
+	int size_class = _find_size_class(p_memory);
+	if (size_class < 0) {
+		::free(p_memory);
+		return;
+	}
+
+	FreeBlock *block = (FreeBlock *)p_memory;
+	ThreadCache &cache = thread_cache;
+	if (unlikely(cache.state != THREAD_CACHE_ACTIVE)) {
+		if (cache.state == THREAD_CACHE_UNINITIALIZED) {
+			_thread_cache_init(cache);
+		} else {
+			_central_give(size_class, block, block);
+			return;
+		}
+	}
+
+	block->next = cache.free[size_class];
+	cache.free[size_class] = block;
+	uint32_t batch = size_class_table.batch[size_class];
+	if (unlikely(++cache.count[size_class] > batch * 2)) {
+		// Give a batch back, so memory freed here can be reused by other threads.
+		FreeBlock *first = cache.free[size_class];
+		FreeBlock *last = first;
+		for (uint32_t i = 1; i < batch; i++) {
+			last = last->next;
+		}
+		cache.free[size_class] = last->next;
+		cache.count[size_class] -= batch;
+		_central_give(size_class, first, last);
+	}
+}
+
+void *SmallAllocator::realloc(void *p_memory, size_t p_bytes) {
+	if (!p_memory) {
+		return alloc(p_bytes);
+	}
+
+	int size_class = _find_size_class(p_memory);
+	if (size_class < 0) {
+		return ::realloc(p_memory, p_bytes);
+	}
+
+	if (p_bytes == 0) {
+		free(p_memory);
+		return nullptr;
+	}
+
+	size_t block_size = size_classes[size_class];
+	if (p_bytes <= block_size) {
+		return p_memory;
+	}
+
+	void *new_memory = alloc(p_bytes);
+	if (!new_memory) {
+		return nullptr;
+	}
+	memcpy(new_memory, p_memory, block_size);
+	free(p_memory);
+	return new_memory;
+}
+
+size_t SmallAllocator::get_block_size(const void *p_memory) {
+	int size_class = _find_size_class(p_memory);
+	return size_class < 0 ? 0 : size_classes[size_class];
+}
+
+void SmallAllocator::add_usage(int64_t p_bytes, int64_t p_allocs) {
+	ThreadCache &cache = thread_cache;
+	if (unlikely(cache.state == THREAD_CACHE_UNINITIALIZED)) {
+		_thread_cache_init(cache);
+	}
+
+	ThreadStats *stats = cache.stats;
+	if (likely(stats)) {
+		// Only this thread writes its stats, readers may see a slightly stale value.
+		stats->usage.store(stats->usage.load(std::memory_order_relaxed) + p_bytes, std::memory_order_relaxed);
+		stats->allocs.store(stats->allocs.load(std::memory_order_relaxed) + p_allocs, std::memory_order_relaxed);
+	} else {
+		shared_usage.fetch_add(p_bytes, std::memory_order_relaxed);
+		shared_allocs.fetch_add(p_allocs, std::memory_order_relaxed);
+	}
+}
+
+uint64_t SmallAllocator::get_usage() {
+	stats_lock.lock();
+	int64_t usage = shared_usage.load(std::memory_order_relaxed);
+	for (ThreadStats *stats = stats_list; stats; stats = stats->next) {
+		usage += stats->usage.load(std::memory_order_relaxed);
+	}
+	stats_lock.unlock();
+
+	// Blocks freed on another thread than the one allocating them can make single threads go negative, but not the sum.
+	usage = MAX(usage, (int64_t)0);
+
+	int64_t peak = max_usage.load(std::memory_order_relaxed);
+	while (usage > peak && !max_usage.compare_exchange_weak(peak, usage, std::memory_order_relaxed)) {
+	}
+	return usage;
+}
+
+uint64_t SmallAllocator::get_max_usage() {
+	get_usage();
+	return max_usage.load(std::memory_order_relaxed);
+}
+
+uint64_t SmallAllocator::get_alloc_count() {
+	stats_lock.lock();
+	int64_t allocs = shared_allocs.load(std::memory_order_relaxed);
+	for (ThreadStats *stats = stats_list; stats; stats = stats->next) {
+		allocs += stats->allocs.load(std::memory_order_relaxed);
+	}
+	stats_lock.unlock();
+	return MAX(allocs, (int64_t)0);
+}
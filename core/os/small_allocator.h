@@ -0,0 +1,60 @@
+/**************************************************************************/
+/*  small_allocator.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+// Size-class allocator with per-thread caches. Memory uses it instead of the
+// system allocator when built with `builtin_allocator=yes`.
+//
+// Blocks up to MAX_SMALL_SIZE bytes are carved from 64 KiB spans, each dedicated
+// to a single size class. Every thread keeps a free list per size class and only
+// touches the shared lists, in batches, when its own runs empty or grows too long.
+// Larger blocks go to the system allocator. Spans are never returned to the system.
+//
+// Usage statistics are also kept per thread, so updating them is not a contended
+// atomic operation. They are summed when queried.
+class SmallAllocator {
+public:
+	static constexpr size_t MAX_SMALL_SIZE = 1024;
+
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_memory);
+
+	// Size of the block backing p_memory, or 0 if it comes from the system allocator.
+	static size_t get_block_size(const void *p_memory);
+
+	static void add_usage(int64_t p_bytes, int64_t p_allocs);
+	static uint64_t get_usage();
+	static uint64_t get_max_usage(); // Peak of the values seen by get_usage().
+	static uint64_t get_alloc_count();
+};
@@ -135,7 +135,7 @@ void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
+		MutexLock lock(_get_table_mutex(_data->idx));
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			if (_data->cname) {
@@ -272,7 +272,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 	const uint32_t hash = String::hash(p_name);
 	const uint32_t idx = hash & STRING_TABLE_MASK;
 
-	MutexLock lock(mutex);
+	MutexLock lock(_get_table_mutex(idx));
 	_data = _table[idx];
 
 	while (_data) {
@@ -329,7 +329,7 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 	const uint32_t hash = String::hash(p_static_string.ptr);
 	const uint32_t idx = hash & STRING_TABLE_MASK;
 
-	MutexLock lock(mutex);
+	MutexLock lock(_get_table_mutex(idx));
 	_data = _table[idx];
 
 	while (_data) {
@@ -387,7 +387,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 	const uint32_t hash = p_name.hash();
 	const uint32_t idx = hash & STRING_TABLE_MASK;
 
-	MutexLock lock(mutex);
+	MutexLock lock(_get_table_mutex(idx));
 	_data = _table[idx];
 
 	while (_data) {
@@ -444,7 +444,7 @@ StringName StringName::search(const char *p_name) {
 	const uint32_t hash = String::hash(p_name);
 	const uint32_t idx = hash & STRING_TABLE_MASK;
 
-	MutexLock lock(mutex);
+	MutexLock lock(_get_table_mutex(idx));
 	_Data *_data = _table[idx];
 
 	while (_data) {
@@ -479,7 +479,7 @@ StringName StringName::search(const char32_t *p_name) {
 	const uint32_t hash = String::hash(p_name);
 	const uint32_t idx = hash & STRING_TABLE_MASK;
 
-	MutexLock lock(mutex);
+	MutexLock lock(_get_table_mutex(idx));
 	_Data *_data = _table[idx];
 
 	while (_data) {
@@ -503,7 +503,7 @@ StringName StringName::search(const String &p_name) {
 	const uint32_t hash = p_name.hash();
 	const uint32_t idx = hash & STRING_TABLE_MASK;
 
-	MutexLock lock(mutex);
+	MutexLock lock(_get_table_mutex(idx));
 	_Data *_data = _table[idx];
 
 	while (_data) {
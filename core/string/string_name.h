@@ -47,7 +47,11 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		// Buckets are split into shards with their own lock, so threads interning different names rarely contend.
+		STRING_TABLE_SHARD_BITS = 6,
+		STRING_TABLE_SHARD_COUNT = 1 << STRING_TABLE_SHARD_BITS,
+		STRING_TABLE_SHARD_MASK = STRING_TABLE_SHARD_COUNT - 1,
 	};
 
 	struct _Data {
@@ -80,6 +84,13 @@ class StringName {
 	friend void unregister_core_types();
 	friend class Main;
 	static inline Mutex mutex;
+
+	// Recursive like `mutex`, since error reporting while holding it may create names.
+	struct alignas(64) TableShard {
+		Mutex mutex;
+	};
+	static inline TableShard table_shards[STRING_TABLE_SHARD_COUNT];
+	_FORCE_INLINE_ static Mutex &_get_table_mutex(uint32_t p_idx) { return table_shards[p_idx & STRING_TABLE_SHARD_MASK].mutex; }
 	static void setup();
 	static void cleanup();
 	static uint32_t get_empty_hash();
@@ -0,0 +1,258 @@
+/**************************************************************************/
+/*  frame_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/error/error_macros.h"
+#include "core/os/frame_arena.h"
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <type_traits>
+
+// HashMap-like container whose storage comes from the FrameArena of the calling
+// thread. Contents are discarded once that thread ends its frame, see FrameLocalVector.
+//
+// Elements are stored densely in insertion order (erasing moves the last one into
+// the gap) and looked up through a linearly probed index table.
+// Keys and values must be trivially destructible.
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class FrameHashMap {
+	static_assert(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>, "FrameHashMap can only hold trivially destructible types.");
+
+public:
+	static constexpr uint32_t MIN_CAPACITY = 16;
+	static constexpr uint32_t EMPTY_HASH = 0;
+
+private:
+	typedef KeyValue<TKey, TValue> Element;
+
+	uint32_t *hashes = nullptr;
+	uint32_t *indices = nullptr;
+	Element *elements = nullptr;
+	uint32_t capacity = 0; // Power of two.
+	uint32_t num_elements = 0;
+	FrameArena::Frame frame;
+
+	_FORCE_INLINE_ void _check_frame() {
+		if (unlikely(!FrameArena::is_current(frame))) {
+			hashes = nullptr;
+			indices = nullptr;
+			elements = nullptr;
+			capacity = 0;
+			num_elements = 0;
+			frame = FrameArena::get_frame();
+		}
+	}
+
+	_FORCE_INLINE_ bool _is_current() const { return FrameArena::is_current(frame); }
+
+	static _FORCE_INLINE_ uint32_t _get_max_elements(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 4;
+	}
+
+	_FORCE_INLINE_ static uint32_t _hash(const TKey &p_key) {
+		uint32_t hash = Hasher::hash(p_key);
+		if (unlikely(hash == EMPTY_HASH)) {
+			hash = EMPTY_HASH + 1;
+		}
+		return hash;
+	}
+
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (num_elements == 0 || !_is_current()) {
+			return false;
+		}
+
+		const uint32_t mask = capacity - 1;
+		const uint32_t hash = _hash(p_key);
+		uint32_t pos = hash & mask;
+		while (hashes[pos] != EMPTY_HASH) {
+			if (hashes[pos] == hash && Comparator::compare(elements[indices[pos]].key, p_key)) {
+				r_pos = pos;
+				return true;
+			}
+			pos = (pos + 1) & mask;
+		}
+		return false;
+	}
+
+	_FORCE_INLINE_ void _insert_index(uint32_t p_hash, uint32_t p_index) {
+		const uint32_t mask = capacity - 1;
+		uint32_t pos = p_hash & mask;
+		while (hashes[pos] != EMPTY_HASH) {
+			pos = (pos + 1) & mask;
+		}
+		hashes[pos] = p_hash;
+		indices[pos] = p_index;
+	}
+
+	void _resize(uint32_t p_capacity) {
+		uint32_t *old_hashes = hashes;
+		uint32_t *old_indices = indices;
+		uint32_t old_capacity = capacity;
+
+		elements = (Element *)FrameArena::realloc(elements, sizeof(Element) * _get_max_elements(old_capacity), sizeof(Element) * _get_max_elements(p_capacity), alignof(Element) > FrameArena::DEFAULT_ALIGNMENT ? alignof(Element) : FrameArena::DEFAULT_ALIGNMENT);
+		hashes = FrameArena::alloc_array<uint32_t>(p_capacity);
+		indices = FrameArena::alloc_array<uint32_t>(p_capacity);
+		CRASH_COND_MSG(!elements || !hashes || !indices, "Out of memory");
+		memset(hashes, 0, sizeof(uint32_t) * p_capacity);
+		capacity = p_capacity;
+		// The storage may have moved to the arena of the calling thread.
+		frame = FrameArena::get_frame();
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (old_hashes[i] != EMPTY_HASH) {
+				_insert_index(old_hashes[i], old_indices[i]);
+			}
+		}
+	}
+
+	_FORCE_INLINE_ void _remove_pos(uint32_t p_pos) {
+		// Backward shift deletion, so lookups don't need tombstones.
+		const uint32_t mask = capacity - 1;
+		uint32_t hole = p_pos;
+		uint32_t next = (p_pos + 1) & mask;
+		while (hashes[next] != EMPTY_HASH) {
+			uint32_t home = hashes[next] & mask;
+			if (((next - home) & mask) >= ((next - hole) & mask)) {
+				hashes[hole] = hashes[next];
+				indices[hole] = indices[next];
+				hole = next;
+			}
+			next = (next + 1) & mask;
+		}
+		hashes[hole] = EMPTY_HASH;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t size() const { return _is_current() ? num_elements : 0; }
+	_FORCE_INLINE_ bool is_empty() const { return size() == 0; }
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		return _lookup_pos(p_key, pos) ? &elements[indices[pos]].value : nullptr;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		return _lookup_pos(p_key, pos) ? &elements[indices[pos]].value : nullptr;
+	}
+
+	bool has(const TKey &p_key) const {
+		uint32_t pos = 0;
+		return _lookup_pos(p_key, pos);
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		const TValue *value = getptr(p_key);
+		CRASH_COND_MSG(!value, "FrameHashMap key not found.");
+		return *value;
+	}
+
+	TValue &insert(const TKey &p_key, const TValue &p_value) {
+		_check_frame();
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			TValue &value = elements[indices[pos]].value;
+			value = p_value;
+			return value;
+		}
+
+		if (num_elements + 1 > _get_max_elements(capacity)) {
+			_resize(capacity ? capacity * 2 : MIN_CAPACITY);
+		}
+		memnew_placement(&elements[num_elements], Element(p_key, p_value));
+		_insert_index(_hash(p_key), num_elements);
+		return elements[num_elements++].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		TValue *value = getptr(p_key);
+		if (value) {
+			return *value;
+		}
+		return insert(p_key, TValue());
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return false;
+		}
+
+		const uint32_t index = indices[pos];
+		_remove_pos(pos);
+		num_elements--;
+
+		if (index != num_elements) {
+			// Move the last element into the gap and point its slot to the new place.
+			uint32_t last_pos = 0;
+			_lookup_pos(elements[num_elements].key, last_pos);
+			memnew_placement(&elements[index], Element(elements[num_elements]));
+			indices[last_pos] = index;
+		}
+		return true;
+	}
+
+	void reserve(uint32_t p_new_capacity) {
+		_check_frame();
+		uint32_t new_capacity = MAX(capacity, MIN_CAPACITY);
+		while (_get_max_elements(new_capacity) < p_new_capacity) {
+			new_capacity *= 2;
+		}
+		if (new_capacity != capacity) {
+			_resize(new_capacity);
+		}
+	}
+
+	// Keeps the storage for this frame.
+	void clear() {
+		_check_frame();
+		if (num_elements) {
+			memset(hashes, 0, sizeof(uint32_t) * capacity);
+			num_elements = 0;
+		}
+	}
+
+	// Iteration is in insertion order, unless elements were erased.
+	_FORCE_INLINE_ Element *begin() { return _is_current() ? elements : nullptr; }
+	_FORCE_INLINE_ Element *end() { return _is_current() ? elements + num_elements : nullptr; }
+	_FORCE_INLINE_ const Element *begin() const { return _is_current() ? elements : nullptr; }
+	_FORCE_INLINE_ const Element *end() const { return _is_current() ? elements + num_elements : nullptr; }
+
+	FrameHashMap() = default;
+	// Copying would make two maps share (and grow over) the same storage.
+	FrameHashMap(const FrameHashMap &) = delete;
+	FrameHashMap &operator=(const FrameHashMap &) = delete;
+};
@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  frame_local_vector.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/error/error_macros.h"
+#include "core/os/frame_arena.h"
+#include "core/os/memory.h"
+#include "core/templates/sort_array.h"
+#include "core/templates/span.h"
+
+#include <type_traits>
+
+// LocalVector-like container whose storage comes from the FrameArena of the
+// calling thread. Contents are discarded once that thread ends its frame, so it
+// can be kept as a member and refilled every frame without touching the system
+// allocator. Other threads can read it until then.
+// Elements are never destructed, only trivially destructible types are allowed.
+template <typename T, typename U = uint32_t>
+class FrameLocalVector {
+	static_assert(std::is_trivially_destructible_v<T>, "FrameLocalVector can only hold trivially destructible types.");
+
+	U count = 0;
+	U capacity = 0;
+	T *data = nullptr;
+	FrameArena::Frame frame;
+
+	_FORCE_INLINE_ void _check_frame() {
+		if (unlikely(!FrameArena::is_current(frame))) {
+			// Storage was from an ended frame, it's not ours anymore.
+			data = nullptr;
+			count = 0;
+			capacity = 0;
+			frame = FrameArena::get_frame();
+		}
+	}
+
+	void _grow(U p_capacity) {
+		data = (T *)FrameArena::realloc(data, capacity * sizeof(T), p_capacity * sizeof(T), alignof(T) > FrameArena::DEFAULT_ALIGNMENT ? alignof(T) : FrameArena::DEFAULT_ALIGNMENT);
+		CRASH_COND_MSG(!data, "Out of memory");
+		capacity = p_capacity;
+		// The storage may have moved to the arena of the calling thread.
+		frame = FrameArena::get_frame();
+	}
+
+public:
+	_FORCE_INLINE_ T *ptr() {
+		_check_frame();
+		return data;
+	}
+	_FORCE_INLINE_ const T *ptr() const { return FrameArena::is_current(frame) ? data : nullptr; }
+	_FORCE_INLINE_ U size() const { return FrameArena::is_current(frame) ? count : 0; }
+	_FORCE_INLINE_ bool is_empty() const { return size() == 0; }
+
+	_FORCE_INLINE_ Span<T> span() const { return Span(ptr(), size()); }
+	_FORCE_INLINE_ operator Span<T>() const { return span(); }
+
+	_FORCE_INLINE_ void push_back(T p_elem) {
+		_check_frame();
+		if (unlikely(count == capacity)) {
+			_grow(MAX((U)8, capacity << 1));
+		}
+		memnew_placement(&data[count++], T(std::move(p_elem)));
+	}
+
+	void remove_at_unordered(U p_index) {
+		ERR_FAIL_INDEX(p_index, size());
+		count--;
+		if (count > p_index) {
+			data[p_index] = std::move(data[count]);
+		}
+	}
+
+	bool erase_unordered(const T &p_val) {
+		int64_t idx = find(p_val);
+		if (idx >= 0) {
+			remove_at_unordered(idx);
+			return true;
+		}
+		return false;
+	}
+
+	void reserve(U p_size) {
+		_check_frame();
+		if (p_size > capacity) {
+			_grow(p_size);
+		}
+	}
+
+	void resize(U p_size) {
+		_check_frame();
+		if (p_size > capacity) {
+			_grow(MAX(p_size, capacity << 1));
+		}
+		for (U i = count; i < p_size; i++) {
+			memnew_placement(&data[i], T);
+		}
+		count = p_size;
+	}
+
+	// Keeps the storage for this frame.
+	_FORCE_INLINE_ void clear() {
+		_check_frame();
+		count = 0;
+	}
+
+	// Gives the storage back to the arena, which can reuse it if nothing was allocated after it.
+	void reset() {
+		_check_frame();
+		FrameArena::free(data);
+		data = nullptr;
+		count = 0;
+		capacity = 0;
+	}
+
+	int64_t find(const T &p_val, int64_t p_from = 0) const {
+		const T *elements = ptr();
+		for (int64_t i = p_from; i < (int64_t)size(); i++) {
+			if (elements[i] == p_val) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	bool has(const T &p_val) const {
+		return find(p_val) != -1;
+	}
+
+	template <typename C>
+	void sort_custom() {
+		U len = size();
+		if (len == 0) {
+			return;
+		}
+		SortArray<T, C> sorter;
+		sorter.sort(data, len);
+	}
+
+	void sort() {
+		sort_custom<Comparator<T>>();
+	}
+
+	_FORCE_INLINE_ const T &operator[](U p_index) const {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, size());
+		return data[p_index];
+	}
+	_FORCE_INLINE_ T &operator[](U p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, size());
+		return data[p_index];
+	}
+
+	_FORCE_INLINE_ T *begin() { return ptr(); }
+	_FORCE_INLINE_ T *end() {
+		T *p = ptr();
+		return p + count;
+	}
+	_FORCE_INLINE_ const T *begin() const { return ptr(); }
+	_FORCE_INLINE_ const T *end() const { return ptr() + size(); }
+
+	FrameLocalVector() = default;
+	// Copying would make two vectors share (and grow over) the same storage.
+	FrameLocalVector(const FrameLocalVector &) = delete;
+	FrameLocalVector &operator=(const FrameLocalVector &) = delete;
+};
@@ -0,0 +1,223 @@
+/**************************************************************************/
+/*  perfect_hash_map.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "core/templates/sort_array.h"
+
+// Read-only hash map built once from a fixed set of keys, where every key
+// is found with a single probe (perfect hashing with hash and displace).
+//
+// Keys are spread over small buckets by their hash. Each bucket stores a seed,
+// picked at build time so that all its keys land on free slots. A lookup is
+// one seed read, one slot read and one key comparison.
+//
+// Building fails (and build() returns false) if two keys share the same
+// 32-bit hash, since no seed can tell them apart.
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class PerfectHashMap {
+	static constexpr uint32_t MAX_SEED_TRIES = 1 << 16;
+
+	struct Slot {
+		TKey key;
+		TValue value;
+		uint32_t hash = 0;
+		bool used = false;
+	};
+
+	LocalVector<uint32_t> seeds;
+	LocalVector<Slot> slots;
+	uint32_t bucket_mask = 0;
+	uint32_t slot_mask = 0;
+	uint32_t num_elements = 0;
+
+	static _FORCE_INLINE_ uint32_t _get_slot(uint32_t p_hash, uint32_t p_seed) {
+		return hash_fmix32(p_hash ^ (p_seed * 0x9E3779B9u));
+	}
+
+	struct BucketSort {
+		const uint32_t *sizes = nullptr;
+		bool operator()(uint32_t p_left, uint32_t p_right) const {
+			return sizes[p_left] > sizes[p_right];
+		}
+	};
+
+	bool _try_build(const LocalVector<Pair<TKey, TValue>> &p_entries, const LocalVector<uint32_t> &p_hashes, uint32_t p_slot_count) {
+		const uint32_t count = p_entries.size();
+		const uint32_t bucket_count = next_power_of_2(count / 2 + 1);
+		bucket_mask = bucket_count - 1;
+		slot_mask = p_slot_count - 1;
+
+		// Group the entries by bucket, biggest buckets are placed first while most slots are free.
+		LocalVector<uint32_t> bucket_sizes;
+		bucket_sizes.resize(bucket_count);
+		memset(bucket_sizes.ptr(), 0, sizeof(uint32_t) * bucket_count);
+		for (uint32_t i = 0; i < count; i++) {
+			bucket_sizes[p_hashes[i] & bucket_mask]++;
+		}
+		LocalVector<uint32_t> bucket_start;
+		bucket_start.resize(bucket_count + 1);
+		bucket_start[0] = 0;
+		for (uint32_t i = 0; i < bucket_count; i++) {
+			bucket_start[i + 1] = bucket_start[i] + bucket_sizes[i];
+		}
+		LocalVector<uint32_t> bucket_entries;
+		bucket_entries.resize(count);
+		LocalVector<uint32_t> fill = bucket_start;
+		for (uint32_t i = 0; i < count; i++) {
+			bucket_entries[fill[p_hashes[i] & bucket_mask]++] = i;
+		}
+		LocalVector<uint32_t> bucket_order;
+		bucket_order.resize(bucket_count);
+		for (uint32_t i = 0; i < bucket_count; i++) {
+			bucket_order[i] = i;
+		}
+		SortArray<uint32_t, BucketSort> sorter;
+		sorter.compare.sizes = bucket_sizes.ptr();
+		sorter.sort(bucket_order.ptr(), bucket_count);
+
+		seeds.resize(bucket_count);
+		memset(seeds.ptr(), 0, sizeof(uint32_t) * bucket_count);
+		LocalVector<bool> taken;
+		taken.resize(p_slot_count);
+		memset(taken.ptr(), 0, sizeof(bool) * p_slot_count);
+		LocalVector<uint32_t> placed;
+
+		for (uint32_t bucket : bucket_order) {
+			const uint32_t from = bucket_start[bucket];
+			const uint32_t to = bucket_start[bucket + 1];
+			if (from == to) {
+				break; // Sorted by size, the rest are empty too.
+			}
+
+			bool found = false;
+			for (uint32_t seed = 0; seed < MAX_SEED_TRIES && !found; seed++) {
+				placed.clear();
+				found = true;
+				for (uint32_t i = from; i < to; i++) {
+					const uint32_t slot = _get_slot(p_hashes[bucket_entries[i]], seed) & slot_mask;
+					if (taken[slot] || placed.has(slot)) {
+						found = false;
+						break;
+					}
+					placed.push_back(slot);
+				}
+				if (found) {
+					seeds[bucket] = seed;
+					for (uint32_t slot : placed) {
+						taken[slot] = true;
+					}
+				}
+			}
+			if (!found) {
+				return false;
+			}
+		}
+
+		slots.clear();
+		slots.resize(p_slot_count);
+		for (uint32_t i = 0; i < count; i++) {
+			const uint32_t hash = p_hashes[i];
+			Slot &slot = slots[_get_slot(hash, seeds[hash & bucket_mask]) & slot_mask];
+			slot.key = p_entries[i].first;
+			slot.value = p_entries[i].second;
+			slot.hash = hash;
+			slot.used = true;
+		}
+		num_elements = count;
+		return true;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+	_FORCE_INLINE_ bool is_empty() const { return num_elements == 0; }
+
+	_FORCE_INLINE_ const TValue *getptr(const TKey &p_key) const {
+		if (unlikely(num_elements == 0)) {
+			return nullptr;
+		}
+		const uint32_t hash = Hasher::hash(p_key);
+		const Slot &slot = slots[_get_slot(hash, seeds[hash & bucket_mask]) & slot_mask];
+		if (slot.used && slot.hash == hash && Comparator::compare(slot.key, p_key)) {
+			return &slot.value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		return getptr(p_key) != nullptr;
+	}
+
+	void clear() {
+		seeds.reset();
+		slots.reset();
+		bucket_mask = 0;
+		slot_mask = 0;
+		num_elements = 0;
+	}
+
+	// Keys must be unique. Returns false, leaving the map empty, if no perfect hash could be found.
+	bool build(const LocalVector<Pair<TKey, TValue>> &p_entries) {
+		clear();
+		const uint32_t count = p_entries.size();
+		if (count == 0) {
+			return true;
+		}
+
+		LocalVector<uint32_t> hashes;
+		hashes.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			hashes[i] = Hasher::hash(p_entries[i].first);
+		}
+
+		LocalVector<uint32_t> sorted_hashes = hashes;
+		sorted_hashes.sort();
+		for (uint32_t i = 1; i < count; i++) {
+			if (sorted_hashes[i] == sorted_hashes[i - 1]) {
+				return false;
+			}
+		}
+
+		// Some slack keeps seeds quick to find, growing the table if that's still not enough.
+		for (uint32_t slot_count = next_power_of_2(count + count / 8 + 1); slot_count <= (next_power_of_2(count) << 3); slot_count <<= 1) {
+			if (_try_build(p_entries, hashes, slot_count)) {
+				return true;
+			}
+		}
+
+		clear();
+		return false;
+	}
+};
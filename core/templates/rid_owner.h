@@ -34,26 +34,13 @@
 #include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 
 #include <stdio.h>
 #include <typeinfo> // IWYU pragma: keep // Used in macro.
 
-#ifdef SANITIZERS_ENABLED
-#ifdef __has_feature
-#if __has_feature(thread_sanitizer)
-#define TSAN_ENABLED
-#endif
-#elif defined(__SANITIZE_THREAD__)
-#define TSAN_ENABLED
-#endif
-#endif
-
-#ifdef TSAN_ENABLED
-#include <sanitizer/tsan_interface.h>
-#endif
-
 // The following macros would need to be implemented somehow
 // for purely weakly ordered architectures. There's a test case
 // ("[RID_Owner] Thread safety") with potential to catch issues
@@ -76,6 +63,8 @@
 
 class RID_AllocBase {
 	static SafeNumeric<uint64_t> base_id;
+	static SafeNumeric<uint32_t> thread_slot_count;
+	static thread_local uint32_t thread_slot;
 
 protected:
 	static RID _make_from_id(uint64_t p_id) {
@@ -94,6 +83,14 @@ protected:
 		return base_id.increment();
 	}
 
+	// Small number unique to the calling thread, used to spread threads over free list shards.
+	_FORCE_INLINE_ static uint32_t _get_thread_slot() {
+		if (unlikely(thread_slot == UINT32_MAX)) {
+			thread_slot = thread_slot_count.postincrement();
+		}
+		return thread_slot;
+	}
+
 public:
 	virtual ~RID_AllocBase() {}
 };
@@ -107,6 +104,19 @@ class RID_Alloc : public RID_AllocBase {
 	Chunk **chunks = nullptr;
 	uint32_t **free_list_chunks = nullptr;
 
+	// Thread-safe allocators keep their free elements in shards instead, each used by
+	// a subset of the threads, so threads making and freeing RIDs concurrently rarely
+	// contend on the same lock. Lookups never lock; they rely on the validators, which
+	// are then only accessed atomically.
+	static constexpr uint32_t FREE_LIST_SHARDS = 8;
+	static constexpr uint32_t FREE_LIST_STEAL_MAX = 64;
+	struct FreeListShard {
+		BinaryMutex mutex;
+		LocalVector<uint32_t> indices;
+		uint8_t padding[64]; // Keeps the locks of neighboring shards apart.
+	};
+	FreeListShard *free_list_shards = nullptr;
+
 	uint32_t elements_in_chunk;
 	uint32_t max_alloc = 0;
 	uint32_t alloc_count = 0;
@@ -116,50 +126,166 @@ class RID_Alloc : public RID_AllocBase {
 
 	mutable Mutex mutex;
 
-	_FORCE_INLINE_ RID _allocate_rid() {
+	_FORCE_INLINE_ static std::atomic<uint32_t> &_atomic(uint32_t &p_value) {
+		return *(std::atomic<uint32_t> *)&p_value;
+	}
+
+	_FORCE_INLINE_ static const std::atomic<uint32_t> &_atomic(const uint32_t &p_value) {
+		return *(const std::atomic<uint32_t> *)&p_value;
+	}
+
+	_FORCE_INLINE_ uint32_t _load_max_alloc() const {
+		if constexpr (THREAD_SAFE) {
+			// Pairs with the store in _grow_shard(), so the new chunk is visible too.
+			return _atomic(max_alloc).load(std::memory_order_acquire);
+		} else {
+			return max_alloc;
+		}
+	}
+
+	_FORCE_INLINE_ static uint32_t _load_validator(const Chunk &p_chunk) {
 		if constexpr (THREAD_SAFE) {
+			// Pairs with the store in _publish_rid(), so the data is visible too.
+			return _atomic(p_chunk.validator).load(std::memory_order_acquire);
+		} else {
+			return p_chunk.validator;
+		}
+	}
+
+	// Adds a new chunk to the given shard. Must be called with the mutex held.
+	bool _grow_shard(FreeListShard &p_shard) {
+		uint32_t chunk_count = max_alloc / elements_in_chunk;
+		if (chunk_count == chunk_limit) {
+			return false;
+		}
+
+		chunks[chunk_count] = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); //but don't initialize
+		for (uint32_t i = 0; i < elements_in_chunk; i++) {
+			chunks[chunk_count][i].validator = 0xFFFFFFFF;
+		}
+
+		uint32_t first = max_alloc;
+		_atomic(max_alloc).store(max_alloc + elements_in_chunk, std::memory_order_release);
+
+		p_shard.mutex.lock();
+		for (uint32_t i = elements_in_chunk; i > 0; i--) {
+			p_shard.indices.push_back(first + i - 1); // Lowest indices are handed out first.
+		}
+		p_shard.mutex.unlock();
+		return true;
+	}
+
+	// Moves some free elements from other shards to the given one.
+	bool _steal_free_indices(uint32_t p_shard) {
+		uint32_t stolen[FREE_LIST_STEAL_MAX];
+		uint32_t stolen_count = 0;
+
+		for (uint32_t i = 1; i < FREE_LIST_SHARDS && stolen_count == 0; i++) {
+			FreeListShard &other = free_list_shards[(p_shard + i) % FREE_LIST_SHARDS];
+			other.mutex.lock();
+			uint32_t available = other.indices.size();
+			stolen_count = MIN(FREE_LIST_STEAL_MAX, (available + 1) / 2);
+			for (uint32_t j = 0; j < stolen_count; j++) {
+				stolen[j] = other.indices[available - stolen_count + j];
+			}
+			other.indices.resize(available - stolen_count);
+			other.mutex.unlock();
+		}
+
+		if (stolen_count == 0) {
+			return false;
+		}
+
+		FreeListShard &shard = free_list_shards[p_shard];
+		shard.mutex.lock();
+		for (uint32_t j = 0; j < stolen_count; j++) {
+			shard.indices.push_back(stolen[j]);
+		}
+		shard.mutex.unlock();
+		return true;
+	}
+
+	bool _pop_free_index(uint32_t &r_index) {
+		uint32_t shard_index = _get_thread_slot() % FREE_LIST_SHARDS;
+		FreeListShard &shard = free_list_shards[shard_index];
+
+		while (true) {
+			shard.mutex.lock();
+			if (!shard.indices.is_empty()) {
+				r_index = shard.indices[shard.indices.size() - 1];
+				shard.indices.resize(shard.indices.size() - 1);
+				shard.mutex.unlock();
+				return true;
+			}
+			shard.mutex.unlock();
+
+			if (_steal_free_indices(shard_index)) {
+				continue;
+			}
+
 			mutex.lock();
+			// Another thread using this shard may have grown it meanwhile.
+			shard.mutex.lock();
+			bool refilled = !shard.indices.is_empty();
+			shard.mutex.unlock();
+			bool grown = refilled || _grow_shard(shard);
+			mutex.unlock();
+
+			if (!grown) {
+				return false;
+			}
 		}
+	}
 
-		if (alloc_count == max_alloc) {
-			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
-			if (THREAD_SAFE && chunk_count == chunk_limit) {
-				mutex.unlock();
+	void _push_free_index(uint32_t p_index) {
+		FreeListShard &shard = free_list_shards[_get_thread_slot() % FREE_LIST_SHARDS];
+		shard.mutex.lock();
+		shard.indices.push_back(p_index);
+		shard.mutex.unlock();
+	}
+
+	// Marks an element as initialized, making its data visible to other threads looking it up.
+	void _publish_rid(const RID &p_rid) {
+		uint64_t id = p_rid.get_id();
+		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+		_atomic(chunks[idx / elements_in_chunk][idx % elements_in_chunk].validator).store(uint32_t(id >> 32), std::memory_order_release);
+	}
+
+	_FORCE_INLINE_ RID _allocate_rid() {
+		uint32_t free_index;
+
+		if constexpr (THREAD_SAFE) {
+			if (unlikely(!_pop_free_index(free_index))) {
 				if (description != nullptr) {
 					ERR_FAIL_V_MSG(RID(), vformat("Element limit for RID of type '%s' reached.", String(description)));
 				} else {
 					ERR_FAIL_V_MSG(RID(), "Element limit reached.");
 				}
 			}
+		} else {
+			if (alloc_count == max_alloc) {
+				//allocate a new chunk
+				uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
 
-			//grow chunks
-			if constexpr (!THREAD_SAFE) {
+				//grow chunks
 				chunks = (Chunk **)memrealloc(chunks, sizeof(Chunk *) * (chunk_count + 1));
-			}
-			chunks[chunk_count] = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); //but don't initialize
-			//grow free lists
-			if constexpr (!THREAD_SAFE) {
+				chunks[chunk_count] = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); //but don't initialize
+				//grow free lists
 				free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			}
-			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+				free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
 
-			//initialize
-			for (uint32_t i = 0; i < elements_in_chunk; i++) {
-				// Don't initialize chunk.
-				chunks[chunk_count][i].validator = 0xFFFFFFFF;
-				free_list_chunks[chunk_count][i] = alloc_count + i;
-			}
+				//initialize
+				for (uint32_t i = 0; i < elements_in_chunk; i++) {
+					// Don't initialize chunk.
+					chunks[chunk_count][i].validator = 0xFFFFFFFF;
+					free_list_chunks[chunk_count][i] = alloc_count + i;
+				}
 
-			if constexpr (THREAD_SAFE) {
-				// Store atomically to avoid data race with the load in get_or_null().
-				((std::atomic<uint32_t> *)&max_alloc)->store(max_alloc + elements_in_chunk, std::memory_order_relaxed);
-			} else {
 				max_alloc += elements_in_chunk;
 			}
-		}
 
-		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+			free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+		}
 
 		uint32_t free_chunk = free_index / elements_in_chunk;
 		uint32_t free_element = free_index % elements_in_chunk;
@@ -170,13 +296,14 @@ class RID_Alloc : public RID_AllocBase {
 		id <<= 32;
 		id |= free_index;
 
-		chunks[free_chunk][free_element].validator = validator;
-		chunks[free_chunk][free_element].validator |= 0x80000000; //mark uninitialized bit
-
-		alloc_count++;
-
 		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
+			_atomic(chunks[free_chunk][free_element].validator).store(validator | 0x80000000, std::memory_order_relaxed); //mark uninitialized bit
+			_atomic(alloc_count).fetch_add(1, std::memory_order_relaxed);
+		} else {
+			chunks[free_chunk][free_element].validator = validator;
+			chunks[free_chunk][free_element].validator |= 0x80000000; //mark uninitialized bit
+
+			alloc_count++;
 		}
 
 		return _make_from_id(id);
@@ -204,19 +331,9 @@ public:
 			return nullptr;
 		}
 
-		if constexpr (THREAD_SAFE) {
-			SYNC_ACQUIRE;
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		uint32_t ma;
-		if constexpr (THREAD_SAFE) { // Read atomically to avoid data race with the store in _allocate_rid().
-			ma = ((std::atomic<uint32_t> *)&max_alloc)->load(std::memory_order_relaxed);
-		} else {
-			ma = max_alloc;
-		}
-		if (unlikely(idx >= ma)) {
+		if (unlikely(idx >= _load_max_alloc())) {
 			return nullptr;
 		}
 
@@ -225,47 +342,30 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_acquire(&chunks[idx_chunk]); // We know not a race in practice.
-			__tsan_acquire(&chunks[idx_chunk][idx_element]); // We know not a race in practice.
-#endif
-		}
-
 		Chunk &c = chunks[idx_chunk][idx_element];
-
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_release(&chunks[idx_chunk]);
-			__tsan_release(&chunks[idx_chunk][idx_element]);
-			__tsan_acquire(&c.validator); // We know not a race in practice.
-#endif
-		}
+		uint32_t current = _load_validator(c);
 
 		if (unlikely(p_initialize)) {
-			if (unlikely(!(c.validator & 0x80000000))) {
+			if (unlikely(!(current & 0x80000000))) {
 				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
 			}
 
-			if (unlikely((c.validator & 0x7FFFFFFF) != validator)) {
+			if (unlikely((current & 0x7FFFFFFF) != validator)) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
 			}
 
-			c.validator &= 0x7FFFFFFF; //initialized
+			// Thread-safe allocators only mark the element initialized once its data is constructed.
+			if constexpr (!THREAD_SAFE) {
+				c.validator &= 0x7FFFFFFF; //initialized
+			}
 
-		} else if (unlikely(c.validator != validator)) {
-			if ((c.validator & 0x80000000) && c.validator != 0xFFFFFFFF) {
+		} else if (unlikely(current != validator)) {
+			if ((current & 0x80000000) && current != 0xFFFFFFFF) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
 			}
 			return nullptr;
 		}
 
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_release(&c.validator);
-#endif
-		}
-
 		T *ptr = &c.data;
 
 		return ptr;
@@ -274,19 +374,10 @@ public:
 		T *mem = get_or_null(p_rid, true);
 		ERR_FAIL_NULL(mem);
 
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_acquire(mem); // We know not a race in practice.
-#endif
-		}
-
 		memnew_placement(mem, T);
 
 		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_release(mem);
-#endif
-			SYNC_RELEASE;
+			_publish_rid(p_rid);
 		}
 	}
 
@@ -294,33 +385,17 @@ public:
 		T *mem = get_or_null(p_rid, true);
 		ERR_FAIL_NULL(mem);
 
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_acquire(mem); // We know not a race in practice.
-#endif
-		}
-
 		memnew_placement(mem, T(p_value));
 
 		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_release(mem);
-#endif
-			SYNC_RELEASE;
+			_publish_rid(p_rid);
 		}
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		if (unlikely(idx >= _load_max_alloc())) {
 			return false;
 		}
 
@@ -329,26 +404,13 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (validator != 0x7FFFFFFF) && (chunks[idx_chunk][idx_element].validator & 0x7FFFFFFF) == validator;
-
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
-		}
-
-		return owned;
+		return (validator != 0x7FFFFFFF) && (_load_validator(chunks[idx_chunk][idx_element]) & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		if (unlikely(idx >= _load_max_alloc())) {
 			ERR_FAIL();
 		}
 
@@ -356,38 +418,49 @@ public:
 		uint32_t idx_element = idx % elements_in_chunk;
 
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(chunks[idx_chunk][idx_element].validator & 0x80000000)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
-			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
-		} else if (unlikely(chunks[idx_chunk][idx_element].validator != validator)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
+
+		if constexpr (THREAD_SAFE) {
+			// Invalidate first, so concurrent frees of the same RID can't both destroy it.
+			uint32_t current = validator;
+			if (unlikely(!_atomic(chunks[idx_chunk][idx_element].validator).compare_exchange_strong(current, 0xFFFFFFFF, std::memory_order_acquire))) {
+				if (current & 0x80000000) {
+					ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
+				}
+				ERR_FAIL();
 			}
-			ERR_FAIL();
-		}
 
-		chunks[idx_chunk][idx_element].data.~T();
-		chunks[idx_chunk][idx_element].validator = 0xFFFFFFFF; // go invalid
+			chunks[idx_chunk][idx_element].data.~T();
 
-		alloc_count--;
-		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
+			_push_free_index(idx);
+			_atomic(alloc_count).fetch_sub(1, std::memory_order_relaxed);
+		} else {
+			if (unlikely(chunks[idx_chunk][idx_element].validator & 0x80000000)) {
+				ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
+			} else if (unlikely(chunks[idx_chunk][idx_element].validator != validator)) {
+				ERR_FAIL();
+			}
 
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
+			chunks[idx_chunk][idx_element].data.~T();
+			chunks[idx_chunk][idx_element].validator = 0xFFFFFFFF; // go invalid
+
+			alloc_count--;
+			free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
 		}
 	}
 
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
-		return alloc_count;
+		if constexpr (THREAD_SAFE) {
+			return _atomic(alloc_count).load(std::memory_order_relaxed);
+		} else {
+			return alloc_count;
+		}
 	}
 	void get_owned_list(List<RID> *p_owned) const {
 		if constexpr (THREAD_SAFE) {
 			mutex.lock();
 		}
 		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+			uint64_t validator = _load_validator(chunks[i / elements_in_chunk][i % elements_in_chunk]);
 			if (validator != 0xFFFFFFFF) {
 				p_owned->push_back(_make_from_id((validator << 32) | i));
 			}
@@ -404,7 +477,7 @@ public:
 		}
 		uint32_t idx = 0;
 		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+			uint64_t validator = _load_validator(chunks[i / elements_in_chunk][i % elements_in_chunk]);
 			if (validator != 0xFFFFFFFF) {
 				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
 				idx++;
@@ -425,7 +498,7 @@ public:
 		if constexpr (THREAD_SAFE) {
 			chunk_limit = (p_maximum_number_of_elements / elements_in_chunk) + 1;
 			chunks = (Chunk **)memalloc(sizeof(Chunk *) * chunk_limit);
-			free_list_chunks = (uint32_t **)memalloc(sizeof(uint32_t *) * chunk_limit);
+			free_list_shards = memnew_arr(FreeListShard, FREE_LIST_SHARDS);
 			SYNC_RELEASE;
 		}
 	}
@@ -453,13 +526,20 @@ public:
 		uint32_t chunk_count = max_alloc / elements_in_chunk;
 		for (uint32_t i = 0; i < chunk_count; i++) {
 			memfree(chunks[i]);
-			memfree(free_list_chunks[i]);
+			if constexpr (!THREAD_SAFE) {
+				memfree(free_list_chunks[i]);
+			}
 		}
 
 		if (chunks) {
 			memfree(chunks);
+		}
+		if (free_list_chunks) {
 			memfree(free_list_chunks);
 		}
+		if (free_list_shards) {
+			memdelete_arr(free_list_shards);
+		}
 	}
 };
 
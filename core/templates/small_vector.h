@@ -0,0 +1,268 @@
+/**************************************************************************/
+/*  small_vector.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+/**
+ * @class SmallVector
+ * Vector keeping up to N elements inside the object, so small arrays cost no allocation.
+ *
+ * Larger contents are kept in a copy-on-write Vector, so copies of those share them and
+ * only copy when written to, like with Vector. Inline elements are copied right away,
+ * which is cheap since there are only a few.
+ */
+
+#include "core/templates/vector.h"
+
+template <typename T, uint32_t N>
+class SmallVector;
+
+template <typename T, uint32_t N>
+class SmallVectorWriteProxy {
+public:
+	_FORCE_INLINE_ T &operator[](int64_t p_index) {
+		CRASH_BAD_INDEX(p_index, ((SmallVector<T, N> *)(this))->size());
+
+		return ((SmallVector<T, N> *)(this))->ptrw()[p_index];
+	}
+};
+
+template <typename T, uint32_t N>
+class SmallVector {
+	friend class SmallVectorWriteProxy<T, N>;
+	static_assert(N > 0, "SmallVector needs room for at least one inline element.");
+
+public:
+	SmallVectorWriteProxy<T, N> write;
+	typedef typename Vector<T>::Size Size;
+
+private:
+	uint32_t inline_size = 0;
+	alignas(T) uint8_t inline_data[sizeof(T) * N];
+	Vector<T> heap; // Only used when there are more than N elements.
+
+	_FORCE_INLINE_ T *_inline_ptr() { return reinterpret_cast<T *>(inline_data); }
+	_FORCE_INLINE_ const T *_inline_ptr() const { return reinterpret_cast<const T *>(inline_data); }
+
+	void _destroy_inline(uint32_t p_from) {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			for (uint32_t i = p_from; i < inline_size; i++) {
+				_inline_ptr()[i].~T();
+			}
+		}
+		inline_size = p_from;
+	}
+
+	void _copy_inline(const T *p_from, uint32_t p_size) {
+		for (uint32_t i = 0; i < p_size; i++) {
+			memnew_placement(&_inline_ptr()[i], T(p_from[i]));
+		}
+		inline_size = p_size;
+	}
+
+	// Moves the inline elements to the heap, before growing past N.
+	void _spill() {
+		heap.resize(inline_size);
+		T *w = heap.ptrw();
+		for (uint32_t i = 0; i < inline_size; i++) {
+			w[i] = std::move(_inline_ptr()[i]);
+		}
+		_destroy_inline(0);
+	}
+
+	// Moves the heap elements back inline, once they fit again.
+	void _unspill() {
+		Vector<T> from = heap;
+		heap.clear();
+		_copy_inline(from.ptr(), from.size());
+	}
+
+	void _copy_from(const SmallVector &p_from) {
+		if (p_from.heap.is_empty()) {
+			_copy_inline(p_from._inline_ptr(), p_from.inline_size);
+		} else {
+			heap = p_from.heap;
+		}
+	}
+
+	void _copy_from(const Vector<T> &p_from) {
+		if (p_from.size() <= Size(N)) {
+			_copy_inline(p_from.ptr(), p_from.size());
+		} else {
+			heap = p_from;
+		}
+	}
+
+public:
+	_FORCE_INLINE_ Size size() const { return heap.is_empty() ? Size(inline_size) : heap.size(); }
+	_FORCE_INLINE_ bool is_empty() const { return size() == 0; }
+	_FORCE_INLINE_ bool is_inline() const { return heap.is_empty(); }
+
+	_FORCE_INLINE_ const T *ptr() const { return heap.is_empty() ? _inline_ptr() : heap.ptr(); }
+	_FORCE_INLINE_ T *ptrw() { return heap.is_empty() ? _inline_ptr() : heap.ptrw(); }
+
+	_FORCE_INLINE_ const T &operator[](Size p_index) const {
+		CRASH_BAD_INDEX(p_index, size());
+		return ptr()[p_index];
+	}
+	_FORCE_INLINE_ const T &get(Size p_index) const { return operator[](p_index); }
+	_FORCE_INLINE_ void set(Size p_index, const T &p_elem) {
+		ERR_FAIL_INDEX(p_index, size());
+		ptrw()[p_index] = p_elem;
+	}
+
+	Error resize(Size p_size) {
+		ERR_FAIL_COND_V(p_size < 0, ERR_INVALID_PARAMETER);
+		if (p_size > Size(N)) {
+			if (heap.is_empty()) {
+				_spill();
+			}
+			return heap.resize(p_size);
+		}
+
+		if (!heap.is_empty()) {
+			heap.resize(p_size);
+			_unspill();
+			return OK;
+		}
+
+		if (uint32_t(p_size) < inline_size) {
+			_destroy_inline(p_size);
+		} else {
+			for (uint32_t i = inline_size; i < uint32_t(p_size); i++) {
+				memnew_placement(&_inline_ptr()[i], T);
+			}
+			inline_size = p_size;
+		}
+		return OK;
+	}
+
+	// Must take a copy instead of a reference (see GH-31736).
+	bool push_back(T p_elem) {
+		if (heap.is_empty()) {
+			if (inline_size < N) {
+				memnew_placement(&_inline_ptr()[inline_size], T(std::move(p_elem)));
+				inline_size++;
+				return false;
+			}
+			_spill();
+		}
+		return heap.push_back(std::move(p_elem));
+	}
+	_FORCE_INLINE_ bool append(const T &p_elem) { return push_back(p_elem); } //alias
+
+	void remove_at(Size p_index) {
+		ERR_FAIL_INDEX(p_index, size());
+		if (!heap.is_empty()) {
+			heap.remove_at(p_index);
+			if (heap.size() <= Size(N)) {
+				_unspill();
+			}
+			return;
+		}
+
+		T *data = _inline_ptr();
+		for (uint32_t i = p_index; i + 1 < inline_size; i++) {
+			data[i] = std::move(data[i + 1]);
+		}
+		_destroy_inline(inline_size - 1);
+	}
+
+	_FORCE_INLINE_ bool erase(const T &p_val) {
+		Size idx = find(p_val);
+		if (idx >= 0) {
+			remove_at(idx);
+			return true;
+		}
+		return false;
+	}
+
+	Size find(const T &p_val, Size p_from = 0) const {
+		const Size s = size();
+		const T *data = ptr();
+		for (Size i = MAX(p_from, Size(0)); i < s; i++) {
+			if (data[i] == p_val) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	_FORCE_INLINE_ bool has(const T &p_val) const { return find(p_val) != -1; }
+
+	void clear() {
+		_destroy_inline(0);
+		heap.clear();
+	}
+
+	Vector<T> to_vector() const {
+		if (!heap.is_empty()) {
+			return heap; // Shared until written to.
+		}
+		Vector<T> ret;
+		ret.resize(inline_size);
+		T *w = ret.ptrw();
+		for (uint32_t i = 0; i < inline_size; i++) {
+			w[i] = _inline_ptr()[i];
+		}
+		return ret;
+	}
+
+	_FORCE_INLINE_ T *begin() { return ptrw(); }
+	_FORCE_INLINE_ T *end() { return ptrw() + size(); }
+	_FORCE_INLINE_ const T *begin() const { return ptr(); }
+	_FORCE_INLINE_ const T *end() const { return ptr() + size(); }
+
+	void operator=(const SmallVector &p_from) {
+		if (this == &p_from) {
+			return;
+		}
+		clear();
+		_copy_from(p_from);
+	}
+
+	void operator=(const Vector<T> &p_from) {
+		clear();
+		_copy_from(p_from);
+	}
+
+	_FORCE_INLINE_ SmallVector() {}
+	SmallVector(std::initializer_list<T> p_init) {
+		for (const T &E : p_init) {
+			push_back(E);
+		}
+	}
+	SmallVector(const SmallVector &p_from) { _copy_from(p_from); }
+	SmallVector(const Vector<T> &p_from) { _copy_from(p_from); }
+
+	~SmallVector() {
+		_destroy_inline(0);
+	}
+};
@@ -0,0 +1,659 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/hash_map.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_HASH_GROUP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define SWISS_HASH_GROUP_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Control bytes of consecutive slots, compared all at once.
+// Matches are returned as a bit mask where slot i is bit (i << SHIFT).
+struct SwissHashGroup {
+	static constexpr uint8_t CTRL_EMPTY = 0x80;
+	static constexpr uint8_t CTRL_DELETED = 0xFE;
+	// Full slots store the 7 top bits of the hash, so their high bit is never set.
+
+#if defined(SWISS_HASH_GROUP_SSE2)
+	static constexpr uint32_t WIDTH = 16;
+	static constexpr uint32_t SHIFT = 0;
+
+	__m128i ctrl;
+
+	_FORCE_INLINE_ explicit SwissHashGroup(const uint8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+	}
+
+	_FORCE_INLINE_ uint64_t match(uint8_t p_h2) const {
+		return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)p_h2), ctrl));
+	}
+
+	_FORCE_INLINE_ uint64_t match_empty_or_deleted() const {
+		return (uint32_t)_mm_movemask_epi8(ctrl);
+	}
+#elif defined(SWISS_HASH_GROUP_NEON)
+	static constexpr uint32_t WIDTH = 8;
+	static constexpr uint32_t SHIFT = 3;
+
+	uint8x8_t ctrl;
+
+	_FORCE_INLINE_ explicit SwissHashGroup(const uint8_t *p_ctrl) {
+		ctrl = vld1_u8(p_ctrl);
+	}
+
+	_FORCE_INLINE_ uint64_t match(uint8_t p_h2) const {
+		return vget_lane_u64(vreinterpret_u64_u8(vceq_u8(ctrl, vdup_n_u8(p_h2))), 0) & 0x8080808080808080ull;
+	}
+
+	_FORCE_INLINE_ uint64_t match_empty_or_deleted() const {
+		return vget_lane_u64(vreinterpret_u64_u8(ctrl), 0) & 0x8080808080808080ull;
+	}
+#else
+	// Portable fallback, working on 8 bytes at a time in a 64-bit integer.
+	static constexpr uint32_t WIDTH = 8;
+	static constexpr uint32_t SHIFT = 3;
+
+	uint64_t ctrl;
+
+	_FORCE_INLINE_ explicit SwissHashGroup(const uint8_t *p_ctrl) {
+		memcpy(&ctrl, p_ctrl, sizeof(uint64_t));
+#ifdef BIG_ENDIAN_ENABLED
+		ctrl = BSWAP64(ctrl);
+#endif
+	}
+
+	// May report false positives on full slots next to a match, which get filtered out by comparing keys.
+	_FORCE_INLINE_ uint64_t match(uint8_t p_h2) const {
+		const uint64_t x = ctrl ^ (0x0101010101010101ull * p_h2);
+		return (x - 0x0101010101010101ull) & ~x & 0x8080808080808080ull;
+	}
+
+	_FORCE_INLINE_ uint64_t match_empty_or_deleted() const {
+		return ctrl & 0x8080808080808080ull;
+	}
+#endif
+
+	_FORCE_INLINE_ uint64_t match_empty() const {
+#if defined(SWISS_HASH_GROUP_SSE2) || defined(SWISS_HASH_GROUP_NEON)
+		return match(CTRL_EMPTY);
+#else
+		return ctrl & ~(ctrl << 6) & 0x8080808080808080ull;
+#endif
+	}
+
+	static _FORCE_INLINE_ uint32_t ctz64(uint64_t p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(p_value);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+		unsigned long index;
+		_BitScanForward64(&index, p_value);
+		return index;
+#else
+		uint32_t count = 0;
+		while (!(p_value & 1)) {
+			p_value >>= 1;
+			count++;
+		}
+		return count;
+#endif
+	}
+
+	static _FORCE_INLINE_ uint32_t clz64(uint64_t p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_clzll(p_value);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+		unsigned long index;
+		_BitScanReverse64(&index, p_value);
+		return 63 - index;
+#else
+		uint32_t count = 0;
+		while (!(p_value & (1ull << 63))) {
+			p_value <<= 1;
+			count++;
+		}
+		return count;
+#endif
+	}
+
+	// Offset of the first match in the group. The mask can't be zero.
+	static _FORCE_INLINE_ uint32_t first(uint64_t p_mask) {
+		return ctz64(p_mask) >> SHIFT;
+	}
+
+	// Slots after the last match in the group. The mask can't be zero.
+	static _FORCE_INLINE_ uint32_t after_last(uint64_t p_mask) {
+		return (clz64(p_mask) - (64 - (WIDTH << SHIFT))) >> SHIFT;
+	}
+};
+
+/**
+ * An open-addressing hash map in the style of SwissTable. Each slot has a control byte holding
+ * 7 bits of the hash of its element, and lookups compare a whole group of them at once with
+ * SSE2 or NEON, so only elements whose bits match have their keys compared. Most lookups, hits
+ * or misses, read a single group.
+ *
+ * Elements are stored in a separate array, in insertion order, which makes iterating them as fast
+ * as iterating a vector. When an element is erased, the last element takes its place, unless
+ * STABLE_ORDER is set: the place is then left free until the next rehash, so the insertion order
+ * is kept like with HashMap.
+ *
+ * Pointers to elements are invalidated when elements are added, or when erasing without
+ * STABLE_ORDER. Use HashMap if you need them to stay valid.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>,
+		bool STABLE_ORDER = false>
+class SwissHashMap {
+public:
+	// Must be a power of two, at least the group width.
+	static constexpr uint32_t MIN_CAPACITY = 16;
+	static constexpr uint32_t EMPTY_HASH = 0;
+
+private:
+	static_assert(MIN_CAPACITY >= SwissHashGroup::WIDTH);
+
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+
+	uint8_t *ctrl = nullptr; // One per slot, and a copy of the first group at the end, so groups can be read past the last slot.
+	uint32_t *slots = nullptr; // Element index of each full slot.
+	MapKeyValue *elements = nullptr;
+	uint32_t *hashes = nullptr; // Hash of each element, EMPTY_HASH for the free places left by STABLE_ORDER.
+
+	uint32_t capacity = MIN_CAPACITY; // In slots, always a power of two.
+	uint32_t num_elements = 0;
+	uint32_t num_used = 0; // Places used in the element array, including the free ones left by STABLE_ORDER.
+	uint32_t growth_left = 0; // Empty slots that can still be filled before rehashing.
+
+	_FORCE_INLINE_ uint32_t _hash(const TKey &p_key) const {
+		uint32_t hash = Hasher::hash(p_key);
+
+		if (unlikely(hash == EMPTY_HASH)) {
+			hash = EMPTY_HASH + 1;
+		}
+
+		return hash;
+	}
+
+	// Low bits pick the first slot, the top 7 bits go to the control byte.
+	static _FORCE_INLINE_ uint8_t _get_h2(uint32_t p_hash) {
+		return p_hash >> 25;
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_max_load(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8;
+	}
+
+	_FORCE_INLINE_ void _set_ctrl(uint32_t p_slot, uint8_t p_value) {
+		ctrl[p_slot] = p_value;
+		if (p_slot < SwissHashGroup::WIDTH) {
+			ctrl[capacity + p_slot] = p_value;
+		}
+	}
+
+	// Groups are visited with triangular steps, which reach every slot when the capacity is a power of two.
+	bool _lookup_slot(const TKey &p_key, uint32_t p_hash, uint32_t &r_slot) const {
+		if (unlikely(elements == nullptr)) {
+			return false; // Failed lookups, no elements.
+		}
+
+		const uint32_t mask = capacity - 1;
+		const uint8_t h2 = _get_h2(p_hash);
+		uint32_t pos = p_hash & mask;
+		uint32_t step = 0;
+		while (true) {
+			const SwissHashGroup group(ctrl + pos);
+			for (uint64_t match = group.match(h2); match; match &= match - 1) {
+				const uint32_t slot = (pos + SwissHashGroup::first(match)) & mask;
+				const uint32_t index = slots[slot];
+				if (hashes[index] == p_hash && Comparator::compare(elements[index].key, p_key)) {
+					r_slot = slot;
+					return true;
+				}
+			}
+			if (group.match_empty()) {
+				return false;
+			}
+			step += SwissHashGroup::WIDTH;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	// Finds the slot pointing to an element known to be in the map.
+	uint32_t _find_element_slot(uint32_t p_index) const {
+		const uint32_t mask = capacity - 1;
+		const uint32_t hash = hashes[p_index];
+		const uint8_t h2 = _get_h2(hash);
+		uint32_t pos = hash & mask;
+		uint32_t step = 0;
+		while (true) {
+			const SwissHashGroup group(ctrl + pos);
+			for (uint64_t match = group.match(h2); match; match &= match - 1) {
+				const uint32_t slot = (pos + SwissHashGroup::first(match)) & mask;
+				if (slots[slot] == p_index) {
+					return slot;
+				}
+			}
+			step += SwissHashGroup::WIDTH;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	uint32_t _find_free_slot(uint32_t p_hash) const {
+		const uint32_t mask = capacity - 1;
+		uint32_t pos = p_hash & mask;
+		uint32_t step = 0;
+		while (true) {
+			const uint64_t free = SwissHashGroup(ctrl + pos).match_empty_or_deleted();
+			if (free) {
+				return (pos + SwissHashGroup::first(free)) & mask;
+			}
+			step += SwissHashGroup::WIDTH;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	void _place(uint32_t p_index) {
+		const uint32_t hash = hashes[p_index];
+		const uint32_t slot = _find_free_slot(hash);
+		if (ctrl[slot] == SwissHashGroup::CTRL_EMPTY) {
+			growth_left--;
+		}
+		_set_ctrl(slot, _get_h2(hash));
+		slots[slot] = p_index;
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		if constexpr (STABLE_ORDER) {
+			// Close the gaps left by erased elements.
+			if (num_used != num_elements) {
+				uint32_t to = 0;
+				for (uint32_t from = 0; from < num_used; from++) {
+					if (hashes[from] == EMPTY_HASH) {
+						continue;
+					}
+					if (to != from) {
+						void *destination = &elements[to];
+						const void *source = &elements[from];
+						memcpy(destination, source, sizeof(MapKeyValue));
+						hashes[to] = hashes[from];
+					}
+					to++;
+				}
+			}
+		}
+		num_used = num_elements;
+
+		if (p_new_capacity != capacity || ctrl == nullptr) {
+			capacity = p_new_capacity;
+			if (ctrl != nullptr) {
+				Memory::free_static(ctrl);
+				Memory::free_static(slots);
+			}
+			ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(capacity + SwissHashGroup::WIDTH));
+			slots = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+			elements = reinterpret_cast<MapKeyValue *>(Memory::realloc_static(elements, sizeof(MapKeyValue) * _get_max_load(capacity)));
+			hashes = reinterpret_cast<uint32_t *>(Memory::realloc_static(hashes, sizeof(uint32_t) * _get_max_load(capacity)));
+		}
+
+		memset(ctrl, SwissHashGroup::CTRL_EMPTY, capacity + SwissHashGroup::WIDTH);
+		growth_left = _get_max_load(capacity);
+		for (uint32_t i = 0; i < num_elements; i++) {
+			_place(i);
+		}
+	}
+
+	uint32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if (unlikely(elements == nullptr)) {
+			// Allocate on demand to save memory.
+			_resize_and_rehash(capacity);
+		}
+
+		if (unlikely(growth_left == 0 || num_used == _get_max_load(capacity))) {
+			// Rehash in place if erased elements take much of the room.
+			_resize_and_rehash(num_elements < _get_max_load(capacity) / 2 ? capacity : capacity * 2);
+		}
+
+		memnew_placement(&elements[num_used], MapKeyValue(p_key, p_value));
+		hashes[num_used] = p_hash;
+		_place(num_used);
+		num_used++;
+		num_elements++;
+		return num_used - 1;
+	}
+
+	void _erase_slot(uint32_t p_slot) {
+		const uint32_t mask = capacity - 1;
+		const uint32_t index = slots[p_slot];
+
+		// The slot can go back to empty if no lookup could have gone past it, which is when
+		// the group windows around it already have an empty slot on both sides.
+		const uint64_t empty_after = SwissHashGroup(ctrl + p_slot).match_empty();
+		const uint64_t empty_before = SwissHashGroup(ctrl + ((p_slot - SwissHashGroup::WIDTH) & mask)).match_empty();
+		if (empty_before && empty_after && SwissHashGroup::first(empty_after) + SwissHashGroup::after_last(empty_before) < SwissHashGroup::WIDTH) {
+			_set_ctrl(p_slot, SwissHashGroup::CTRL_EMPTY);
+			growth_left++;
+		} else {
+			_set_ctrl(p_slot, SwissHashGroup::CTRL_DELETED);
+		}
+
+		elements[index].key.~TKey();
+		elements[index].value.~TValue();
+		num_elements--;
+
+		if constexpr (STABLE_ORDER) {
+			hashes[index] = EMPTY_HASH;
+			while (num_used > 0 && hashes[num_used - 1] == EMPTY_HASH) {
+				num_used--;
+			}
+		} else {
+			num_used--;
+			if (index < num_used) {
+				void *destination = &elements[index];
+				const void *source = &elements[num_used];
+				memcpy(destination, source, sizeof(MapKeyValue));
+				hashes[index] = hashes[num_used];
+				slots[_find_element_slot(num_used)] = index;
+			}
+		}
+	}
+
+	_FORCE_INLINE_ uint32_t _skip_free(uint32_t p_index) const {
+		if constexpr (STABLE_ORDER) {
+			while (p_index < num_used && hashes[p_index] == EMPTY_HASH) {
+				p_index++;
+			}
+		}
+		return p_index;
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (elements == nullptr || num_used == 0) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < num_used; i++) {
+			if constexpr (STABLE_ORDER) {
+				if (hashes[i] == EMPTY_HASH) {
+					continue;
+				}
+			}
+			elements[i].key.~TKey();
+			elements[i].value.~TValue();
+		}
+
+		memset(ctrl, SwissHashGroup::CTRL_EMPTY, capacity + SwissHashGroup::WIDTH);
+		growth_left = _get_max_load(capacity);
+		num_elements = 0;
+		num_used = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t slot = 0;
+		bool exists = _lookup_slot(p_key, _hash(p_key), slot);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return elements[slots[slot]].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t slot = 0;
+		bool exists = _lookup_slot(p_key, _hash(p_key), slot);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return elements[slots[slot]].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t slot = 0;
+		if (_lookup_slot(p_key, _hash(p_key), slot)) {
+			return &elements[slots[slot]].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (_lookup_slot(p_key, _hash(p_key), slot)) {
+			return &elements[slots[slot]].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t slot = 0;
+		return _lookup_slot(p_key, _hash(p_key), slot);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, _hash(p_key), slot)) {
+			return false;
+		}
+		_erase_slot(slot);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_capacity = next_power_of_2(MAX(p_new_capacity + p_new_capacity / 7 + 1, MIN_CAPACITY));
+		if (new_capacity <= capacity) {
+			return;
+		}
+		if (elements == nullptr) {
+			capacity = new_capacity;
+			return; // Unallocated yet.
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	template <typename TMapKeyValue>
+	struct IteratorBase {
+		_FORCE_INLINE_ TMapKeyValue &operator*() const {
+			return map->elements[index];
+		}
+		_FORCE_INLINE_ TMapKeyValue *operator->() const {
+			return &map->elements[index];
+		}
+		_FORCE_INLINE_ IteratorBase &operator++() {
+			index = map->_skip_free(index + 1);
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const IteratorBase &b) const { return index == b.index; }
+		_FORCE_INLINE_ bool operator!=(const IteratorBase &b) const { return index != b.index; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map && index < map->num_used;
+		}
+
+		_FORCE_INLINE_ IteratorBase(const SwissHashMap *p_map, uint32_t p_index) :
+				map(p_map), index(p_index) {}
+		_FORCE_INLINE_ IteratorBase() {}
+
+		template <typename TOther>
+		_FORCE_INLINE_ IteratorBase(const IteratorBase<TOther> &p_it) :
+				map(p_it.map), index(p_it.index) {}
+
+	private:
+		friend class SwissHashMap;
+		template <typename>
+		friend struct IteratorBase;
+
+		const SwissHashMap *map = nullptr;
+		uint32_t index = 0;
+	};
+
+	typedef IteratorBase<MapKeyValue> Iterator;
+	typedef IteratorBase<const MapKeyValue> ConstIterator;
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(this, _skip_free(0));
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(this, num_used);
+	}
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, _skip_free(0));
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(this, num_used);
+	}
+
+	Iterator find(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, _hash(p_key), slot)) {
+			return end();
+		}
+		return Iterator(this, slots[slot]);
+	}
+
+	ConstIterator find(const TKey &p_key) const {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, _hash(p_key), slot)) {
+			return end();
+		}
+		return ConstIterator(this, slots[slot]);
+	}
+
+	void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			_erase_slot(_find_element_slot(p_iter.index));
+		}
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		return get(p_key);
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t slot = 0;
+		uint32_t hash = _hash(p_key);
+		if (_lookup_slot(p_key, hash, slot)) {
+			return elements[slots[slot]].value;
+		}
+		return elements[_insert_element(p_key, TValue(), hash)].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t slot = 0;
+		uint32_t hash = _hash(p_key);
+		if (_lookup_slot(p_key, hash, slot)) {
+			elements[slots[slot]].value = p_value;
+			return Iterator(this, slots[slot]);
+		}
+		return Iterator(this, _insert_element(p_key, p_value, hash));
+	}
+
+	// Inserts an element without checking if it already exists.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) {
+		DEV_ASSERT(!has(p_key));
+		return Iterator(this, _insert_element(p_key, p_value, _hash(p_key)));
+	}
+
+	/* Constructors */
+
+	SwissHashMap(const SwissHashMap &p_other) {
+		reserve(p_other.size());
+		for (const MapKeyValue &E : p_other) {
+			_insert_element(E.key, E.value, _hash(E.key));
+		}
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		reset();
+		reserve(p_other.size());
+		for (const MapKeyValue &E : p_other) {
+			_insert_element(E.key, E.value, _hash(E.key));
+		}
+	}
+
+	SwissHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	SwissHashMap() {}
+
+	SwissHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void reset() {
+		if (elements != nullptr) {
+			clear();
+			Memory::free_static(ctrl);
+			Memory::free_static(slots);
+			Memory::free_static(elements);
+			Memory::free_static(hashes);
+			ctrl = nullptr;
+			slots = nullptr;
+			elements = nullptr;
+			hashes = nullptr;
+		}
+		capacity = MIN_CAPACITY;
+		num_elements = 0;
+		num_used = 0;
+		growth_left = 0;
+	}
+
+	~SwissHashMap() {
+		reset();
+	}
+};
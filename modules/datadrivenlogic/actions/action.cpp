@@ -16,15 +16,46 @@ Action::Action()
 
 void Action::execute(Ref<ExecutionContext> context)
 {
-    GDVIRTUAL_CALL(_execute_internal, context);
+    if (context.is_valid())
+    {
+        context->begin_action();
+    }
+    if (!GDVIRTUAL_CALL(_execute_internal, context))
+    {
+        _execute_internal(context);
+    }
+    if (context.is_valid())
+    {
+        context->end_action();
+    }
 }
 
 void Action::revert(Ref<ExecutionContext> context)
 {
-    GDVIRTUAL_CALL(_revert_internal, context);
+    if (!GDVIRTUAL_CALL(_revert_internal, context))
+    {
+        _revert_internal(context);
+    }
+}
+
+bool Action::is_execute_overridden() const
+{
+    return GDVIRTUAL_IS_OVERRIDDEN(_execute_internal);
+}
+
+void Action::_execute_internal(Ref<ExecutionContext> context)
+{
+    return;
+}
+
+void Action::_revert_internal(Ref<ExecutionContext> context)
+{
+    return;
 }
 
 bool Action::_is_revertible()
 {
-    return false;
+    bool ret = false;
+    GDVIRTUAL_CALL(_is_revertible, ret);
+    return ret;
 }
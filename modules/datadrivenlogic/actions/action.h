@@ -17,10 +17,17 @@ public:
     virtual bool _is_revertible();
     GDVIRTUAL0RC(bool, _is_revertible);
 
+    // True when _execute_internal is implemented by a script or an extension, in
+    // which case compiled programs must dispatch to it instead of running natively.
+    bool is_execute_overridden() const;
 
 protected:
 	static void _bind_methods();
 
+    // Native implementations used by built-in actions when no script override exists.
+    virtual void _execute_internal(Ref<ExecutionContext> context);
+    virtual void _revert_internal(Ref<ExecutionContext> context);
+
     GDVIRTUAL1(_execute_internal, Ref<ExecutionContext>);
     GDVIRTUAL1(_revert_internal, Ref<ExecutionContext>);
 };
@@ -0,0 +1,87 @@
+#include "builtinactions.h"
+
+void ActionSequence::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("set_actions", "actions"), &ActionSequence::set_actions);
+    ClassDB::bind_method(D_METHOD("get_actions"), &ActionSequence::get_actions);
+
+    ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "actions", PROPERTY_HINT_ARRAY_TYPE, MAKE_RESOURCE_TYPE_HINT("Action")), "set_actions", "get_actions");
+}
+
+void ActionSequence::_execute_internal(Ref<ExecutionContext> context)
+{
+    for (int i = 0; i < actions.size(); i++)
+    {
+        Ref<Action> action = actions[i];
+        if (action.is_valid())
+        {
+            action->execute(context);
+        }
+    }
+}
+
+void ActionSequence::_revert_internal(Ref<ExecutionContext> context)
+{
+    for (int i = actions.size() - 1; i >= 0; i--)
+    {
+        Ref<Action> action = actions[i];
+        if (action.is_valid() && action->_is_revertible())
+        {
+            action->revert(context);
+        }
+    }
+}
+
+bool ActionSequence::_is_revertible()
+{
+    for (int i = 0; i < actions.size(); i++)
+    {
+        Ref<Action> action = actions[i];
+        if (action.is_valid() && !action->_is_revertible())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ActionSetProperty::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("set_node_index", "node_index"), &ActionSetProperty::set_node_index);
+    ClassDB::bind_method(D_METHOD("get_node_index"), &ActionSetProperty::get_node_index);
+    ClassDB::bind_method(D_METHOD("set_property", "property"), &ActionSetProperty::set_property);
+    ClassDB::bind_method(D_METHOD("get_property"), &ActionSetProperty::get_property);
+    ClassDB::bind_method(D_METHOD("set_value", "value"), &ActionSetProperty::set_value);
+    ClassDB::bind_method(D_METHOD("get_value"), &ActionSetProperty::get_value);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "node_index"), "set_node_index", "get_node_index");
+    ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "property"), "set_property", "get_property");
+    ADD_PROPERTY(PropertyInfo(Variant::NIL, "value", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_NIL_IS_VARIANT), "set_value", "get_value");
+}
+
+void ActionSetProperty::_execute_internal(Ref<ExecutionContext> context)
+{
+    Node *node = context.is_valid() ? context->get_target(node_index) : nullptr;
+    ERR_FAIL_NULL(node);
+
+    previous_value = node->get(property);
+    node->set(property, value);
+
+    if (context->get_journal().is_valid())
+    {
+        context->get_journal()->record_property(node, property, previous_value, value);
+    }
+}
+
+void ActionSetProperty::_revert_internal(Ref<ExecutionContext> context)
+{
+    Node *node = context.is_valid() ? context->get_target(node_index) : nullptr;
+    ERR_FAIL_NULL(node);
+
+    node->set(property, previous_value);
+}
+
+bool ActionSetProperty::_is_revertible()
+{
+    return true;
+}
@@ -0,0 +1,63 @@
+#ifndef BUILTINACTIONS_H
+#define BUILTINACTIONS_H
+
+#include "modules/datadrivenlogic/actions/action.h"
+#include "core/variant/typed_array.h"
+
+// Built-in actions are executed natively and can be flattened by ActionProgram.
+
+// Executes its actions in order and reverts them in reverse order.
+class ActionSequence : public Action
+{
+    GDCLASS(ActionSequence, Action);
+
+public:
+    virtual bool _is_revertible() override;
+
+    TypedArray<Action> get_actions() const { return actions; }
+    void set_actions(const TypedArray<Action> &p_actions) { actions = p_actions; }
+
+protected:
+    static void _bind_methods();
+
+    virtual void _execute_internal(Ref<ExecutionContext> context) override;
+    virtual void _revert_internal(Ref<ExecutionContext> context) override;
+
+private:
+    TypedArray<Action> actions;
+};
+
+// Assigns a constant value to a property of a context node.
+class ActionSetProperty : public Action
+{
+    GDCLASS(ActionSetProperty, Action);
+
+public:
+    virtual bool _is_revertible() override;
+
+    // Negative indices target the context root node.
+    int get_node_index() const { return node_index; }
+    void set_node_index(int p_node_index) { node_index = p_node_index; }
+
+    StringName get_property() const { return property; }
+    void set_property(const StringName &p_property) { property = p_property; }
+
+    Variant get_value() const { return value; }
+    void set_value(const Variant &p_value) { value = p_value; }
+
+protected:
+    static void _bind_methods();
+
+    virtual void _execute_internal(Ref<ExecutionContext> context) override;
+    virtual void _revert_internal(Ref<ExecutionContext> context) override;
+
+private:
+    int node_index = -1;
+    StringName property;
+    Variant value;
+
+    // Value overwritten by the last execution, restored by revert.
+    Variant previous_value;
+};
+
+#endif // BUILTINACTIONS_H
@@ -0,0 +1,135 @@
+#include "actionprogram.h"
+
+#include "modules/datadrivenlogic/actions/builtinactions.h"
+
+void ActionProgram::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("compile", "root"), &ActionProgram::compile);
+    ClassDB::bind_method(D_METHOD("clear"), &ActionProgram::clear);
+    ClassDB::bind_method(D_METHOD("execute", "context"), &ActionProgram::execute);
+    ClassDB::bind_method(D_METHOD("is_compiled"), &ActionProgram::is_compiled);
+    ClassDB::bind_method(D_METHOD("get_instruction_count"), &ActionProgram::get_instruction_count);
+    ClassDB::bind_method(D_METHOD("get_virtual_count"), &ActionProgram::get_virtual_count);
+}
+
+ActionProgram::ActionProgram()
+{
+}
+
+void ActionProgram::clear()
+{
+    opcodes.clear();
+    operands.clear();
+    set_properties.clear();
+    virtuals.clear();
+    compiled = false;
+}
+
+void ActionProgram::_emit(Opcode p_opcode, uint32_t p_operand)
+{
+    opcodes.push_back(p_opcode);
+    operands.push_back(p_operand);
+}
+
+Error ActionProgram::compile(const Ref<Action> &p_root)
+{
+    clear();
+    ERR_FAIL_COND_V(p_root.is_null(), ERR_INVALID_PARAMETER);
+
+    Error err = _compile_action(p_root, 0);
+    if (err != OK)
+    {
+        clear();
+        return err;
+    }
+
+    compiled = true;
+    return OK;
+}
+
+Error ActionProgram::_compile_action(const Ref<Action> &p_action, int p_depth)
+{
+    ERR_FAIL_COND_V_MSG(p_depth > MAX_DEPTH, ERR_CYCLIC_LINK, "Action tree is too deep or contains a cycle.");
+
+    if (p_action.is_null())
+    {
+        return OK;
+    }
+
+    if (p_action->is_execute_overridden())
+    {
+        _emit(OPCODE_VIRTUAL, virtuals.size());
+        virtuals.push_back(p_action);
+        return OK;
+    }
+
+    Action *action = p_action.ptr();
+
+    if (ActionSequence *sequence = Object::cast_to<ActionSequence>(action))
+    {
+        TypedArray<Action> actions = sequence->get_actions();
+        for (int i = 0; i < actions.size(); i++)
+        {
+            Error err = _compile_action(actions[i], p_depth + 1);
+            if (err != OK)
+            {
+                return err;
+            }
+        }
+        return OK;
+    }
+
+    if (ActionSetProperty *set_property = Object::cast_to<ActionSetProperty>(action))
+    {
+        SetProperty op;
+        op.node_index = set_property->get_node_index();
+        op.property = set_property->get_property();
+        op.value = set_property->get_value();
+
+        _emit(OPCODE_SET_PROPERTY, set_properties.size());
+        set_properties.push_back(op);
+        return OK;
+    }
+
+    _emit(OPCODE_VIRTUAL, virtuals.size());
+    virtuals.push_back(p_action);
+    return OK;
+}
+
+void ActionProgram::execute(const Ref<ExecutionContext> &p_context) const
+{
+    ERR_FAIL_COND_MSG(!compiled, "ActionProgram must be compiled before being executed.");
+    ERR_FAIL_COND(p_context.is_null());
+
+    ExecutionContext *context = p_context.ptr();
+    ActionJournal *journal = context->get_journal().ptr();
+    context->begin_action();
+
+    const uint8_t *ops = opcodes.ptr();
+    const uint32_t *args = operands.ptr();
+
+    for (uint32_t ip = 0; ip < opcodes.size(); ip++)
+    {
+        switch (ops[ip])
+        {
+            case OPCODE_SET_PROPERTY:
+            {
+                const SetProperty &op = set_properties[args[ip]];
+                Node *node = context->get_target(op.node_index);
+                ERR_CONTINUE(!node);
+                if (journal)
+                {
+                    journal->set_property(node, op.property, op.value);
+                }
+                else
+                {
+                    node->set(op.property, op.value);
+                }
+            } break;
+            case OPCODE_VIRTUAL:
+                virtuals[args[ip]]->execute(p_context);
+                break;
+        }
+    }
+    context->end_action();
+}
@@ -0,0 +1,62 @@
+#ifndef ACTIONPROGRAM_H
+#define ACTIONPROGRAM_H
+
+#include "modules/datadrivenlogic/actions/action.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+
+// Flattens nested ActionSequence trees into a linear list of native operations.
+// Actions overridden by a script or an extension are kept as Action::execute calls.
+// Compiled execution does not record revert state on the action resources, each
+// execution is recorded as one transaction in the context's ActionJournal instead.
+class ActionProgram : public RefCounted
+{
+    GDCLASS(ActionProgram, RefCounted);
+
+public:
+    enum Opcode : uint8_t
+    {
+        OPCODE_SET_PROPERTY, // operand: index in set_properties.
+        OPCODE_VIRTUAL, // operand: index in virtuals.
+    };
+
+    ActionProgram();
+
+    Error compile(const Ref<Action> &p_root);
+    void clear();
+
+    void execute(const Ref<ExecutionContext> &p_context) const;
+
+    bool is_compiled() const { return compiled; }
+    int get_instruction_count() const { return opcodes.size(); }
+    int get_virtual_count() const { return virtuals.size(); }
+
+protected:
+    static void _bind_methods();
+
+private:
+    enum
+    {
+        MAX_DEPTH = 256,
+    };
+
+    struct SetProperty
+    {
+        int32_t node_index = -1;
+        StringName property;
+        Variant value;
+    };
+
+    LocalVector<uint8_t> opcodes;
+    LocalVector<uint32_t> operands;
+
+    LocalVector<SetProperty> set_properties;
+    LocalVector<Ref<Action>> virtuals;
+
+    bool compiled = false;
+
+    void _emit(Opcode p_opcode, uint32_t p_operand);
+    Error _compile_action(const Ref<Action> &p_action, int p_depth);
+};
+
+#endif // ACTIONPROGRAM_H
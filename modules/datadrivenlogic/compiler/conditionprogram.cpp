@@ -0,0 +1,378 @@
+#include "conditionprogram.h"
+
+#include "modules/datadrivenlogic/conditions/builtinconditions.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/variant/variant_internal.h"
+
+void ConditionProgram::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("compile", "root"), &ConditionProgram::compile);
+    ClassDB::bind_method(D_METHOD("clear"), &ConditionProgram::clear);
+    ClassDB::bind_method(D_METHOD("evaluate", "context"), &ConditionProgram::evaluate);
+    ClassDB::bind_method(D_METHOD("evaluate_batch", "contexts"), &ConditionProgram::evaluate_batch);
+    ClassDB::bind_method(D_METHOD("is_compiled"), &ConditionProgram::is_compiled);
+    ClassDB::bind_method(D_METHOD("is_thread_safe"), &ConditionProgram::is_thread_safe);
+    ClassDB::bind_method(D_METHOD("get_instruction_count"), &ConditionProgram::get_instruction_count);
+    ClassDB::bind_method(D_METHOD("get_virtual_count"), &ConditionProgram::get_virtual_count);
+}
+
+ConditionProgram::ConditionProgram()
+{
+}
+
+void ConditionProgram::clear()
+{
+    opcodes.clear();
+    operands.clear();
+    compares.clear();
+    virtuals.clear();
+    compiled = false;
+    thread_safe = true;
+}
+
+uint32_t ConditionProgram::_emit(Opcode p_opcode, uint32_t p_operand)
+{
+    opcodes.push_back(p_opcode);
+    operands.push_back(p_operand);
+    return opcodes.size() - 1;
+}
+
+Error ConditionProgram::compile(const Ref<Condition> &p_root)
+{
+    clear();
+    ERR_FAIL_COND_V(p_root.is_null(), ERR_INVALID_PARAMETER);
+
+    Error err = _compile_condition(p_root, 0);
+    if (err != OK)
+    {
+        clear();
+        return err;
+    }
+
+    compiled = true;
+    return OK;
+}
+
+Error ConditionProgram::_compile_condition(const Ref<Condition> &p_condition, int p_depth)
+{
+    ERR_FAIL_COND_V_MSG(p_depth > MAX_DEPTH, ERR_CYCLIC_LINK, "Condition tree is too deep or contains a cycle.");
+
+    if (p_condition.is_null())
+    {
+        // Composites treat missing children as unverified.
+        _emit(OPCODE_CONSTANT, 0);
+        return OK;
+    }
+
+    if (p_condition->is_script_overridden())
+    {
+        _emit(OPCODE_VIRTUAL, virtuals.size());
+        virtuals.push_back(p_condition);
+        thread_safe = thread_safe && p_condition->is_thread_safe();
+        return OK;
+    }
+
+    Condition *condition = p_condition.ptr();
+
+    if (ConditionConstant *constant = Object::cast_to<ConditionConstant>(condition))
+    {
+        _emit(OPCODE_CONSTANT, constant->get_value() ? 1 : 0);
+        return OK;
+    }
+
+    if (ConditionNot *negation = Object::cast_to<ConditionNot>(condition))
+    {
+        if (negation->get_condition().is_null())
+        {
+            _emit(OPCODE_CONSTANT, 0);
+            return OK;
+        }
+        Error err = _compile_condition(negation->get_condition(), p_depth + 1);
+        if (err != OK)
+        {
+            return err;
+        }
+        _emit(OPCODE_NOT);
+        return OK;
+    }
+
+    if (ConditionAll *all = Object::cast_to<ConditionAll>(condition))
+    {
+        return _compile_composite(all->get_conditions(), true, p_depth);
+    }
+
+    if (ConditionAny *any = Object::cast_to<ConditionAny>(condition))
+    {
+        return _compile_composite(any->get_conditions(), false, p_depth);
+    }
+
+    if (ConditionPropertyCompare *property_compare = Object::cast_to<ConditionPropertyCompare>(condition))
+    {
+        Compare compare;
+        compare.node_index = property_compare->get_node_index();
+        compare.property = property_compare->get_property();
+        compare.op = ConditionPropertyCompare::get_variant_operator(property_compare->get_compare_operator());
+        compare.value = property_compare->get_value();
+
+        _emit(OPCODE_COMPARE, compares.size());
+        compares.push_back(compare);
+        return OK;
+    }
+
+    // Native subclasses unknown to the compiler keep their virtual implementation.
+    // They are evaluated through verify(), which stores its result in the shared
+    // resource, so batches containing them stay on the calling thread.
+    _emit(OPCODE_VIRTUAL, virtuals.size());
+    virtuals.push_back(p_condition);
+    thread_safe = false;
+    return OK;
+}
+
+Error ConditionProgram::_compile_composite(const TypedArray<Condition> &p_conditions, bool p_all, int p_depth)
+{
+    if (p_conditions.is_empty())
+    {
+        _emit(OPCODE_CONSTANT, p_all ? 1 : 0);
+        return OK;
+    }
+
+    LocalVector<uint32_t> jumps;
+    for (int i = 0; i < p_conditions.size(); i++)
+    {
+        Error err = _compile_condition(p_conditions[i], p_depth + 1);
+        if (err != OK)
+        {
+            return err;
+        }
+        if (i < p_conditions.size() - 1)
+        {
+            jumps.push_back(_emit(p_all ? OPCODE_JUMP_IF_FALSE : OPCODE_JUMP_IF_TRUE));
+        }
+    }
+
+    // Every jump lands right after the last child, where the register holds the result.
+    for (uint32_t jump : jumps)
+    {
+        operands[jump] = opcodes.size();
+    }
+    return OK;
+}
+
+bool ConditionProgram::_read_compare(const Compare &p_compare, ExecutionContext *p_context, Variant &r_value)
+{
+    Node *node = p_context->get_target(p_compare.node_index);
+    if (!node)
+    {
+        return false;
+    }
+
+    bool valid = false;
+    r_value = node->get(p_compare.property, &valid);
+    return valid;
+}
+
+bool ConditionProgram::_evaluate_compare(const Compare &p_compare, const Variant &p_current)
+{
+    Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(p_compare.op, p_current.get_type(), p_compare.value.get_type());
+    if (!evaluator)
+    {
+        // Comparisons between unrelated types are never verified, matching Variant::evaluate.
+        return false;
+    }
+
+    Variant result;
+    VariantInternal::initialize(&result, Variant::BOOL);
+    evaluator(&p_current, &p_compare.value, &result);
+    return *VariantInternal::get_bool(&result);
+}
+
+bool ConditionProgram::_needs_calling_thread(ExecutionContext *p_context) const
+{
+    for (const Compare &compare : compares)
+    {
+        Node *node = p_context->get_target(compare.node_index);
+        if (node && node->is_inside_tree())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ConditionProgram::evaluate(const Ref<ExecutionContext> &p_context) const
+{
+    ERR_FAIL_COND_V_MSG(!compiled, false, "ConditionProgram must be compiled before being evaluated.");
+    ERR_FAIL_COND_V(p_context.is_null(), false);
+
+    return _evaluate(p_context.ptr());
+}
+
+bool ConditionProgram::_evaluate(ExecutionContext *p_context, const CompareRead *p_reads) const
+{
+    const uint8_t *ops = opcodes.ptr();
+    const uint32_t *args = operands.ptr();
+    const uint32_t count = opcodes.size();
+
+    bool result = false;
+    uint32_t ip = 0;
+    while (ip < count)
+    {
+        switch (ops[ip])
+        {
+            case OPCODE_CONSTANT:
+                result = args[ip] != 0;
+                break;
+            case OPCODE_COMPARE:
+                if (p_reads)
+                {
+                    const CompareRead &read = p_reads[args[ip]];
+                    result = read.valid && _evaluate_compare(compares[args[ip]], read.value);
+                }
+                else
+                {
+                    Variant current;
+                    result = _read_compare(compares[args[ip]], p_context, current) && _evaluate_compare(compares[args[ip]], current);
+                }
+                break;
+            case OPCODE_VIRTUAL:
+                result = virtuals[args[ip]]->evaluate(Ref<ExecutionContext>(p_context));
+                break;
+            case OPCODE_NOT:
+                result = !result;
+                break;
+            case OPCODE_JUMP_IF_FALSE:
+                if (!result)
+                {
+                    ip = args[ip];
+                    continue;
+                }
+                break;
+            case OPCODE_JUMP_IF_TRUE:
+                if (result)
+                {
+                    ip = args[ip];
+                    continue;
+                }
+                break;
+        }
+        ip++;
+    }
+    return result;
+}
+
+void ConditionProgram::_evaluate_batch_block(uint32_t p_block, BatchData *p_data) const
+{
+    const uint32_t from = p_block * BATCH_BLOCK_SIZE;
+    const uint32_t to = MIN(from + BATCH_BLOCK_SIZE, p_data->count);
+
+    for (uint32_t i = from; i < to; i++)
+    {
+        ExecutionContext *context = p_data->contexts[i];
+        if (context && _evaluate(context, p_data->reads ? p_data->reads[i] : nullptr))
+        {
+            p_data->bits[i >> 3] |= uint8_t(1 << (i & 7));
+        }
+    }
+}
+
+void ConditionProgram::evaluate_batch_ptr(ExecutionContext *const *p_contexts, uint32_t p_count, uint8_t *r_bits) const
+{
+    ERR_FAIL_COND_MSG(!compiled, "ConditionProgram must be compiled before being evaluated.");
+
+    BatchData data;
+    data.contexts = p_contexts;
+    data.count = p_count;
+    data.bits = r_bits;
+
+    const uint32_t blocks = (p_count + BATCH_BLOCK_SIZE - 1) / BATCH_BLOCK_SIZE;
+    if (!thread_safe || blocks < 2)
+    {
+        for (uint32_t i = 0; i < blocks; i++)
+        {
+            _evaluate_batch_block(i, &data);
+        }
+        return;
+    }
+
+    // Nodes inside the tree may only be read from the thread that owns them, so their
+    // properties are read here and the workers only run the comparisons.
+    LocalVector<uint32_t> read_contexts;
+    for (uint32_t i = 0; i < p_count && !compares.is_empty(); i++)
+    {
+        if (p_contexts[i] && _needs_calling_thread(p_contexts[i]))
+        {
+            read_contexts.push_back(i);
+        }
+    }
+
+    LocalVector<CompareRead> reads;
+    LocalVector<const CompareRead *> context_reads;
+    if (!read_contexts.is_empty())
+    {
+        reads.resize(read_contexts.size() * compares.size());
+        context_reads.resize(p_count);
+        for (uint32_t i = 0; i < p_count; i++)
+        {
+            context_reads[i] = nullptr;
+        }
+        for (uint32_t i = 0; i < read_contexts.size(); i++)
+        {
+            CompareRead *context_read = &reads[i * compares.size()];
+            for (uint32_t j = 0; j < compares.size(); j++)
+            {
+                context_read[j].valid = _read_compare(compares[j], p_contexts[read_contexts[i]], context_read[j].value);
+            }
+            context_reads[read_contexts[i]] = context_read;
+        }
+        data.reads = context_reads.ptr();
+    }
+
+    WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ConditionProgram::_evaluate_batch_block, &data, blocks, -1, true, SNAME("ConditionProgramBatch"));
+    WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void ConditionProgram::get_dependencies(ExecutionContext *p_context, LocalVector<Dependency> &r_dependencies) const
+{
+    ERR_FAIL_NULL(p_context);
+
+    for (const Compare &compare : compares)
+    {
+        Node *node = p_context->get_target(compare.node_index);
+        if (node)
+        {
+            r_dependencies.push_back({ node->get_instance_id(), compare.property });
+        }
+    }
+
+    if (virtuals.is_empty())
+    {
+        return;
+    }
+    for (int i = -1; i < p_context->get_node_count(); i++)
+    {
+        Node *node = p_context->get_target(i);
+        if (node)
+        {
+            r_dependencies.push_back({ node->get_instance_id(), StringName() });
+        }
+    }
+}
+
+PackedByteArray ConditionProgram::evaluate_batch(const TypedArray<ExecutionContext> &p_contexts) const
+{
+    PackedByteArray bits;
+    ERR_FAIL_COND_V_MSG(!compiled, bits, "ConditionProgram must be compiled before being evaluated.");
+
+    const uint32_t count = p_contexts.size();
+    LocalVector<ExecutionContext *> contexts;
+    contexts.resize(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        contexts[i] = Object::cast_to<ExecutionContext>(p_contexts[i]);
+    }
+
+    bits.resize((count + 7) / 8);
+    bits.fill(0);
+    evaluate_batch_ptr(contexts.ptr(), count, bits.ptrw());
+    return bits;
+}
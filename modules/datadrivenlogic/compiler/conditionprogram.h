@@ -0,0 +1,121 @@
+#ifndef CONDITIONPROGRAM_H
+#define CONDITIONPROGRAM_H
+
+#include "modules/datadrivenlogic/conditions/condition.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+
+// Flattens a tree of built-in conditions into a linear program evaluated without
+// going through ClassDB or script dispatch. Conditions whose _verify is overridden
+// by a script or an extension are kept as leaves that call Condition::verify.
+//
+// The program keeps a single boolean register. Leaves write it, OPCODE_NOT flips it
+// and the jump opcodes implement the short-circuit of ConditionAll/ConditionAny by
+// skipping to the end of the composite with the register already holding its result.
+class ConditionProgram : public RefCounted
+{
+    GDCLASS(ConditionProgram, RefCounted);
+
+public:
+    enum Opcode : uint8_t
+    {
+        OPCODE_CONSTANT, // operand: 0 or 1.
+        OPCODE_COMPARE, // operand: index in compares.
+        OPCODE_VIRTUAL, // operand: index in virtuals.
+        OPCODE_NOT,
+        OPCODE_JUMP_IF_FALSE, // operand: target instruction.
+        OPCODE_JUMP_IF_TRUE, // operand: target instruction.
+    };
+
+    // An object read by the program. An empty property means any property.
+    struct Dependency
+    {
+        ObjectID object;
+        StringName property;
+    };
+
+    ConditionProgram();
+
+    Error compile(const Ref<Condition> &p_root);
+    void clear();
+
+    bool evaluate(const Ref<ExecutionContext> &p_context) const;
+
+    // Evaluates the program against every context and returns the results as a
+    // bitset, bit i of byte i / 8 holding the result for context i. Thread-safe
+    // programs are spread over the WorkerThreadPool. Properties compared on nodes
+    // inside the tree are read on the calling thread before dispatching, other
+    // nodes are read from the worker threads.
+    PackedByteArray evaluate_batch(const TypedArray<ExecutionContext> &p_contexts) const;
+    // r_bits must hold at least (p_count + 7) / 8 zeroed bytes. Null contexts are unverified.
+    void evaluate_batch_ptr(ExecutionContext *const *p_contexts, uint32_t p_count, uint8_t *r_bits) const;
+
+    // Collects the objects and properties read when evaluating against p_context.
+    // Leaves dispatched to scripts depend on every node of the context.
+    void get_dependencies(ExecutionContext *p_context, LocalVector<Dependency> &r_dependencies) const;
+
+    bool is_compiled() const { return compiled; }
+    // True when every leaf dispatched to a script or an extension is thread-safe and
+    // the program has no native leaf that must go through verify().
+    bool is_thread_safe() const { return thread_safe; }
+    int get_instruction_count() const { return opcodes.size(); }
+    int get_virtual_count() const { return virtuals.size(); }
+
+protected:
+    static void _bind_methods();
+
+private:
+    enum
+    {
+        MAX_DEPTH = 256,
+        // Contexts per batch block. A multiple of 8 so blocks never share a result byte.
+        BATCH_BLOCK_SIZE = 64,
+    };
+
+    struct Compare
+    {
+        int32_t node_index = -1;
+        StringName property;
+        Variant::Operator op = Variant::OP_EQUAL;
+        Variant value;
+    };
+
+    // A property read ahead of the evaluation, one per comparison of the program.
+    struct CompareRead
+    {
+        Variant value;
+        bool valid = false;
+    };
+
+    struct BatchData
+    {
+        ExecutionContext *const *contexts = nullptr;
+        uint32_t count = 0;
+        uint8_t *bits = nullptr;
+        // Per context, the reads of its comparisons, or null to read them when evaluating.
+        const CompareRead *const *reads = nullptr;
+    };
+
+    // Instructions are stored as parallel arrays so the dispatch loop only touches
+    // the opcode stream until an operand is actually needed.
+    LocalVector<uint8_t> opcodes;
+    LocalVector<uint32_t> operands;
+
+    LocalVector<Compare> compares;
+    LocalVector<Ref<Condition>> virtuals;
+
+    bool compiled = false;
+    bool thread_safe = true;
+
+    uint32_t _emit(Opcode p_opcode, uint32_t p_operand = 0);
+    Error _compile_condition(const Ref<Condition> &p_condition, int p_depth);
+    Error _compile_composite(const TypedArray<Condition> &p_conditions, bool p_all, int p_depth);
+
+    static bool _read_compare(const Compare &p_compare, ExecutionContext *p_context, Variant &r_value);
+    static bool _evaluate_compare(const Compare &p_compare, const Variant &p_current);
+    bool _needs_calling_thread(ExecutionContext *p_context) const;
+    bool _evaluate(ExecutionContext *p_context, const CompareRead *p_reads = nullptr) const;
+    void _evaluate_batch_block(uint32_t p_block, BatchData *p_data) const;
+};
+
+#endif // CONDITIONPROGRAM_H
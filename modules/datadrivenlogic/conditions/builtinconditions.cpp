@@ -0,0 +1,212 @@
+#include "builtinconditions.h"
+
+void ConditionConstant::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("set_value", "value"), &ConditionConstant::set_value);
+    ClassDB::bind_method(D_METHOD("get_value"), &ConditionConstant::get_value);
+
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "value"), "set_value", "get_value");
+}
+
+void ConditionConstant::_verify(Ref<ExecutionContext> context)
+{
+    set_is_verified(value);
+}
+
+void ConditionNot::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("set_condition", "condition"), &ConditionNot::set_condition);
+    ClassDB::bind_method(D_METHOD("get_condition"), &ConditionNot::get_condition);
+
+    ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "condition", PROPERTY_HINT_RESOURCE_TYPE, "Condition"), "set_condition", "get_condition");
+}
+
+void ConditionNot::_verify(Ref<ExecutionContext> context)
+{
+    set_is_verified(condition.is_valid() && !condition->verify(context));
+}
+
+bool ConditionNot::_is_one_time_verified() const
+{
+    return false;
+}
+
+bool ConditionNot::_is_thread_safe() const
+{
+    return condition.is_null() || condition->is_thread_safe();
+}
+
+void ConditionAll::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("set_conditions", "conditions"), &ConditionAll::set_conditions);
+    ClassDB::bind_method(D_METHOD("get_conditions"), &ConditionAll::get_conditions);
+
+    ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "conditions", PROPERTY_HINT_ARRAY_TYPE, MAKE_RESOURCE_TYPE_HINT("Condition")), "set_conditions", "get_conditions");
+}
+
+void ConditionAll::_verify(Ref<ExecutionContext> context)
+{
+    for (int i = 0; i < conditions.size(); i++)
+    {
+        Ref<Condition> condition = conditions[i];
+        if (condition.is_null() || !condition->verify(context))
+        {
+            set_is_verified(false);
+            return;
+        }
+    }
+    set_is_verified(true);
+}
+
+bool ConditionAll::_is_one_time_verified() const
+{
+    if (conditions.is_empty())
+    {
+        return false;
+    }
+    for (int i = 0; i < conditions.size(); i++)
+    {
+        Ref<Condition> condition = conditions[i];
+        if (condition.is_null() || !condition->is_one_time_verified())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ConditionAll::_is_thread_safe() const
+{
+    for (int i = 0; i < conditions.size(); i++)
+    {
+        Ref<Condition> condition = conditions[i];
+        if (condition.is_valid() && !condition->is_thread_safe())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ConditionAny::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("set_conditions", "conditions"), &ConditionAny::set_conditions);
+    ClassDB::bind_method(D_METHOD("get_conditions"), &ConditionAny::get_conditions);
+
+    ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "conditions", PROPERTY_HINT_ARRAY_TYPE, MAKE_RESOURCE_TYPE_HINT("Condition")), "set_conditions", "get_conditions");
+}
+
+void ConditionAny::_verify(Ref<ExecutionContext> context)
+{
+    for (int i = 0; i < conditions.size(); i++)
+    {
+        Ref<Condition> condition = conditions[i];
+        if (condition.is_valid() && condition->verify(context))
+        {
+            set_is_verified(true);
+            return;
+        }
+    }
+    set_is_verified(false);
+}
+
+bool ConditionAny::_is_one_time_verified() const
+{
+    if (conditions.is_empty())
+    {
+        return false;
+    }
+    for (int i = 0; i < conditions.size(); i++)
+    {
+        Ref<Condition> condition = conditions[i];
+        if (condition.is_null() || !condition->is_one_time_verified())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ConditionAny::_is_thread_safe() const
+{
+    for (int i = 0; i < conditions.size(); i++)
+    {
+        Ref<Condition> condition = conditions[i];
+        if (condition.is_valid() && !condition->is_thread_safe())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ConditionPropertyCompare::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("set_node_index", "node_index"), &ConditionPropertyCompare::set_node_index);
+    ClassDB::bind_method(D_METHOD("get_node_index"), &ConditionPropertyCompare::get_node_index);
+    ClassDB::bind_method(D_METHOD("set_property", "property"), &ConditionPropertyCompare::set_property);
+    ClassDB::bind_method(D_METHOD("get_property"), &ConditionPropertyCompare::get_property);
+    ClassDB::bind_method(D_METHOD("set_compare_operator", "compare_operator"), &ConditionPropertyCompare::set_compare_operator);
+    ClassDB::bind_method(D_METHOD("get_compare_operator"), &ConditionPropertyCompare::get_compare_operator);
+    ClassDB::bind_method(D_METHOD("set_value", "value"), &ConditionPropertyCompare::set_value);
+    ClassDB::bind_method(D_METHOD("get_value"), &ConditionPropertyCompare::get_value);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "node_index"), "set_node_index", "get_node_index");
+    ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "property"), "set_property", "get_property");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "compare_operator", PROPERTY_HINT_ENUM, "Equal,Not Equal,Less,Less Equal,Greater,Greater Equal"), "set_compare_operator", "get_compare_operator");
+    ADD_PROPERTY(PropertyInfo(Variant::NIL, "value", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_NIL_IS_VARIANT), "set_value", "get_value");
+
+    BIND_ENUM_CONSTANT(COMPARE_EQUAL);
+    BIND_ENUM_CONSTANT(COMPARE_NOT_EQUAL);
+    BIND_ENUM_CONSTANT(COMPARE_LESS);
+    BIND_ENUM_CONSTANT(COMPARE_LESS_EQUAL);
+    BIND_ENUM_CONSTANT(COMPARE_GREATER);
+    BIND_ENUM_CONSTANT(COMPARE_GREATER_EQUAL);
+}
+
+bool ConditionPropertyCompare::_is_one_time_verified() const
+{
+    return false;
+}
+
+Variant::Operator ConditionPropertyCompare::get_variant_operator(CompareOperator p_compare_operator)
+{
+    switch (p_compare_operator)
+    {
+        case COMPARE_EQUAL:
+            return Variant::OP_EQUAL;
+        case COMPARE_NOT_EQUAL:
+            return Variant::OP_NOT_EQUAL;
+        case COMPARE_LESS:
+            return Variant::OP_LESS;
+        case COMPARE_LESS_EQUAL:
+            return Variant::OP_LESS_EQUAL;
+        case COMPARE_GREATER:
+            return Variant::OP_GREATER;
+        case COMPARE_GREATER_EQUAL:
+            return Variant::OP_GREATER_EQUAL;
+    }
+    return Variant::OP_EQUAL;
+}
+
+void ConditionPropertyCompare::_verify(Ref<ExecutionContext> context)
+{
+    Node *node = context.is_valid() ? context->get_target(node_index) : nullptr;
+    if (!node)
+    {
+        set_is_verified(false);
+        return;
+    }
+
+    bool valid = false;
+    Variant current = node->get(property, &valid);
+    if (!valid)
+    {
+        set_is_verified(false);
+        return;
+    }
+
+    Variant result;
+    Variant::evaluate(get_variant_operator(compare_operator), current, value, result, valid);
+    set_is_verified(valid && result.booleanize());
+}
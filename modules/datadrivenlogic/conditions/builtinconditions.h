@@ -0,0 +1,135 @@
+#ifndef BUILTINCONDITIONS_H
+#define BUILTINCONDITIONS_H
+
+#include "modules/datadrivenlogic/conditions/condition.h"
+#include "core/variant/typed_array.h"
+
+// Built-in conditions are evaluated natively and can be flattened by ConditionProgram.
+
+class ConditionConstant : public Condition
+{
+    GDCLASS(ConditionConstant, Condition);
+
+public:
+    virtual void _verify(Ref<ExecutionContext> context) override;
+    virtual bool _is_thread_safe() const override { return true; }
+
+    bool get_value() const { return value; }
+    void set_value(bool p_value) { value = p_value; }
+
+protected:
+    static void _bind_methods();
+
+private:
+    bool value = true;
+};
+
+class ConditionNot : public Condition
+{
+    GDCLASS(ConditionNot, Condition);
+
+public:
+    virtual void _verify(Ref<ExecutionContext> context) override;
+    virtual bool _is_one_time_verified() const override;
+    virtual bool _is_thread_safe() const override;
+
+    Ref<Condition> get_condition() const { return condition; }
+    void set_condition(const Ref<Condition> &p_condition) { condition = p_condition; }
+
+protected:
+    static void _bind_methods();
+
+private:
+    Ref<Condition> condition;
+};
+
+// Verified when every child is verified. Evaluation stops at the first failure.
+class ConditionAll : public Condition
+{
+    GDCLASS(ConditionAll, Condition);
+
+public:
+    virtual void _verify(Ref<ExecutionContext> context) override;
+    virtual bool _is_one_time_verified() const override;
+    virtual bool _is_thread_safe() const override;
+
+    TypedArray<Condition> get_conditions() const { return conditions; }
+    void set_conditions(const TypedArray<Condition> &p_conditions) { conditions = p_conditions; }
+
+protected:
+    static void _bind_methods();
+
+private:
+    TypedArray<Condition> conditions;
+};
+
+// Verified when at least one child is verified. Evaluation stops at the first success.
+class ConditionAny : public Condition
+{
+    GDCLASS(ConditionAny, Condition);
+
+public:
+    virtual void _verify(Ref<ExecutionContext> context) override;
+    virtual bool _is_one_time_verified() const override;
+    virtual bool _is_thread_safe() const override;
+
+    TypedArray<Condition> get_conditions() const { return conditions; }
+    void set_conditions(const TypedArray<Condition> &p_conditions) { conditions = p_conditions; }
+
+protected:
+    static void _bind_methods();
+
+private:
+    TypedArray<Condition> conditions;
+};
+
+// Compares a property of a context node against a constant value.
+class ConditionPropertyCompare : public Condition
+{
+    GDCLASS(ConditionPropertyCompare, Condition);
+
+public:
+    enum CompareOperator
+    {
+        COMPARE_EQUAL,
+        COMPARE_NOT_EQUAL,
+        COMPARE_LESS,
+        COMPARE_LESS_EQUAL,
+        COMPARE_GREATER,
+        COMPARE_GREATER_EQUAL,
+    };
+
+    virtual void _verify(Ref<ExecutionContext> context) override;
+    virtual bool _is_one_time_verified() const override;
+    // The target node is only known per context, and nodes inside the tree can't
+    // be read from worker threads. ConditionProgram reads those on the calling thread.
+    virtual bool _is_thread_safe() const override { return false; }
+
+    // Negative indices target the context root node.
+    int get_node_index() const { return node_index; }
+    void set_node_index(int p_node_index) { node_index = p_node_index; }
+
+    StringName get_property() const { return property; }
+    void set_property(const StringName &p_property) { property = p_property; }
+
+    CompareOperator get_compare_operator() const { return compare_operator; }
+    void set_compare_operator(CompareOperator p_compare_operator) { compare_operator = p_compare_operator; }
+
+    Variant get_value() const { return value; }
+    void set_value(const Variant &p_value) { value = p_value; }
+
+    static Variant::Operator get_variant_operator(CompareOperator p_compare_operator);
+
+protected:
+    static void _bind_methods();
+
+private:
+    int node_index = -1;
+    StringName property;
+    CompareOperator compare_operator = COMPARE_EQUAL;
+    Variant value;
+};
+
+VARIANT_ENUM_CAST(ConditionPropertyCompare::CompareOperator);
+
+#endif // BUILTINCONDITIONS_H
@@ -2,17 +2,56 @@
 
 void Condition::_bind_methods()
 {
+    ClassDB::bind_method(D_METHOD("verify", "context"), &Condition::verify);
+    ClassDB::bind_method(D_METHOD("evaluate", "context"), &Condition::evaluate);
+    ClassDB::bind_method(D_METHOD("is_thread_safe"), &Condition::is_thread_safe);
+    ClassDB::bind_method(D_METHOD("is_one_time_verified"), &Condition::is_one_time_verified);
     ClassDB::bind_method(D_METHOD("set_is_verified", "p_is_verified"), &Condition::set_is_verified);
     ClassDB::bind_method(D_METHOD("get_is_verified"), &Condition::get_is_verified);
 
     GDVIRTUAL_BIND(_is_one_time_verified);
     GDVIRTUAL_BIND(_verify, "context");
+    GDVIRTUAL_BIND(_evaluate, "context");
+    GDVIRTUAL_BIND(_is_thread_safe);
 }
 
 Condition::Condition()
 {
 }
 
+bool Condition::verify(Ref<ExecutionContext> context)
+{
+    if (!GDVIRTUAL_CALL(_verify, context))
+    {
+        _verify(context);
+    }
+    return is_verified;
+}
+
+bool Condition::evaluate(Ref<ExecutionContext> context)
+{
+    bool ret = false;
+    if (GDVIRTUAL_CALL(_evaluate, context, ret))
+    {
+        return ret;
+    }
+    return verify(context);
+}
+
+bool Condition::is_thread_safe() const
+{
+    bool ret = false;
+    if (GDVIRTUAL_CALL(_is_thread_safe, ret))
+    {
+        return ret && (!is_script_overridden() || GDVIRTUAL_IS_OVERRIDDEN(_evaluate));
+    }
+    if (is_script_overridden())
+    {
+        return false;
+    }
+    return _is_thread_safe();
+}
+
 bool Condition::get_is_verified()
 {
     return is_verified;
@@ -23,12 +62,32 @@ void Condition::set_is_verified(bool p_is_verified)
     is_verified = p_is_verified;
 }
 
+bool Condition::is_script_overridden() const
+{
+    return GDVIRTUAL_IS_OVERRIDDEN(_verify) || GDVIRTUAL_IS_OVERRIDDEN(_evaluate);
+}
+
 void Condition::_verify(Ref<ExecutionContext> context)
 {
     return;
 }
 
+bool Condition::is_one_time_verified() const
+{
+    bool ret = true;
+    if (GDVIRTUAL_CALL(_is_one_time_verified, ret))
+    {
+        return ret;
+    }
+    return _is_one_time_verified();
+}
+
 bool Condition::_is_one_time_verified() const
 {
     return true;
 }
+
+bool Condition::_is_thread_safe() const
+{
+    return false;
+}
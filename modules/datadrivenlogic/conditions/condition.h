@@ -11,12 +11,36 @@ class Condition : public Resource
 public:
     Condition();
 
+    // Runs _verify and returns the resulting verification state.
+    bool verify(Ref<ExecutionContext> context);
+
     virtual void _verify(Ref<ExecutionContext> context);
     GDVIRTUAL1(_verify, Ref<ExecutionContext>);
 
+    // One-time verified conditions stay verified once they have been, so trackers
+    // stop evaluating them after their first success.
+    bool is_one_time_verified() const;
     virtual bool _is_one_time_verified() const;
     GDVIRTUAL0RC(bool, _is_one_time_verified);
 
+    // Stateless counterpart of verify(): returns the result without storing it.
+    // Falls back to verify() when _evaluate is not implemented.
+    bool evaluate(Ref<ExecutionContext> context);
+    GDVIRTUAL1RC(bool, _evaluate, Ref<ExecutionContext>);
+
+    // Thread-safe conditions only read their context and can be evaluated concurrently
+    // against different contexts. Conditions implemented in script must implement
+    // _evaluate to qualify, since verify() stores its result in the shared resource.
+    // Native conditions always go through verify(), so compiled batches evaluate the
+    // ones they cannot flatten on the calling thread regardless of this flag.
+    bool is_thread_safe() const;
+    virtual bool _is_thread_safe() const;
+    GDVIRTUAL0RC(bool, _is_thread_safe);
+
+    // True when _verify or _evaluate is implemented by a script or an extension, in
+    // which case compiled programs must dispatch to it instead of evaluating natively.
+    bool is_script_overridden() const;
+
     bool get_is_verified();
     void set_is_verified(bool p_is_verified);
 
@@ -3,24 +3,65 @@
 void ExecutionContext::_bind_methods()
 {
     ClassDB::bind_method(D_METHOD("get_node", "index"), &ExecutionContext::get_node);
+    ClassDB::bind_method(D_METHOD("get_node_count"), &ExecutionContext::get_node_count);
+    ClassDB::bind_method(D_METHOD("get_target", "index"), &ExecutionContext::get_target);
     ClassDB::bind_method(D_METHOD("get_root"), &ExecutionContext::get_root);
     ClassDB::bind_method(D_METHOD("set_root", "root_node"), &ExecutionContext::set_root);
     ClassDB::bind_method(D_METHOD("append_node", "node"), &ExecutionContext::append_node);
+    ClassDB::bind_method(D_METHOD("get_journal"), &ExecutionContext::get_journal);
+    ClassDB::bind_method(D_METHOD("set_journal", "journal"), &ExecutionContext::set_journal);
+    ClassDB::bind_method(D_METHOD("reset"), &ExecutionContext::reset);
 }
 
 ExecutionContext::ExecutionContext()
 {
 }
 
-Node* ExecutionContext::get_node(int index)
+Node* ExecutionContext::get_node(int index) const
 {
-    if(nodes.size() >= index)
-        return nullptr;
+    return _get_node(get_node_id(index));
+}
+
+ObjectID ExecutionContext::get_node_id(int index) const
+{
+    if (index < 0 || index >= (int)nodes.size())
+        return ObjectID();
+
+    return nodes[index];
+}
+
+Node* ExecutionContext::get_target(int index) const
+{
+    if (index < 0)
+        return get_root();
 
-   return nodes[index]; 
+    return get_node(index);
 }
 
 void ExecutionContext::append_node(Node* node)
 {
-    nodes.append(node);
+    nodes.push_back(node ? node->get_instance_id() : ObjectID());
+}
+
+void ExecutionContext::begin_action()
+{
+    if (action_depth++ == 0 && journal.is_valid())
+    {
+        journal->begin_transaction();
+    }
+}
+
+void ExecutionContext::end_action()
+{
+    ERR_FAIL_COND(action_depth == 0);
+    action_depth--;
+}
+
+void ExecutionContext::reset()
+{
+    owner_id = ObjectID();
+    root_id = ObjectID();
+    nodes.clear();
+    journal.unref();
+    action_depth = 0;
 }
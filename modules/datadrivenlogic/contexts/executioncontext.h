@@ -1,34 +1,66 @@
 #ifndef EXECUTIONCONTEXT_H
 #define EXECUTIONCONTEXT_H
 
+#include "modules/datadrivenlogic/journal/actionjournal.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
 
+// Nodes are stored as ObjectIDs, so accessors return null once a node has been
+// freed instead of a dangling pointer.
 class Node;
 class ExecutionContext : public RefCounted
 {
     GDCLASS(ExecutionContext, RefCounted);
+
+    friend class ExecutionContextPool;
+
 public:
     ExecutionContext();
 
-    Node* get_owner() { return owner; };
-    void set_owner(Node* p_owner) { owner = p_owner;}
+    Node* get_owner() const { return _get_node(owner_id); };
+    void set_owner(Node* p_owner) { owner_id = p_owner ? p_owner->get_instance_id() : ObjectID(); }
 
-    Node* get_root() { return root_node; };
-    void set_root(Node* p_root_node) { root_node = p_root_node;}
+    Node* get_root() const { return _get_node(root_id); };
+    void set_root(Node* p_root_node) { root_id = p_root_node ? p_root_node->get_instance_id() : ObjectID(); }
 
-    Node* get_node(int index);
+    Node* get_node(int index) const;
+    ObjectID get_node_id(int index) const;
+    int get_node_count() const { return nodes.size(); }
+    // Returns the root node for negative indices, the appended node otherwise.
+    Node* get_target(int index) const;
     void append_node(Node* node);
 
+    // Built-in actions record the changes they make in the journal, if any.
+    Ref<ActionJournal> get_journal() const { return journal; }
+    void set_journal(const Ref<ActionJournal> &p_journal) { journal = p_journal; }
+
+    // Bracket an action execution. The outermost one opens a journal transaction,
+    // so the changes of nested actions are reverted and replayed together.
+    void begin_action();
+    void end_action();
+
+    // Clears all nodes while keeping the node storage, so a pooled context can be
+    // reused without allocating.
+    void reset();
+
 protected:
     static void _bind_methods();
 
 private:
-    Node* owner = nullptr;
-    Node* root_node = nullptr;
+    ObjectID owner_id;
+    ObjectID root_id;
+
+    LocalVector<ObjectID> nodes;
+    Ref<ActionJournal> journal;
+    uint32_t action_depth = 0;
+
+    // Slot in the owning ExecutionContextPool, if any.
+    uint32_t pool_index = UINT32_MAX;
+    bool pool_free = false;
 
-    Vector<Node*> nodes;
+    static Node* _get_node(ObjectID p_id) { return p_id.is_valid() ? ObjectDB::get_instance<Node>(p_id) : nullptr; }
 };
 
-#endif // EXECUTIONCONTEXT_H
\ No newline at end of file
+#endif // EXECUTIONCONTEXT_H
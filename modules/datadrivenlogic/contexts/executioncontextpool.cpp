@@ -0,0 +1,105 @@
+#include "executioncontextpool.h"
+
+void ExecutionContextPool::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("acquire"), &ExecutionContextPool::acquire);
+    ClassDB::bind_method(D_METHOD("release", "context"), &ExecutionContextPool::release);
+    ClassDB::bind_method(D_METHOD("reserve", "count"), &ExecutionContextPool::reserve);
+    ClassDB::bind_method(D_METHOD("clear"), &ExecutionContextPool::clear);
+    ClassDB::bind_method(D_METHOD("get_size"), &ExecutionContextPool::get_size);
+    ClassDB::bind_method(D_METHOD("get_free_count"), &ExecutionContextPool::get_free_count);
+}
+
+ExecutionContextPool::ExecutionContextPool()
+{
+}
+
+ExecutionContextPool::~ExecutionContextPool()
+{
+    clear();
+}
+
+void ExecutionContextPool::_grow(uint32_t p_count)
+{
+    const uint32_t from = contexts.size();
+    contexts.resize(from + p_count);
+    free_indices.reserve(contexts.size());
+    for (uint32_t i = from; i < contexts.size(); i++)
+    {
+        contexts[i].instantiate();
+        contexts[i]->pool_index = i;
+        contexts[i]->pool_free = true;
+        free_indices.push_back(i);
+    }
+}
+
+void ExecutionContextPool::_free_context(uint32_t p_index)
+{
+    ExecutionContext *context = contexts[p_index].ptr();
+    context->reset();
+    context->pool_free = true;
+    free_indices.push_back(p_index);
+}
+
+void ExecutionContextPool::_reclaim_unreferenced()
+{
+    for (uint32_t i = 0; i < contexts.size(); i++)
+    {
+        if (!contexts[i]->pool_free && contexts[i]->get_reference_count() == 1)
+        {
+            _free_context(i);
+        }
+    }
+}
+
+Ref<ExecutionContext> ExecutionContextPool::acquire()
+{
+    if (free_indices.is_empty())
+    {
+        // Contexts dropped without release() are only found by sweeping the whole pool.
+        // Growing whenever a sweep frees less than a quarter of it leaves enough free
+        // contexts for the next sweep to be amortized over as many acquires.
+        _reclaim_unreferenced();
+        if (free_indices.size() < MAX(contexts.size() / 4, 1u))
+        {
+            _grow(MAX(contexts.size() / 2, 8u));
+        }
+    }
+
+    const uint32_t index = free_indices[free_indices.size() - 1];
+    free_indices.resize(free_indices.size() - 1);
+
+    contexts[index]->pool_free = false;
+    return contexts[index];
+}
+
+void ExecutionContextPool::release(const Ref<ExecutionContext> &p_context)
+{
+    ERR_FAIL_COND(p_context.is_null());
+    const uint32_t index = p_context->pool_index;
+    ERR_FAIL_COND_MSG(index >= contexts.size() || contexts[index] != p_context, "ExecutionContext does not belong to this pool.");
+    ERR_FAIL_COND_MSG(p_context->pool_free, "ExecutionContext was already released.");
+
+    _free_context(index);
+}
+
+void ExecutionContextPool::reserve(int p_count)
+{
+    ERR_FAIL_COND(p_count < 0);
+    if ((uint32_t)p_count > free_indices.size())
+    {
+        _grow(p_count - free_indices.size());
+    }
+}
+
+void ExecutionContextPool::clear()
+{
+    // Contexts still referenced elsewhere outlive the pool as regular contexts.
+    for (Ref<ExecutionContext> &context : contexts)
+    {
+        context->pool_index = UINT32_MAX;
+        context->pool_free = false;
+    }
+    contexts.clear();
+    free_indices.clear();
+}
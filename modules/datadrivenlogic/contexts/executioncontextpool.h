@@ -0,0 +1,42 @@
+#ifndef EXECUTIONCONTEXTPOOL_H
+#define EXECUTIONCONTEXTPOOL_H
+
+#include "modules/datadrivenlogic/contexts/executioncontext.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+
+// Recycles ExecutionContexts so firing triggers does not allocate in steady state.
+// The pool owns every context it hands out. Contexts come back either through
+// release() or automatically once the pool holds the only reference to them,
+// and are reset before being handed out again.
+class ExecutionContextPool : public RefCounted
+{
+    GDCLASS(ExecutionContextPool, RefCounted);
+
+public:
+    ExecutionContextPool();
+    ~ExecutionContextPool();
+
+    Ref<ExecutionContext> acquire();
+    void release(const Ref<ExecutionContext> &p_context);
+
+    // Grows the pool so at least p_count contexts can be acquired without allocating.
+    void reserve(int p_count);
+    void clear();
+
+    int get_size() const { return contexts.size(); }
+    int get_free_count() const { return free_indices.size(); }
+
+protected:
+    static void _bind_methods();
+
+private:
+    LocalVector<Ref<ExecutionContext>> contexts;
+    LocalVector<uint32_t> free_indices;
+
+    void _grow(uint32_t p_count);
+    void _free_context(uint32_t p_index);
+    void _reclaim_unreferenced();
+};
+
+#endif // EXECUTIONCONTEXTPOOL_H
@@ -0,0 +1,210 @@
+#include "actionjournal.h"
+
+#include "core/io/marshalls.h"
+
+void ActionJournal::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("begin_transaction"), &ActionJournal::begin_transaction);
+    ClassDB::bind_method(D_METHOD("record_property", "object", "property", "old_value", "new_value"), &ActionJournal::record_property);
+    ClassDB::bind_method(D_METHOD("set_property", "object", "property", "value"), &ActionJournal::set_property);
+    ClassDB::bind_method(D_METHOD("revert", "count"), &ActionJournal::revert, DEFVAL(-1));
+    ClassDB::bind_method(D_METHOD("replay", "count"), &ActionJournal::replay, DEFVAL(-1));
+    ClassDB::bind_method(D_METHOD("clear"), &ActionJournal::clear);
+    ClassDB::bind_method(D_METHOD("get_transaction_count"), &ActionJournal::get_transaction_count);
+    ClassDB::bind_method(D_METHOD("get_applied_count"), &ActionJournal::get_applied_count);
+    ClassDB::bind_method(D_METHOD("get_change_count"), &ActionJournal::get_change_count);
+    ClassDB::bind_method(D_METHOD("get_data_size"), &ActionJournal::get_data_size);
+}
+
+ActionJournal::ActionJournal()
+{
+}
+
+void ActionJournal::_discard_reverted()
+{
+    if (applied == transactions.size())
+    {
+        return;
+    }
+
+    const Transaction &first_reverted = transactions[applied];
+    changes.resize(first_reverted.first_change);
+    data.resize(first_reverted.data_start);
+    variants.resize(first_reverted.variant_start);
+    transactions.resize(applied);
+}
+
+void ActionJournal::begin_transaction()
+{
+    _discard_reverted();
+
+    // Don't keep empty transactions around.
+    if (!transactions.is_empty() && transactions[transactions.size() - 1].first_change == changes.size())
+    {
+        return;
+    }
+
+    Transaction transaction;
+    transaction.first_change = changes.size();
+    transaction.data_start = data.size();
+    transaction.variant_start = variants.size();
+    transactions.push_back(transaction);
+    applied = transactions.size();
+}
+
+uint32_t ActionJournal::_intern_property(const StringName &p_property)
+{
+    HashMap<StringName, uint32_t>::Iterator E = property_indices.find(p_property);
+    if (E)
+    {
+        return E->value;
+    }
+    const uint32_t index = properties.size();
+    properties.push_back(p_property);
+    property_indices.insert(p_property, index);
+    return index;
+}
+
+uint32_t ActionJournal::_store_value(const Variant &p_value)
+{
+    switch (p_value.get_type())
+    {
+        // Encoding would lose object identity, keep these as they are.
+        case Variant::OBJECT:
+        case Variant::CALLABLE:
+        case Variant::SIGNAL:
+        case Variant::RID:
+        case Variant::ARRAY:
+        case Variant::DICTIONARY:
+        {
+            ERR_FAIL_COND_V_MSG(variants.size() >= VALUE_IS_VARIANT - 1, INVALID_VALUE, "ActionJournal is full.");
+            variants.push_back(p_value);
+            return (variants.size() - 1) | VALUE_IS_VARIANT;
+        }
+        default:
+            break;
+    }
+
+    int len = 0;
+    Error err = encode_variant(p_value, nullptr, len);
+    ERR_FAIL_COND_V(err != OK, INVALID_VALUE);
+
+    const uint32_t offset = data.size();
+    ERR_FAIL_COND_V_MSG(offset + len >= VALUE_IS_VARIANT, INVALID_VALUE, "ActionJournal is full.");
+    data.resize(offset + len);
+    encode_variant(p_value, data.ptr() + offset, len);
+    return offset;
+}
+
+Variant ActionJournal::_load_value(uint32_t p_value) const
+{
+    if (p_value & VALUE_IS_VARIANT)
+    {
+        return variants[p_value & ~VALUE_IS_VARIANT];
+    }
+
+    Variant value;
+    Error err = decode_variant(value, data.ptr() + p_value, data.size() - p_value);
+    ERR_FAIL_COND_V(err != OK, Variant());
+    return value;
+}
+
+void ActionJournal::record_property(Object *p_object, const StringName &p_property, const Variant &p_old_value, const Variant &p_new_value)
+{
+    ERR_FAIL_NULL(p_object);
+
+    if (applied < transactions.size() || transactions.is_empty())
+    {
+        begin_transaction();
+    }
+
+    const uint32_t data_size = data.size();
+    const uint32_t variant_count = variants.size();
+
+    Change change;
+    change.object = p_object->get_instance_id();
+    change.property = _intern_property(p_property);
+    change.old_value = _store_value(p_old_value);
+    change.new_value = change.old_value == INVALID_VALUE ? INVALID_VALUE : _store_value(p_new_value);
+    if (change.new_value == INVALID_VALUE)
+    {
+        // The change is dropped instead of pointing at another change's value.
+        data.resize(data_size);
+        variants.resize(variant_count);
+        return;
+    }
+    changes.push_back(change);
+}
+
+void ActionJournal::set_property(Object *p_object, const StringName &p_property, const Variant &p_value)
+{
+    ERR_FAIL_NULL(p_object);
+
+    record_property(p_object, p_property, p_object->get(p_property), p_value);
+    p_object->set(p_property, p_value);
+}
+
+void ActionJournal::_apply(uint32_t p_transaction, bool p_revert)
+{
+    const uint32_t from = transactions[p_transaction].first_change;
+    const uint32_t to = p_transaction + 1 < transactions.size() ? transactions[p_transaction + 1].first_change : changes.size();
+
+    if (p_revert)
+    {
+        for (uint32_t i = to; i > from; i--)
+        {
+            const Change &change = changes[i - 1];
+            Object *object = ObjectDB::get_instance(change.object);
+            if (object)
+            {
+                object->set(properties[change.property], _load_value(change.old_value));
+            }
+        }
+    }
+    else
+    {
+        for (uint32_t i = from; i < to; i++)
+        {
+            const Change &change = changes[i];
+            Object *object = ObjectDB::get_instance(change.object);
+            if (object)
+            {
+                object->set(properties[change.property], _load_value(change.new_value));
+            }
+        }
+    }
+}
+
+int ActionJournal::revert(int p_count)
+{
+    const uint32_t count = p_count < 0 ? applied : MIN((uint32_t)p_count, applied);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        applied--;
+        _apply(applied, true);
+    }
+    return count;
+}
+
+int ActionJournal::replay(int p_count)
+{
+    const uint32_t available = transactions.size() - applied;
+    const uint32_t count = p_count < 0 ? available : MIN((uint32_t)p_count, available);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        _apply(applied, false);
+        applied++;
+    }
+    return count;
+}
+
+void ActionJournal::clear()
+{
+    changes.clear();
+    transactions.clear();
+    applied = 0;
+    data.clear();
+    variants.clear();
+    properties.clear();
+    property_indices.clear();
+}
@@ -0,0 +1,80 @@
+#ifndef ACTIONJOURNAL_H
+#define ACTIONJOURNAL_H
+
+#include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Records the property changes made by actions so they can be reverted or
+// replayed in bulk, like an undo history. Changes are grouped in transactions,
+// usually one per ActionProgram execution.
+//
+// Values are stored encoded in a single byte buffer, property names are interned
+// in a table, so a change costs a few bytes instead of two Variants. Values that
+// can't be encoded without losing object identity are kept as Variants.
+class ActionJournal : public RefCounted
+{
+    GDCLASS(ActionJournal, RefCounted);
+
+public:
+    ActionJournal();
+
+    // Starts a new transaction. Reverted transactions are discarded.
+    void begin_transaction();
+    void record_property(Object *p_object, const StringName &p_property, const Variant &p_old_value, const Variant &p_new_value);
+    // Sets the property and records the change.
+    void set_property(Object *p_object, const StringName &p_property, const Variant &p_value);
+
+    // Reverts up to p_count applied transactions, newest first. Returns the number reverted.
+    int revert(int p_count = -1);
+    // Reapplies up to p_count reverted transactions, oldest first. Returns the number replayed.
+    int replay(int p_count = -1);
+    void clear();
+
+    int get_transaction_count() const { return transactions.size(); }
+    int get_applied_count() const { return applied; }
+    int get_change_count() const { return changes.size(); }
+    int get_data_size() const { return data.size(); }
+
+protected:
+    static void _bind_methods();
+
+private:
+    // Value references with this bit set index variants instead of data.
+    static const uint32_t VALUE_IS_VARIANT = 1u << 31;
+    // Returned by _store_value when a value can't be stored. Offset 0 is valid data.
+    static const uint32_t INVALID_VALUE = UINT32_MAX;
+
+    struct Change
+    {
+        ObjectID object;
+        uint32_t property = 0;
+        uint32_t old_value = 0;
+        uint32_t new_value = 0;
+    };
+
+    struct Transaction
+    {
+        uint32_t first_change = 0;
+        uint32_t data_start = 0;
+        uint32_t variant_start = 0;
+    };
+
+    LocalVector<Change> changes;
+    LocalVector<Transaction> transactions;
+    uint32_t applied = 0;
+
+    LocalVector<uint8_t> data;
+    LocalVector<Variant> variants;
+
+    LocalVector<StringName> properties;
+    HashMap<StringName, uint32_t> property_indices;
+
+    void _discard_reverted();
+    uint32_t _intern_property(const StringName &p_property);
+    uint32_t _store_value(const Variant &p_value);
+    Variant _load_value(uint32_t p_value) const;
+    void _apply(uint32_t p_transaction, bool p_revert);
+};
+
+#endif // ACTIONJOURNAL_H
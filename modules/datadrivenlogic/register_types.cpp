@@ -1,8 +1,15 @@
 #include "register_types.h"
 
 #include "actions/action.h"
+#include "actions/builtinactions.h"
+#include "compiler/actionprogram.h"
+#include "compiler/conditionprogram.h"
+#include "conditions/builtinconditions.h"
 #include "conditions/condition.h"
 #include "contexts/executioncontext.h"
+#include "contexts/executioncontextpool.h"
+#include "journal/actionjournal.h"
+#include "tracking/conditiontracker.h"
 
 #include "core/object/class_db.h"
 
@@ -12,8 +19,20 @@ void initialize_datadrivenlogic_module(ModuleInitializationLevel p_level) {
 		return;
 	}
 	GDREGISTER_CLASS(ExecutionContext)
+	GDREGISTER_CLASS(ExecutionContextPool)
+	GDREGISTER_CLASS(ActionJournal)
 	GDREGISTER_CLASS(Action)
 	GDREGISTER_CLASS(Condition)
+	GDREGISTER_CLASS(ConditionConstant)
+	GDREGISTER_CLASS(ConditionNot)
+	GDREGISTER_CLASS(ConditionAll)
+	GDREGISTER_CLASS(ConditionAny)
+	GDREGISTER_CLASS(ConditionPropertyCompare)
+	GDREGISTER_CLASS(ActionSequence)
+	GDREGISTER_CLASS(ActionSetProperty)
+	GDREGISTER_CLASS(ConditionProgram)
+	GDREGISTER_CLASS(ActionProgram)
+	GDREGISTER_CLASS(ConditionTracker)
 }
 
 void uninitialize_datadrivenlogic_module(ModuleInitializationLevel p_level) {
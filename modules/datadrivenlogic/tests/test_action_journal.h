@@ -0,0 +1,164 @@
+#ifndef TEST_ACTION_JOURNAL_H
+#define TEST_ACTION_JOURNAL_H
+
+#include "modules/datadrivenlogic/actions/builtinactions.h"
+#include "modules/datadrivenlogic/compiler/actionprogram.h"
+#include "modules/datadrivenlogic/journal/actionjournal.h"
+
+#include "tests/test_macros.h"
+
+namespace TestActionJournal
+{
+
+static Ref<ActionSetProperty> make_set_property(const StringName &p_property, const Variant &p_value)
+{
+    Ref<ActionSetProperty> action;
+    action.instantiate();
+    action->set_property(p_property);
+    action->set_value(p_value);
+    return action;
+}
+
+TEST_CASE("[SceneTree][DataDrivenLogic] ActionJournal reverts and replays transactions")
+{
+    Node *node = memnew(Node);
+    node->set_name("Initial");
+
+    Ref<ActionJournal> journal;
+    journal.instantiate();
+
+    journal->begin_transaction();
+    journal->set_property(node, "process_priority", 1);
+    journal->set_property(node, "name", "First");
+    journal->begin_transaction();
+    journal->set_property(node, "process_priority", 2);
+    journal->set_property(node, "process_priority", 3);
+
+    CHECK(journal->get_transaction_count() == 2);
+    CHECK(journal->get_change_count() == 4);
+
+    CHECK(journal->revert(1) == 1);
+    CHECK(node->get_process_priority() == 1);
+    CHECK(node->get_name() == "First");
+
+    CHECK(journal->revert() == 1);
+    CHECK(node->get_process_priority() == 0);
+    CHECK(node->get_name() == "Initial");
+    CHECK(journal->revert() == 0);
+
+    CHECK(journal->replay() == 2);
+    CHECK(node->get_process_priority() == 3);
+    CHECK(node->get_name() == "First");
+
+    SUBCASE("Recording discards reverted transactions")
+    {
+        journal->revert(1);
+        journal->begin_transaction();
+        journal->set_property(node, "process_priority", 10);
+        CHECK(journal->get_transaction_count() == 2);
+        CHECK(journal->get_applied_count() == 2);
+        CHECK(journal->replay() == 0);
+
+        journal->revert();
+        CHECK(node->get_process_priority() == 0);
+    }
+
+    memdelete(node);
+}
+
+TEST_CASE("[SceneTree][DataDrivenLogic] ActionJournal keeps object identity")
+{
+    Node *node = memnew(Node);
+    Node *child = memnew(Node);
+    node->add_child(child);
+    child->set_owner(node);
+
+    Ref<ActionJournal> journal;
+    journal.instantiate();
+    journal->set_property(child, "owner", Variant());
+    CHECK(child->get_owner() == nullptr);
+
+    journal->revert();
+    CHECK(child->get_owner() == node);
+
+    memdelete(node);
+}
+
+TEST_CASE("[SceneTree][DataDrivenLogic] Actions record into the context journal")
+{
+    Node *node = memnew(Node);
+
+    Ref<ActionJournal> journal;
+    journal.instantiate();
+    Ref<ExecutionContext> context;
+    context.instantiate();
+    context->set_root(node);
+    context->set_journal(journal);
+
+    TypedArray<Action> actions;
+    actions.push_back(make_set_property("process_priority", 4));
+    actions.push_back(make_set_property("process_physics_priority", 8));
+    Ref<ActionSequence> sequence;
+    sequence.instantiate();
+    sequence->set_actions(actions);
+
+    SUBCASE("Virtual execution")
+    {
+        sequence->execute(context);
+    }
+
+    SUBCASE("Compiled execution")
+    {
+        Ref<ActionProgram> program;
+        program.instantiate();
+        REQUIRE(program->compile(sequence) == OK);
+        program->execute(context);
+    }
+
+    CHECK(node->get_process_priority() == 4);
+    CHECK(node->get_physics_process_priority() == 8);
+    CHECK(journal->get_transaction_count() == 1);
+    CHECK(journal->get_change_count() == 2);
+
+    journal->revert();
+    CHECK(node->get_process_priority() == 0);
+    CHECK(node->get_physics_process_priority() == 0);
+
+    memdelete(node);
+}
+
+TEST_CASE("[SceneTree][DataDrivenLogic] Each virtual action execution opens a transaction")
+{
+    Node *node = memnew(Node);
+
+    Ref<ActionJournal> journal;
+    journal.instantiate();
+    Ref<ExecutionContext> context;
+    context.instantiate();
+    context->set_root(node);
+    context->set_journal(journal);
+
+    make_set_property("process_priority", 4)->execute(context);
+
+    TypedArray<Action> actions;
+    actions.push_back(make_set_property("process_priority", 6));
+    actions.push_back(make_set_property("process_physics_priority", 8));
+    Ref<ActionSequence> sequence;
+    sequence.instantiate();
+    sequence->set_actions(actions);
+    sequence->execute(context);
+
+    CHECK(journal->get_transaction_count() == 2);
+    CHECK(journal->get_change_count() == 3);
+
+    // Only the sequence is reverted, the first action belongs to its own transaction.
+    CHECK(journal->revert(1) == 1);
+    CHECK(node->get_process_priority() == 4);
+    CHECK(node->get_physics_process_priority() == 0);
+
+    memdelete(node);
+}
+
+} // namespace TestActionJournal
+
+#endif // TEST_ACTION_JOURNAL_H
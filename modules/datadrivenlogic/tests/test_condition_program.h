@@ -0,0 +1,453 @@
+#ifndef TEST_CONDITION_PROGRAM_H
+#define TEST_CONDITION_PROGRAM_H
+
+#include "modules/datadrivenlogic/actions/builtinactions.h"
+#include "modules/datadrivenlogic/compiler/actionprogram.h"
+#include "modules/datadrivenlogic/compiler/conditionprogram.h"
+#include "modules/datadrivenlogic/conditions/builtinconditions.h"
+
+#include "core/os/os.h"
+#include "modules/modules_enabled.gen.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#ifdef MODULE_GDSCRIPT_ENABLED
+#include "modules/gdscript/gdscript.h"
+#endif
+
+#include "tests/test_macros.h"
+
+namespace TestConditionProgram
+{
+
+// A native condition the compiler does not know about. It reports itself as
+// thread-safe, but verify() still writes the shared verification state.
+class ThreadSafeNativeCondition : public Condition
+{
+    GDCLASS(ThreadSafeNativeCondition, Condition);
+
+public:
+    virtual void _verify(Ref<ExecutionContext> context) override
+    {
+        set_is_verified(context->get_root() && context->get_root()->get_process_priority() == 10);
+    }
+
+    virtual bool _is_thread_safe() const override
+    {
+        return true;
+    }
+};
+
+static Ref<ConditionPropertyCompare> make_priority_compare(ConditionPropertyCompare::CompareOperator p_operator, int p_value)
+{
+    Ref<ConditionPropertyCompare> compare;
+    compare.instantiate();
+    compare->set_property("process_priority");
+    compare->set_compare_operator(p_operator);
+    compare->set_value(p_value);
+    return compare;
+}
+
+static Ref<ConditionConstant> make_constant(bool p_value)
+{
+    Ref<ConditionConstant> constant;
+    constant.instantiate();
+    constant->set_value(p_value);
+    return constant;
+}
+
+// (priority > 5 and not false) and (priority == 10 or priority < 0 or false)
+static Ref<Condition> make_condition_tree()
+{
+    Ref<ConditionNot> negation;
+    negation.instantiate();
+    negation->set_condition(make_constant(false));
+
+    TypedArray<Condition> any_children;
+    any_children.push_back(make_priority_compare(ConditionPropertyCompare::COMPARE_EQUAL, 10));
+    any_children.push_back(make_priority_compare(ConditionPropertyCompare::COMPARE_LESS, 0));
+    any_children.push_back(make_constant(false));
+    Ref<ConditionAny> any;
+    any.instantiate();
+    any->set_conditions(any_children);
+
+    TypedArray<Condition> all_children;
+    all_children.push_back(make_priority_compare(ConditionPropertyCompare::COMPARE_GREATER, 5));
+    all_children.push_back(negation);
+    all_children.push_back(any);
+    Ref<ConditionAll> all;
+    all.instantiate();
+    all->set_conditions(all_children);
+    return all;
+}
+
+TEST_CASE("[SceneTree][DataDrivenLogic] ConditionProgram matches virtual evaluation")
+{
+    Node *node = memnew(Node);
+    Ref<ExecutionContext> context;
+    context.instantiate();
+    context->set_root(node);
+
+    Ref<Condition> root = make_condition_tree();
+    Ref<ConditionProgram> program;
+    program.instantiate();
+    REQUIRE(program->compile(root) == OK);
+    CHECK(program->is_compiled());
+    CHECK(program->get_virtual_count() == 0);
+
+    const int priorities[] = { -3, 0, 5, 6, 10, 11 };
+    for (int priority : priorities)
+    {
+        node->set_process_priority(priority);
+        CHECK_MESSAGE(program->evaluate(context) == root->verify(context), vformat("Mismatch for priority %d.", priority));
+    }
+
+    node->set_process_priority(10);
+    CHECK(program->evaluate(context));
+    node->set_process_priority(6);
+    CHECK_FALSE(program->evaluate(context));
+
+    memdelete(node);
+}
+
+TEST_CASE("[SceneTree][DataDrivenLogic] ConditionProgram edge cases")
+{
+    Node *node = memnew(Node);
+    Ref<ExecutionContext> context;
+    context.instantiate();
+    context->set_root(node);
+
+    Ref<ConditionProgram> program;
+    program.instantiate();
+
+    SUBCASE("Empty composites")
+    {
+        Ref<ConditionAll> all;
+        all.instantiate();
+        REQUIRE(program->compile(all) == OK);
+        CHECK(program->evaluate(context));
+
+        Ref<ConditionAny> any;
+        any.instantiate();
+        REQUIRE(program->compile(any) == OK);
+        CHECK_FALSE(program->evaluate(context));
+    }
+
+    SUBCASE("Missing target node")
+    {
+        Ref<ConditionPropertyCompare> compare = make_priority_compare(ConditionPropertyCompare::COMPARE_EQUAL, 0);
+        compare->set_node_index(3);
+        REQUIRE(program->compile(compare) == OK);
+        CHECK_FALSE(program->evaluate(context));
+        CHECK_FALSE(compare->verify(context));
+    }
+
+    SUBCASE("Unknown conditions fall back to virtual dispatch")
+    {
+        Ref<Condition> base;
+        base.instantiate();
+        REQUIRE(program->compile(base) == OK);
+        CHECK(program->get_virtual_count() == 1);
+    }
+
+    memdelete(node);
+}
+
+TEST_CASE("[SceneTree][DataDrivenLogic] ActionProgram flattens sequences")
+{
+    Node *node = memnew(Node);
+    Ref<ExecutionContext> context;
+    context.instantiate();
+    context->set_root(node);
+
+    Ref<ActionSetProperty> first;
+    first.instantiate();
+    first->set_property("process_priority");
+    first->set_value(3);
+
+    Ref<ActionSetProperty> second;
+    second.instantiate();
+    second->set_property("process_physics_priority");
+    second->set_value(7);
+
+    TypedArray<Action> inner_actions;
+    inner_actions.push_back(second);
+    Ref<ActionSequence> inner;
+    inner.instantiate();
+    inner->set_actions(inner_actions);
+
+    TypedArray<Action> outer_actions;
+    outer_actions.push_back(first);
+    outer_actions.push_back(inner);
+    Ref<ActionSequence> outer;
+    outer.instantiate();
+    outer->set_actions(outer_actions);
+
+    Ref<ActionProgram> program;
+    program.instantiate();
+    REQUIRE(program->compile(outer) == OK);
+    CHECK(program->get_instruction_count() == 2);
+    CHECK(program->get_virtual_count() == 0);
+
+    program->execute(context);
+    CHECK(node->get_process_priority() == 3);
+    CHECK(node->get_physics_process_priority() == 7);
+
+    memdelete(node);
+}
+
+TEST_CASE("[SceneTree][DataDrivenLogic] ConditionProgram batch evaluation")
+{
+    const int count = 300;
+
+    LocalVector<Node *> nodes;
+    TypedArray<ExecutionContext> contexts;
+    for (int i = 0; i < count; i++)
+    {
+        Node *node = memnew(Node);
+        node->set_process_priority(i % 3 == 0 ? 10 : i % 12);
+        nodes.push_back(node);
+
+        Ref<ExecutionContext> context;
+        context.instantiate();
+        context->set_root(node);
+        contexts.push_back(context);
+    }
+
+    Ref<ConditionProgram> program;
+    program.instantiate();
+    REQUIRE(program->compile(make_condition_tree()) == OK);
+    CHECK(program->is_thread_safe());
+
+    PackedByteArray bits = program->evaluate_batch(contexts);
+    REQUIRE(bits.size() == (count + 7) / 8);
+
+    bool all_match = true;
+    for (int i = 0; i < count; i++)
+    {
+        const bool bit = (bits[i >> 3] >> (i & 7)) & 1;
+        all_match = all_match && bit == program->evaluate(contexts[i]);
+    }
+    CHECK(all_match);
+
+    SUBCASE("Programs with thread-unsafe leaves run serially")
+    {
+        Ref<Condition> base;
+        base.instantiate();
+        CHECK_FALSE(base->is_thread_safe());
+
+        TypedArray<Condition> children;
+        children.push_back(make_condition_tree());
+        children.push_back(base);
+        Ref<ConditionAny> any;
+        any.instantiate();
+        any->set_conditions(children);
+        CHECK_FALSE(any->is_thread_safe());
+
+        REQUIRE(program->compile(any) == OK);
+        CHECK_FALSE(program->is_thread_safe());
+        CHECK(program->evaluate_batch(contexts) == bits);
+    }
+
+    SUBCASE("Unknown native leaves run serially")
+    {
+        Ref<ThreadSafeNativeCondition> native;
+        native.instantiate();
+        CHECK(native->is_thread_safe());
+
+        TypedArray<Condition> children;
+        children.push_back(make_condition_tree());
+        children.push_back(native);
+        Ref<ConditionAll> all;
+        all.instantiate();
+        all->set_conditions(children);
+
+        REQUIRE(program->compile(all) == OK);
+        CHECK(program->get_virtual_count() == 1);
+        CHECK_FALSE(program->is_thread_safe());
+
+        PackedByteArray native_bits = program->evaluate_batch(contexts);
+        bool native_match = true;
+        for (int i = 0; i < count; i++)
+        {
+            const bool bit = (native_bits[i >> 3] >> (i & 7)) & 1;
+            native_match = native_match && bit == (nodes[i]->get_process_priority() == 10);
+        }
+        CHECK(native_match);
+    }
+
+    SUBCASE("Properties of nodes inside the tree are read on the calling thread")
+    {
+        CHECK_FALSE(make_priority_compare(ConditionPropertyCompare::COMPARE_EQUAL, 10)->is_thread_safe());
+
+        Window *root = SceneTree::get_singleton()->get_root();
+        for (int i = 0; i < count; i += 2)
+        {
+            root->add_child(nodes[i]);
+        }
+
+        CHECK(program->is_thread_safe());
+        CHECK(program->evaluate_batch(contexts) == bits);
+
+        for (int i = 0; i < count; i += 2)
+        {
+            root->remove_child(nodes[i]);
+        }
+    }
+
+    for (Node *node : nodes)
+    {
+        memdelete(node);
+    }
+}
+
+#ifdef MODULE_GDSCRIPT_ENABLED
+// Mirrors the built-in conditions so that every node of a tree goes through
+// the script-virtual _verify override.
+static const char *script_condition_source = R"(
+extends Condition
+
+enum { ALL, ANY, NOT, CONSTANT, EQUAL, LESS, GREATER }
+
+var kind := CONSTANT
+var operand := 0
+var children := []
+
+func _verify(context: ExecutionContext) -> void:
+	var result := false
+	match kind:
+		ALL:
+			result = true
+			for child in children:
+				if not child.verify(context):
+					result = false
+					break
+		ANY:
+			for child in children:
+				if child.verify(context):
+					result = true
+					break
+		NOT:
+			result = not children[0].verify(context)
+		CONSTANT:
+			result = operand != 0
+		EQUAL:
+			result = context.get_root().process_priority == operand
+		LESS:
+			result = context.get_root().process_priority < operand
+		GREATER:
+			result = context.get_root().process_priority > operand
+	set_is_verified(result)
+)";
+
+enum ScriptConditionKind
+{
+    SCRIPT_ALL,
+    SCRIPT_ANY,
+    SCRIPT_NOT,
+    SCRIPT_CONSTANT,
+    SCRIPT_EQUAL,
+    SCRIPT_LESS,
+    SCRIPT_GREATER,
+};
+
+static Ref<Condition> make_script_condition(const Ref<GDScript> &p_script, ScriptConditionKind p_kind, int p_operand = 0, const Array &p_children = Array())
+{
+    Ref<Condition> condition;
+    condition.instantiate();
+    condition->set_script(p_script);
+    condition->set("kind", p_kind);
+    condition->set("operand", p_operand);
+    condition->set("children", p_children);
+    return condition;
+}
+
+// Same tree as make_condition_tree(), with every node implemented in script.
+static Ref<Condition> make_script_condition_tree(const Ref<GDScript> &p_script)
+{
+    Array not_children;
+    not_children.push_back(make_script_condition(p_script, SCRIPT_CONSTANT, 0));
+
+    Array any_children;
+    any_children.push_back(make_script_condition(p_script, SCRIPT_EQUAL, 10));
+    any_children.push_back(make_script_condition(p_script, SCRIPT_LESS, 0));
+    any_children.push_back(make_script_condition(p_script, SCRIPT_CONSTANT, 0));
+
+    Array all_children;
+    all_children.push_back(make_script_condition(p_script, SCRIPT_GREATER, 5));
+    all_children.push_back(make_script_condition(p_script, SCRIPT_NOT, 0, not_children));
+    all_children.push_back(make_script_condition(p_script, SCRIPT_ANY, 0, any_children));
+    return make_script_condition(p_script, SCRIPT_ALL, 0, all_children);
+}
+
+// Compares the compiled program with the script-virtual dispatch path it replaces,
+// and with the built-in tree evaluated through verify().
+// Run with `--test --no-skip --test-case="*Benchmark*"`.
+TEST_CASE("[SceneTree][DataDrivenLogic][Benchmark] ConditionProgram evaluations per second" * doctest::skip())
+{
+    const int iterations = 200000;
+
+    Node *node = memnew(Node);
+    node->set_process_priority(10);
+    Ref<ExecutionContext> context;
+    context.instantiate();
+    context->set_root(node);
+
+    Ref<GDScript> script;
+    script.instantiate();
+    script->set_source_code(script_condition_source);
+    ERR_PRINT_OFF;
+    const Error error = script->reload();
+    ERR_PRINT_ON;
+    REQUIRE(error == OK);
+
+    Ref<Condition> script_root = make_script_condition_tree(script);
+    REQUIRE(script_root->is_script_overridden());
+
+    Ref<Condition> root = make_condition_tree();
+    Ref<ConditionProgram> program;
+    program.instantiate();
+    REQUIRE(program->compile(root) == OK);
+
+    const int priorities[] = { -3, 0, 5, 6, 10, 11 };
+    for (int priority : priorities)
+    {
+        node->set_process_priority(priority);
+        CHECK_MESSAGE(script_root->verify(context) == program->evaluate(context), vformat("Mismatch for priority %d.", priority));
+    }
+    node->set_process_priority(10);
+
+    int verified = 0;
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < iterations; i++)
+    {
+        verified += script_root->verify(context) ? 1 : 0;
+    }
+    const uint64_t script_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+    begin = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < iterations; i++)
+    {
+        verified += root->verify(context) ? 1 : 0;
+    }
+    const uint64_t native_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+    begin = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < iterations; i++)
+    {
+        verified += program->evaluate(context) ? 1 : 0;
+    }
+    const uint64_t compiled_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+    CHECK(verified == iterations * 3);
+    MESSAGE(vformat("Script dispatch: %d evaluations/s.", int64_t(iterations * 1000000.0 / script_usec)));
+    MESSAGE(vformat("Native verify(): %d evaluations/s.", int64_t(iterations * 1000000.0 / native_usec)));
+    MESSAGE(vformat("Compiled program: %d evaluations/s (%.1fx script dispatch).", int64_t(iterations * 1000000.0 / compiled_usec), double(script_usec) / compiled_usec));
+
+    memdelete(node);
+}
+#endif // MODULE_GDSCRIPT_ENABLED
+
+} // namespace TestConditionProgram
+
+#endif // TEST_CONDITION_PROGRAM_H
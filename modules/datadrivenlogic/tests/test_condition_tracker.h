@@ -0,0 +1,137 @@
+#ifndef TEST_CONDITION_TRACKER_H
+#define TEST_CONDITION_TRACKER_H
+
+#include "modules/datadrivenlogic/conditions/builtinconditions.h"
+#include "modules/datadrivenlogic/tracking/conditiontracker.h"
+
+#include "tests/test_macros.h"
+
+namespace TestConditionTracker
+{
+
+TEST_CASE("[SceneTree][DataDrivenLogic] ConditionTracker only re-evaluates invalidated conditions")
+{
+    Node *node = memnew(Node);
+    Ref<ExecutionContext> context;
+    context.instantiate();
+    context->set_root(node);
+
+    Ref<ConditionPropertyCompare> compare;
+    compare.instantiate();
+    compare->set_property("process_priority");
+    compare->set_compare_operator(ConditionPropertyCompare::COMPARE_GREATER);
+    compare->set_value(5);
+
+    Ref<ConditionTracker> tracker;
+    tracker.instantiate();
+    const int id = tracker->track(compare, context);
+    REQUIRE(tracker->is_tracked(id));
+    CHECK(tracker->get_dirty_count() == 1);
+
+    CHECK(tracker->update() == 1);
+    CHECK_FALSE(tracker->is_verified(id));
+    CHECK(tracker->update() == 0);
+
+    node->set_process_priority(10);
+    tracker->notify_property_changed(node, "process_physics_priority");
+    CHECK(tracker->get_dirty_count() == 0);
+
+    SIGNAL_WATCH(tracker.ptr(), "verification_changed");
+    tracker->notify_property_changed(node, "process_priority");
+    CHECK(tracker->update() == 1);
+    CHECK(tracker->is_verified(id));
+    Array signal_args = { id, true };
+    Array args = { signal_args };
+    SIGNAL_CHECK("verification_changed", args);
+    SIGNAL_UNWATCH(tracker.ptr(), "verification_changed");
+
+    tracker->untrack(id);
+    CHECK_FALSE(tracker->is_tracked(id));
+    tracker->notify_property_changed(node, "process_priority");
+    CHECK(tracker->update() == 0);
+
+    memdelete(node);
+}
+
+TEST_CASE("[SceneTree][DataDrivenLogic] ConditionTracker does not queue re-tracked conditions twice")
+{
+    Node *node = memnew(Node);
+    Ref<ExecutionContext> context;
+    context.instantiate();
+    context->set_root(node);
+
+    Ref<ConditionPropertyCompare> compare;
+    compare.instantiate();
+    compare->set_property("process_priority");
+    compare->set_compare_operator(ConditionPropertyCompare::COMPARE_EQUAL);
+    compare->set_value(0);
+
+    Ref<ConditionTracker> tracker;
+    tracker.instantiate();
+    const int id = tracker->track(compare, context);
+    CHECK(tracker->get_dirty_count() == 1);
+
+    tracker->untrack(id);
+    CHECK(tracker->get_dirty_count() == 0);
+
+    const int retracked_id = tracker->track(compare, context);
+    CHECK(retracked_id == id);
+    CHECK(tracker->get_dirty_count() == 1);
+    CHECK(tracker->update() == 1);
+    CHECK(tracker->is_verified(retracked_id));
+    CHECK(tracker->get_dirty_count() == 0);
+
+    memdelete(node);
+}
+
+TEST_CASE("[SceneTree][DataDrivenLogic] ConditionTracker latches one-time verified conditions")
+{
+    Node *node = memnew(Node);
+    Ref<ExecutionContext> context;
+    context.instantiate();
+    context->set_root(node);
+
+    Ref<ConditionConstant> constant;
+    constant.instantiate();
+    CHECK(constant->is_one_time_verified());
+
+    Ref<ConditionTracker> tracker;
+    tracker.instantiate();
+    const int id = tracker->track(constant, context);
+    CHECK(tracker->update() == 1);
+    CHECK(tracker->is_verified(id));
+
+    tracker->invalidate_all();
+    CHECK(tracker->get_dirty_count() == 0);
+    CHECK(tracker->is_verified(id));
+
+    memdelete(node);
+}
+
+TEST_CASE("[SceneTree][DataDrivenLogic] ConditionTracker treats freed nodes as unverified")
+{
+    Node *node = memnew(Node);
+    Ref<ExecutionContext> context;
+    context.instantiate();
+    context->set_root(node);
+
+    Ref<ConditionPropertyCompare> compare;
+    compare.instantiate();
+    compare->set_property("process_priority");
+    compare->set_value(0);
+
+    Ref<ConditionTracker> tracker;
+    tracker.instantiate();
+    const int id = tracker->track(compare, context);
+    CHECK(tracker->update() == 1);
+    CHECK(tracker->is_verified(id));
+
+    memdelete(node);
+    tracker->invalidate(id);
+    CHECK(tracker->update() == 1);
+    CHECK_FALSE(tracker->is_verified(id));
+}
+
+} // namespace TestConditionTracker
+
+#endif // TEST_CONDITION_TRACKER_H
@@ -0,0 +1,104 @@
+#ifndef TEST_EXECUTION_CONTEXT_POOL_H
+#define TEST_EXECUTION_CONTEXT_POOL_H
+
+#include "modules/datadrivenlogic/contexts/executioncontextpool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestExecutionContextPool
+{
+
+TEST_CASE("[SceneTree][DataDrivenLogic] ExecutionContext detects freed nodes")
+{
+    Node *root = memnew(Node);
+    Node *node = memnew(Node);
+
+    Ref<ExecutionContext> context;
+    context.instantiate();
+    context->set_root(root);
+    context->append_node(node);
+    CHECK(context->get_node_count() == 1);
+    CHECK(context->get_target(-1) == root);
+    CHECK(context->get_target(0) == node);
+    CHECK(context->get_node(1) == nullptr);
+
+    memdelete(node);
+    CHECK(context->get_node(0) == nullptr);
+    CHECK(context->get_node_count() == 1);
+
+    memdelete(root);
+    CHECK(context->get_root() == nullptr);
+}
+
+TEST_CASE("[SceneTree][DataDrivenLogic] ExecutionContextPool recycles contexts")
+{
+    Node *node = memnew(Node);
+
+    Ref<ExecutionContextPool> pool;
+    pool.instantiate();
+    pool->reserve(4);
+    CHECK(pool->get_size() == 4);
+    CHECK(pool->get_free_count() == 4);
+
+    SUBCASE("Explicit release")
+    {
+        Ref<ExecutionContext> context = pool->acquire();
+        context->set_root(node);
+        context->append_node(node);
+        ExecutionContext *first = context.ptr();
+        CHECK(pool->get_free_count() == 3);
+
+        pool->release(context);
+        CHECK(pool->get_free_count() == 4);
+        CHECK(context->get_root() == nullptr);
+        CHECK(context->get_node_count() == 0);
+
+        ERR_PRINT_OFF;
+        pool->release(context);
+        ERR_PRINT_ON;
+        CHECK(pool->get_free_count() == 4);
+
+        context = pool->acquire();
+        CHECK(context.ptr() == first);
+    }
+
+    SUBCASE("Unreferenced contexts are reclaimed")
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            Ref<ExecutionContext> context = pool->acquire();
+            context->set_root(node);
+        }
+        CHECK(pool->get_size() == 4);
+    }
+
+    SUBCASE("Sweeps reclaiming few contexts grow the pool")
+    {
+        pool->reserve(16);
+        LocalVector<Ref<ExecutionContext>> held;
+        for (int i = 0; i < 15; i++)
+        {
+            held.push_back(pool->acquire());
+        }
+
+        // Only one context is ever unreferenced, so sweeping alone would run on every acquire.
+        pool->acquire();
+        pool->acquire();
+        CHECK(pool->get_size() > 16);
+        CHECK(pool->get_free_count() >= pool->get_size() / 4);
+    }
+
+    SUBCASE("Contexts outlive their pool")
+    {
+        Ref<ExecutionContext> context = pool->acquire();
+        pool.unref();
+        context->set_root(node);
+        CHECK(context->get_root() == node);
+    }
+
+    memdelete(node);
+}
+
+} // namespace TestExecutionContextPool
+
+#endif // TEST_EXECUTION_CONTEXT_POOL_H
@@ -0,0 +1,289 @@
+#include "conditiontracker.h"
+
+#include "core/io/resource.h"
+
+void ConditionTracker::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("track", "condition", "context"), &ConditionTracker::track);
+    ClassDB::bind_method(D_METHOD("untrack", "id"), &ConditionTracker::untrack);
+    ClassDB::bind_method(D_METHOD("is_tracked", "id"), &ConditionTracker::is_tracked);
+    ClassDB::bind_method(D_METHOD("is_verified", "id"), &ConditionTracker::is_verified);
+    ClassDB::bind_method(D_METHOD("notify_property_changed", "object", "property"), &ConditionTracker::notify_property_changed);
+    ClassDB::bind_method(D_METHOD("notify_object_changed", "object"), &ConditionTracker::notify_object_changed);
+    ClassDB::bind_method(D_METHOD("invalidate", "id"), &ConditionTracker::invalidate);
+    ClassDB::bind_method(D_METHOD("invalidate_all"), &ConditionTracker::invalidate_all);
+    ClassDB::bind_method(D_METHOD("update"), &ConditionTracker::update);
+    ClassDB::bind_method(D_METHOD("get_dirty_count"), &ConditionTracker::get_dirty_count);
+
+    ADD_SIGNAL(MethodInfo("verification_changed", PropertyInfo(Variant::INT, "id"), PropertyInfo(Variant::BOOL, "verified")));
+}
+
+ConditionTracker::ConditionTracker()
+{
+}
+
+ConditionTracker::~ConditionTracker()
+{
+    for (KeyValue<ObjectID, WatchedObject> &E : watched_objects)
+    {
+        if (!E.value.resource_connected)
+        {
+            continue;
+        }
+        Resource *resource = Object::cast_to<Resource>(ObjectDB::get_instance(E.key));
+        if (resource)
+        {
+            resource->disconnect_changed(callable_mp(this, &ConditionTracker::_on_resource_changed).bind(E.key));
+        }
+    }
+}
+
+int ConditionTracker::track(const Ref<Condition> &p_condition, const Ref<ExecutionContext> &p_context)
+{
+    ERR_FAIL_COND_V(p_condition.is_null(), -1);
+    ERR_FAIL_COND_V(p_context.is_null(), -1);
+
+    Ref<ConditionProgram> program;
+    program.instantiate();
+    if (program->compile(p_condition) != OK)
+    {
+        return -1;
+    }
+
+    uint32_t id;
+    if (free_ids.is_empty())
+    {
+        id = entries.size();
+        entries.resize(id + 1);
+    }
+    else
+    {
+        id = free_ids[free_ids.size() - 1];
+        free_ids.resize(free_ids.size() - 1);
+    }
+
+    Entry &entry = entries[id];
+    entry.program = program;
+    entry.context = p_context;
+    entry.dependencies.clear();
+    program->get_dependencies(p_context.ptr(), entry.dependencies);
+    entry.active = true;
+    entry.dirty = false;
+    entry.verified = false;
+    entry.one_time = p_condition->is_one_time_verified();
+
+    _watch(id);
+    _mark_dirty(id);
+    return id;
+}
+
+void ConditionTracker::untrack(int p_id)
+{
+    ERR_FAIL_COND(!is_tracked(p_id));
+
+    _unwatch(p_id);
+
+    Entry &entry = entries[p_id];
+    entry.program.unref();
+    entry.context.unref();
+    entry.dependencies.clear();
+    entry.active = false;
+    if (entry.dirty)
+    {
+        // Drop the pending slot, so a condition re-tracked under the same id is only
+        // queued once.
+        entry.dirty = false;
+        dirty.erase(p_id);
+    }
+    if (in_update)
+    {
+        for (uint32_t &id : updating)
+        {
+            if (id == (uint32_t)p_id)
+            {
+                id = UINT32_MAX;
+            }
+        }
+    }
+    free_ids.push_back(p_id);
+}
+
+bool ConditionTracker::is_tracked(int p_id) const
+{
+    return p_id >= 0 && p_id < (int)entries.size() && entries[p_id].active;
+}
+
+bool ConditionTracker::is_verified(int p_id) const
+{
+    ERR_FAIL_COND_V(!is_tracked(p_id), false);
+    return entries[p_id].verified;
+}
+
+void ConditionTracker::_mark_dirty(uint32_t p_id)
+{
+    Entry &entry = entries[p_id];
+    if (!entry.active || entry.dirty || (entry.one_time && entry.verified))
+    {
+        return;
+    }
+    entry.dirty = true;
+    dirty.push_back(p_id);
+}
+
+void ConditionTracker::_watch(uint32_t p_id)
+{
+    Entry &entry = entries[p_id];
+    for (const ConditionProgram::Dependency &dependency : entry.dependencies)
+    {
+        WatchedObject &watched = watched_objects[dependency.object];
+        if (watched.watches.is_empty() && !watched.resource_connected)
+        {
+            Resource *resource = Object::cast_to<Resource>(ObjectDB::get_instance(dependency.object));
+            if (resource)
+            {
+                resource->connect_changed(callable_mp(this, &ConditionTracker::_on_resource_changed).bind(dependency.object));
+                watched.resource_connected = true;
+            }
+        }
+        watched.watches.push_back({ dependency.property, p_id });
+    }
+    entry.watched = true;
+}
+
+void ConditionTracker::_unwatch(uint32_t p_id)
+{
+    Entry &entry = entries[p_id];
+    if (!entry.watched)
+    {
+        return;
+    }
+    entry.watched = false;
+
+    for (const ConditionProgram::Dependency &dependency : entry.dependencies)
+    {
+        HashMap<ObjectID, WatchedObject>::Iterator E = watched_objects.find(dependency.object);
+        if (!E)
+        {
+            continue;
+        }
+
+        LocalVector<Watch> &watches = E->value.watches;
+        for (uint32_t i = 0; i < watches.size(); i++)
+        {
+            if (watches[i].id == p_id)
+            {
+                watches.remove_at_unordered(i);
+                break;
+            }
+        }
+
+        if (watches.is_empty())
+        {
+            if (E->value.resource_connected)
+            {
+                Resource *resource = Object::cast_to<Resource>(ObjectDB::get_instance(dependency.object));
+                if (resource)
+                {
+                    resource->disconnect_changed(callable_mp(this, &ConditionTracker::_on_resource_changed).bind(dependency.object));
+                }
+            }
+            watched_objects.remove(E);
+        }
+    }
+}
+
+void ConditionTracker::notify_property_changed(Object *p_object, const StringName &p_property)
+{
+    ERR_FAIL_NULL(p_object);
+
+    HashMap<ObjectID, WatchedObject>::Iterator E = watched_objects.find(p_object->get_instance_id());
+    if (!E)
+    {
+        return;
+    }
+    for (const Watch &watch : E->value.watches)
+    {
+        if (watch.property == StringName() || watch.property == p_property)
+        {
+            _mark_dirty(watch.id);
+        }
+    }
+}
+
+void ConditionTracker::notify_object_changed(Object *p_object)
+{
+    ERR_FAIL_NULL(p_object);
+    _on_resource_changed(p_object->get_instance_id());
+}
+
+void ConditionTracker::_on_resource_changed(ObjectID p_object)
+{
+    HashMap<ObjectID, WatchedObject>::Iterator E = watched_objects.find(p_object);
+    if (!E)
+    {
+        return;
+    }
+    for (const Watch &watch : E->value.watches)
+    {
+        _mark_dirty(watch.id);
+    }
+}
+
+void ConditionTracker::invalidate(int p_id)
+{
+    ERR_FAIL_COND(!is_tracked(p_id));
+    _mark_dirty(p_id);
+}
+
+void ConditionTracker::invalidate_all()
+{
+    for (uint32_t i = 0; i < entries.size(); i++)
+    {
+        _mark_dirty(i);
+    }
+}
+
+int ConditionTracker::update()
+{
+    ERR_FAIL_COND_V_MSG(in_update, 0, "ConditionTracker::update() can't be called from a verification_changed handler.");
+    in_update = true;
+
+    // Conditions invalidated by verification_changed handlers are picked up by the next update.
+    SWAP(dirty, updating);
+
+    int evaluated = 0;
+    for (uint32_t i = 0; i < updating.size(); i++)
+    {
+        // Slots of conditions untracked by a handler are cleared by untrack().
+        const uint32_t id = updating[i];
+        if (id == UINT32_MAX)
+        {
+            continue;
+        }
+        Entry &entry = entries[id];
+        if (!entry.active || !entry.dirty)
+        {
+            continue;
+        }
+        entry.dirty = false;
+
+        const bool verified = entry.program->evaluate(entry.context);
+        evaluated++;
+        if (verified == entry.verified)
+        {
+            continue;
+        }
+
+        entry.verified = verified;
+        if (verified && entry.one_time)
+        {
+            _unwatch(id);
+        }
+        // Handlers may track new conditions, entries must not be referenced past this point.
+        emit_signal(SNAME("verification_changed"), id, verified);
+    }
+    updating.clear();
+    in_update = false;
+
+    return evaluated;
+}
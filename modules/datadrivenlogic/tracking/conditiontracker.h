@@ -0,0 +1,84 @@
+#ifndef CONDITIONTRACKER_H
+#define CONDITIONTRACKER_H
+
+#include "modules/datadrivenlogic/compiler/conditionprogram.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Incremental evaluation of conditions. Each tracked condition is compiled once
+// and only re-evaluated by update() after one of the objects or properties it
+// reads has been reported as changed, instead of being polled every frame.
+//
+// Property changes are reported with notify_property_changed() or
+// notify_object_changed(). Resources read by a condition are also watched
+// through their changed signal. One-time verified conditions are dropped from
+// the dependency graph once they have been verified.
+class ConditionTracker : public RefCounted
+{
+    GDCLASS(ConditionTracker, RefCounted);
+
+public:
+    ConditionTracker();
+    ~ConditionTracker();
+
+    // Returns an identifier for the tracked condition, or -1 if it failed to compile.
+    // The condition is evaluated by the next update().
+    int track(const Ref<Condition> &p_condition, const Ref<ExecutionContext> &p_context);
+    void untrack(int p_id);
+    bool is_tracked(int p_id) const;
+    bool is_verified(int p_id) const;
+
+    void notify_property_changed(Object *p_object, const StringName &p_property);
+    void notify_object_changed(Object *p_object);
+    void invalidate(int p_id);
+    void invalidate_all();
+
+    // Re-evaluates invalidated conditions, emitting verification_changed for those
+    // whose result changed. Returns the number of evaluated conditions.
+    int update();
+
+    int get_dirty_count() const { return dirty.size(); }
+
+protected:
+    static void _bind_methods();
+
+private:
+    struct Entry
+    {
+        Ref<ConditionProgram> program;
+        Ref<ExecutionContext> context;
+        LocalVector<ConditionProgram::Dependency> dependencies;
+        bool active = false;
+        bool dirty = false;
+        bool verified = false;
+        bool one_time = false;
+        bool watched = false;
+    };
+
+    struct Watch
+    {
+        StringName property;
+        uint32_t id = 0;
+    };
+
+    struct WatchedObject
+    {
+        LocalVector<Watch> watches;
+        bool resource_connected = false;
+    };
+
+    LocalVector<Entry> entries;
+    LocalVector<uint32_t> free_ids;
+    LocalVector<uint32_t> dirty;
+    LocalVector<uint32_t> updating;
+    bool in_update = false;
+    HashMap<ObjectID, WatchedObject> watched_objects;
+
+    void _mark_dirty(uint32_t p_id);
+    void _watch(uint32_t p_id);
+    void _unwatch(uint32_t p_id);
+    void _on_resource_changed(ObjectID p_object);
+};
+
+#endif // CONDITIONTRACKER_H
@@ -775,6 +775,8 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	// Scripts depending on this one may already have parsed and analyzed it through the cache.
+	Ref<GDScriptParserRef> cached_parser_ref;
 	{
 		String source_path = path;
 		if (source_path.is_empty()) {
@@ -797,6 +799,8 @@ Error GDScript::reload(bool p_keep_state) {
 					}
 					if (parser_ref->get_source_hash() != source_hash) {
 						GDScriptCache::remove_parser(source_path);
+					} else {
+						cached_parser_ref = parser_ref;
 					}
 				}
 			}
@@ -812,32 +816,49 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
-	GDScriptParser parser;
-	Error err;
-	if (!binary_tokens.is_empty()) {
-		err = parser.parse_binary(binary_tokens, path);
-	} else {
-		err = parser.parse(source, path, false);
-	}
-	if (err) {
-		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+	GDScriptInlineCache::invalidate_all();
+	GDScriptParser local_parser;
+	GDScriptParser *parser = &local_parser;
+	Error err = FAILED;
+	if (cached_parser_ref.is_valid()) {
+		// Reuse the cached analysis instead of parsing and analyzing the same source a second time.
+		// Other scripts share this parser, so raise it under the cache lock, like GDScriptCache::get_parser() does.
+		MutexLock lock(GDScriptCache::mutex);
+		err = cached_parser_ref->raise_status(GDScriptParserRef::FULLY_SOLVED);
+		if (err == OK) {
+			err = cached_parser_ref->get_analyzer()->resolve_dependencies();
+		}
+		if (err == OK) {
+			parser = cached_parser_ref->get_parser();
+		}
+	}
+	if (err != OK) {
+		// Not cached, or the cached analysis failed: parse again so the errors are reported from here.
+		if (!binary_tokens.is_empty()) {
+			err = parser->parse_binary(binary_tokens, path);
+		} else {
+			err = parser->parse(source, path, false);
+		}
+		if (err) {
+			if (EngineDebugger::is_active()) {
+				GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser->get_errors().front()->get().line, "Parser Error: " + parser->get_errors().front()->get().message);
+			}
+			// TODO: Show all error messages.
+			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser->get_errors().front()->get().line, ("Parse Error: " + parser->get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+			reloading = false;
+			return ERR_PARSE_ERROR;
 		}
-		// TODO: Show all error messages.
-		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser.get_errors().front()->get().line, ("Parse Error: " + parser.get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
-		reloading = false;
-		return ERR_PARSE_ERROR;
-	}
 
-	GDScriptAnalyzer analyzer(&parser);
-	err = analyzer.analyze();
+		GDScriptAnalyzer analyzer(parser);
+		err = analyzer.analyze();
+	}
 
 	if (err) {
 		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser->get_errors().front()->get().line, "Parser Error: " + parser->get_errors().front()->get().message);
 		}
 
-		const List<GDScriptParser::ParserError>::Element *e = parser.get_errors().front();
+		const List<GDScriptParser::ParserError>::Element *e = parser->get_errors().front();
 		while (e != nullptr) {
 			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), e->get().line, ("Parse Error: " + e->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
 			e = e->next();
@@ -846,10 +867,10 @@ Error GDScript::reload(bool p_keep_state) {
 		return ERR_PARSE_ERROR;
 	}
 
-	can_run = ScriptServer::is_scripting_enabled() || parser.is_tool();
+	can_run = ScriptServer::is_scripting_enabled() || parser->is_tool();
 
 	GDScriptCompiler compiler;
-	err = compiler.compile(&parser, this, p_keep_state);
+	err = compiler.compile(parser, this, p_keep_state);
 
 	if (err) {
 		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), compiler.get_error_line(), ("Compile Error: " + compiler.get_error()).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
@@ -868,11 +889,11 @@ Error GDScript::reload(bool p_keep_state) {
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
-	GDScriptDocGen::generate_docs(this, parser.get_tree());
+	GDScriptDocGen::generate_docs(this, parser->get_tree());
 #endif
 
 #ifdef DEBUG_ENABLED
-	for (const GDScriptWarning &warning : parser.get_warnings()) {
+	for (const GDScriptWarning &warning : parser->get_warnings()) {
 		if (EngineDebugger::is_active()) {
 			Vector<ScriptLanguage::StackInfo> si;
 			EngineDebugger::get_script_debugger()->send_error("", get_script_path(), warning.start_line, warning.get_name(), warning.get_message(), false, ERR_HANDLER_WARNING, si);
@@ -1570,6 +1591,7 @@ void GDScript::clear(ClearData *p_clear_data) {
 		clear_data->functions.insert(E.value);
 	}
 	member_functions.clear();
+	GDScriptInlineCache::invalidate_all();
 
 	for (KeyValue<StringName, MemberInfo> &E : member_indices) {
 		clear_data->scripts.insert(E.value.data_type.script_type_ref);
@@ -1650,6 +1672,9 @@ GDScript::~GDScript() {
 	}
 	destructing = true;
 
+	// A new script could be allocated at the same address, which cached call sites mustn't mistake for this one.
+	GDScriptInlineCache::invalidate_all();
+
 	if (is_print_verbose_enabled()) {
 		MutexLock lock(func_ptrs_to_update_mutex);
 		if (!func_ptrs_to_update.is_empty()) {
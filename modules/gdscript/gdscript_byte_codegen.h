@@ -94,6 +94,11 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	List<RBMap<StringName, int>> block_identifier_stack;
 	RBMap<StringName, int> block_identifiers;
 
+	// Last validated operator returning a bool, to fuse it with a conditional jump on its result.
+	int last_bool_operator_pos = -1;
+	Address last_bool_operator_target;
+
+	int inline_caches_count = 0;
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
@@ -376,6 +381,19 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(p_code);
 	}
 
+	// The caller appends the jump target after this.
+	void append_conditional_jump(GDScriptFunction::Opcode p_code, const Address &p_condition) {
+		if (fuse_conditional_jumps && last_bool_operator_pos >= 0 && last_bool_operator_pos + 5 == opcodes.size() && last_bool_operator_target.mode == p_condition.mode && last_bool_operator_target.address == p_condition.address) {
+			// Jump on the result of the operator just written: turn it into the fused opcode, which
+			// still stores the result and takes the jump target right after its own operands.
+			opcodes.write[last_bool_operator_pos] = p_code == GDScriptFunction::OPCODE_JUMP_IF ? GDScriptFunction::OPCODE_JUMP_IF_OPERATOR_VALIDATED : GDScriptFunction::OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED;
+			last_bool_operator_pos = -1;
+			return;
+		}
+		append_opcode(p_code);
+		append(p_condition);
+	}
+
 	void append_opcode_and_argcount(GDScriptFunction::Opcode p_code, int p_argument_count) {
 		opcodes.push_back(p_code);
 		opcodes.push_back(p_argument_count);
@@ -386,6 +404,10 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(p_code);
 	}
 
+	void append_inline_cache() {
+		append(inline_caches_count++);
+	}
+
 	void append(const Address &p_address) {
 		opcodes.push_back(address_of(p_address));
 	}
@@ -451,6 +473,8 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	}
 
 public:
+	static inline bool fuse_conditional_jumps = true; // Can be turned off to compare performance with separate opcodes.
+
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local_constant(const StringName &p_name, const Variant &p_constant) override;
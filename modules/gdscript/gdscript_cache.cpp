@@ -75,16 +75,7 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 				// It's ok if its the first thing done here.
 				get_parser()->clear();
 				status = PARSED;
-				String remapped_path = ResourceLoader::path_remap(path);
-				if (remapped_path.get_extension().to_lower() == "gdc") {
-					Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
-					source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
-					result = get_parser()->parse_binary(tokens, path);
-				} else {
-					String source = GDScriptCache::get_source_code(remapped_path);
-					source_hash = source.hash();
-					result = get_parser()->parse(source, path, false);
-				}
+				result = GDScriptCache::_parse_script(get_parser(), path, source_hash);
 			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
@@ -209,6 +200,19 @@ void GDScriptCache::remove_script(const String &p_path) {
 	singleton->full_gdscript_cache.erase(p_path);
 }
 
+Error GDScriptCache::_parse_script(GDScriptParser *p_parser, const String &p_path, uint32_t &r_source_hash) {
+	String remapped_path = ResourceLoader::path_remap(p_path);
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		Vector<uint8_t> tokens = get_binary_tokens(remapped_path);
+		r_source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+		return p_parser->parse_binary(tokens, p_path);
+	}
+
+	String source = get_source_code(remapped_path);
+	r_source_hash = source.hash();
+	return p_parser->parse(source, p_path, false);
+}
+
 Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptParserRef::Status p_status, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 	Ref<GDScriptParserRef> ref;
@@ -216,21 +220,48 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 		singleton->dependencies[p_owner].insert(p_path);
 		singleton->parser_inverse_dependencies[p_path].insert(p_owner);
 	}
-	if (singleton->parser_map.has(p_path)) {
-		ref = Ref<GDScriptParserRef>(singleton->parser_map[p_path]);
-		if (ref.is_null()) {
-			r_error = ERR_INVALID_DATA;
-			return ref;
-		}
-	} else {
+	if (!singleton->parser_map.has(p_path)) {
 		String remapped_path = ResourceLoader::path_remap(p_path);
 		if (!FileAccess::exists(remapped_path)) {
 			r_error = ERR_FILE_NOT_FOUND;
 			return ref;
 		}
-		ref.instantiate();
-		ref->path = p_path;
-		singleton->parser_map[p_path] = ref.ptr();
+
+		GDScriptParser *parser = nullptr;
+		uint32_t source_hash = 0;
+		Error result = OK;
+		if (p_status >= GDScriptParserRef::PARSED) {
+			// Parsing only concerns this script, so other threads are allowed to use the cache meanwhile.
+			// This only lifts the lock if the caller isn't holding it already.
+			parser = memnew(GDScriptParser);
+			lock.temp_unlock();
+			result = _parse_script(parser, p_path, source_hash);
+			lock.temp_relock();
+		}
+
+		if (singleton->parser_map.has(p_path)) {
+			// Another thread made this parser while the lock was lifted.
+			if (parser != nullptr) {
+				memdelete(parser);
+			}
+		} else {
+			ref.instantiate();
+			ref->path = p_path;
+			if (parser != nullptr) {
+				ref->parser = parser;
+				ref->status = GDScriptParserRef::PARSED;
+				ref->result = result;
+				ref->source_hash = source_hash;
+			}
+			singleton->parser_map[p_path] = ref.ptr();
+		}
+	}
+	if (ref.is_null()) {
+		ref = Ref<GDScriptParserRef>(singleton->parser_map[p_path]);
+		if (ref.is_null()) {
+			r_error = ERR_INVALID_DATA;
+			return ref;
+		}
 	}
 	r_error = ref->raise_status(p_status);
 
@@ -308,6 +339,19 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return singleton->shallow_gdscript_cache[p_path];
 	}
 
+	// Parse before taking the lock for good, so threads loading different scripts don't wait on each other's parsing.
+	Error parse_error = OK;
+	lock.temp_unlock();
+	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, parse_error);
+	lock.temp_relock();
+
+	if (singleton->full_gdscript_cache.has(p_path)) {
+		return singleton->full_gdscript_cache[p_path];
+	}
+	if (singleton->shallow_gdscript_cache.has(p_path)) {
+		return singleton->shallow_gdscript_cache[p_path];
+	}
+
 	const String remapped_path = ResourceLoader::path_remap(p_path);
 
 	Ref<GDScript> script;
@@ -327,7 +371,7 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+	r_error = parse_error;
 	if (r_error == OK) {
 		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
 	}
@@ -354,11 +398,17 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 	}
 
 	if (script.is_null()) {
+		lock.temp_unlock();
 		script = get_shallow_script(p_path, r_error);
+		lock.temp_relock();
 		// Only exit early if script failed to load, otherwise let reload report errors.
 		if (script.is_null()) {
 			return script;
 		}
+		if (singleton->full_gdscript_cache.has(p_path) && !p_update_from_disk) {
+			// Compiled by another thread while the lock was lifted.
+			return singleton->full_gdscript_cache[p_path];
+		}
 	}
 
 	const String remapped_path = ResourceLoader::path_remap(p_path);
@@ -2658,6 +2658,7 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 	parsing_classes.insert(p_script);
 
 	p_script->clearing = true;
+	GDScriptInlineCache::invalidate_all();
 
 	p_script->cancel_pending_functions(true);
 
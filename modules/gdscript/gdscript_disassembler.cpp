@@ -141,6 +141,49 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_JUMP_IF_OPERATOR_VALIDATED:
+			case OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED: {
+				text += _code_ptr[ip] == OPCODE_JUMP_IF_OPERATOR_VALIDATED ? "jump-if validated operator " : "jump-if-not validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr += 6;
+			} break;
+			case OPCODE_ADD_INT:
+			case OPCODE_SUBTRACT_INT:
+			case OPCODE_MULTIPLY_INT:
+			case OPCODE_ADD_FLOAT:
+			case OPCODE_SUBTRACT_FLOAT:
+			case OPCODE_MULTIPLY_FLOAT:
+			case OPCODE_DIVIDE_FLOAT:
+			case OPCODE_ADD_VECTOR3:
+			case OPCODE_SUBTRACT_VECTOR3:
+			case OPCODE_MULTIPLY_VECTOR3_FLOAT: {
+				static const char *operator_signs[] = { "+", "-", "*", "+", "-", "*", "/", "+", "-", "*" };
+				static const char *operand_types[] = { "int", "int", "int", "float", "float", "float", "float", "Vector3", "Vector3", "Vector3" };
+				const int index = _code_ptr[ip] - OPCODE_ADD_INT;
+
+				text += "typed operator ";
+				text += operand_types[index];
+				text += " ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_signs[index];
+				text += " ";
+				text += DADDR(2);
+
+				incr += 4;
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -308,7 +351,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -329,7 +372,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -708,7 +751,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
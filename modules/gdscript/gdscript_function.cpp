@@ -104,6 +104,38 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+// Starts at one, so that entries which were never written don't match.
+SafeNumeric<uint32_t> GDScriptInlineCache::epoch(1);
+
+void GDScriptInlineCache::store(uint32_t p_epoch, const void *p_script, const void *p_native_class, const Target &p_target) {
+	// Prefer replacing a stale entry, so polymorphic sites keep their live ones.
+	Entry *entry = nullptr;
+	for (Entry &E : entries) {
+		if (E.epoch.load(std::memory_order_relaxed) != p_epoch) {
+			entry = &E;
+			break;
+		}
+	}
+	if (entry == nullptr) {
+		entry = &entries[next_entry.fetch_add(1, std::memory_order_relaxed) % ENTRY_COUNT];
+	}
+
+	// Writers claim the entry by making its sequence odd. If another thread is writing it,
+	// this store is dropped, the site stores again on its next miss.
+	uint32_t sequence = entry->sequence.load(std::memory_order_relaxed);
+	if ((sequence & 1) || !entry->sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed)) {
+		return;
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+	entry->epoch.store(p_epoch, std::memory_order_relaxed);
+	entry->script.store(p_script, std::memory_order_relaxed);
+	entry->native_class.store(p_native_class, std::memory_order_relaxed);
+	entry->kind.store(p_target.kind, std::memory_order_relaxed);
+	entry->ptr.store(p_target.ptr, std::memory_order_relaxed);
+	entry->member_index.store(p_target.member_index, std::memory_order_relaxed);
+	entry->sequence.store(sequence + 2, std::memory_order_release);
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -117,6 +149,10 @@ GDScriptFunction::GDScriptFunction() {
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
 
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
+
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
 	}
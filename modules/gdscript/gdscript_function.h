@@ -251,11 +251,96 @@ public:
 	~GDScriptDataType() {}
 };
 
+// Per call site memory of what an untyped member access or method call resolved to,
+// keyed by the receiver's script and native class. Entries are seqlocked, as the same
+// function can run on several threads, and go stale as a whole when any script changes.
+struct GDScriptInlineCache {
+	enum Kind : uint32_t {
+		KIND_NONE,
+		KIND_SCRIPT_FUNCTION,
+		KIND_METHOD_BIND,
+		KIND_MEMBER,
+	};
+
+	struct Target {
+		Kind kind = KIND_NONE;
+		void *ptr = nullptr; // GDScriptFunction or MethodBind.
+		int member_index = -1;
+	};
+
+	static constexpr int ENTRY_COUNT = 2;
+
+	struct Entry {
+		std::atomic<uint32_t> sequence = 0; // Odd while the entry is being written.
+		std::atomic<uint32_t> epoch = 0;
+		std::atomic<const void *> script = nullptr;
+		std::atomic<const void *> native_class = nullptr;
+		std::atomic<uint32_t> kind = KIND_NONE;
+		std::atomic<void *> ptr = nullptr;
+		std::atomic<int> member_index = -1;
+	};
+
+	// Sites missing this many times in a row see more receiver types than there are entries,
+	// or ones that can't be cached at all. They stop probing and storing, see is_megamorphic().
+	static constexpr uint32_t MISS_LIMIT = 16;
+
+	Entry entries[ENTRY_COUNT];
+	std::atomic<uint32_t> next_entry = 0;
+	std::atomic<uint32_t> misses = 0;
+
+	static SafeNumeric<uint32_t> epoch;
+
+	// Any change to the members or functions of a script makes every cached entry stale.
+	static void invalidate_all() { epoch.increment(); }
+	// Read before resolving a target, so a change made meanwhile leaves the stored entry stale.
+	static uint32_t get_epoch() { return epoch.get(); }
+
+	_FORCE_INLINE_ bool is_megamorphic() const { return misses.load(std::memory_order_relaxed) >= MISS_LIMIT; }
+
+	// Racy on purpose, a few lost updates from other threads only delay the switch.
+	_FORCE_INLINE_ void add_miss() { misses.store(misses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+	_FORCE_INLINE_ void clear_misses() {
+		if (unlikely(misses.load(std::memory_order_relaxed) != 0)) {
+			misses.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	_FORCE_INLINE_ bool lookup(uint32_t p_epoch, const void *p_script, const void *p_native_class, Target &r_target) const {
+		for (const Entry &entry : entries) {
+			const uint32_t sequence = entry.sequence.load(std::memory_order_acquire);
+			if ((sequence & 1) || entry.epoch.load(std::memory_order_relaxed) != p_epoch ||
+					entry.script.load(std::memory_order_relaxed) != p_script || entry.native_class.load(std::memory_order_relaxed) != p_native_class) {
+				continue;
+			}
+			r_target.kind = Kind(entry.kind.load(std::memory_order_relaxed));
+			r_target.ptr = entry.ptr.load(std::memory_order_relaxed);
+			r_target.member_index = entry.member_index.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (entry.sequence.load(std::memory_order_relaxed) == sequence) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void store(uint32_t p_epoch, const void *p_script, const void *p_native_class, const Target &p_target);
+};
+
 class GDScriptFunction {
 public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_ADD_INT,
+		OPCODE_SUBTRACT_INT,
+		OPCODE_MULTIPLY_INT,
+		OPCODE_ADD_FLOAT,
+		OPCODE_SUBTRACT_FLOAT,
+		OPCODE_MULTIPLY_FLOAT,
+		OPCODE_DIVIDE_FLOAT,
+		OPCODE_ADD_VECTOR3,
+		OPCODE_SUBTRACT_VECTOR3,
+		OPCODE_MULTIPLY_VECTOR3_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -316,6 +401,8 @@ public:
 		OPCODE_JUMP,
 		OPCODE_JUMP_IF,
 		OPCODE_JUMP_IF_NOT,
+		OPCODE_JUMP_IF_OPERATOR_VALIDATED,
+		OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
 		OPCODE_RETURN,
@@ -518,6 +605,15 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// One per untyped named member access and method call site.
+	GDScriptInlineCache *_inline_caches_ptr = nullptr;
+	int _inline_caches_count = 0;
+
+	// Fast paths for the call sites above, returning false when the generic path must be taken instead.
+	static bool _call_cached(GDScriptInlineCache *p_cache, Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+	static bool _get_named_cached(GDScriptInlineCache *p_cache, Object *p_object, const StringName &p_name, Variant *r_value);
+	static bool _set_named_cached(GDScriptInlineCache *p_cache, Object *p_object, const StringName &p_name, const Variant *p_value);
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
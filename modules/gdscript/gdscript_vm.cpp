@@ -33,6 +33,7 @@
 #include "gdscript_lambda_callable.h"
 
 #include "core/os/os.h"
+#include "scene/scene_string_names.h"
 
 #ifdef DEBUG_ENABLED
 
@@ -185,6 +186,146 @@ String GDScriptFunction::_get_call_error(const String &p_where, const Variant **
 	return "Bug: Invalid call error code " + itos(p_err.error) + ".";
 }
 
+// Objects whose members and methods can be cached: either scriptless or with a GDScript instance.
+static _FORCE_INLINE_ bool _get_cacheable_instance(Object *p_object, GDScriptInstance *&r_instance) {
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (!script_instance) {
+		r_instance = nullptr;
+		return true;
+	}
+	if (script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+		return false;
+	}
+	r_instance = static_cast<GDScriptInstance *>(script_instance);
+	return true;
+}
+
+bool GDScriptFunction::_call_cached(GDScriptInlineCache *p_cache, Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	if (!p_object || p_cache->is_megamorphic()) {
+		return false;
+	}
+	// Same resolution as `Object::callp()`, minus the methods it treats specially.
+	if (p_method == CoreStringName(free_) || p_method == SceneStringName(_ready)) {
+		return false;
+	}
+	GDScriptInstance *instance = nullptr;
+	if (!_get_cacheable_instance(p_object, instance)) {
+		return false;
+	}
+	if (p_object->is_extension_instance()) {
+		return false; // Extensions can be reloaded, leaving their method binds dangling.
+	}
+	if (!instance && Object::cast_to<Script>(p_object)) {
+		return false; // Scripts dispatch their static functions in `callp()` first.
+	}
+	const void *script = instance ? instance->script.ptr() : nullptr;
+	const void *native_class = p_object->get_class_name().data_unique_pointer();
+
+	const uint32_t epoch = GDScriptInlineCache::get_epoch();
+	GDScriptInlineCache::Target target;
+	if (p_cache->lookup(epoch, script, native_class, target)) {
+		p_cache->clear_misses();
+	} else {
+		p_cache->add_miss();
+		for (GDScript *sptr = instance ? instance->script.ptr() : nullptr; sptr; sptr = sptr->_base) {
+			if (likely(sptr->valid)) {
+				HashMap<StringName, GDScriptFunction *>::Iterator E = sptr->member_functions.find(p_method);
+				if (E) {
+					target.kind = GDScriptInlineCache::KIND_SCRIPT_FUNCTION;
+					target.ptr = E->value;
+					break;
+				}
+			}
+		}
+		if (target.kind == GDScriptInlineCache::KIND_NONE) {
+			MethodBind *method = ClassDB::get_method(p_object->get_class_name(), p_method);
+			if (!method) {
+				return false;
+			}
+			target.kind = GDScriptInlineCache::KIND_METHOD_BIND;
+			target.ptr = method;
+		}
+		p_cache->store(epoch, script, native_class, target);
+	}
+
+#ifdef DEBUG_ENABLED
+	// Locked like in `Object::callp()`, so the object can't free itself during the call.
+	_ObjectDebugLock debug_lock(p_object);
+#endif
+	r_err.error = Callable::CallError::CALL_OK;
+	if (target.kind == GDScriptInlineCache::KIND_SCRIPT_FUNCTION) {
+		r_ret = static_cast<GDScriptFunction *>(target.ptr)->call(instance, p_args, p_argcount, r_err);
+	} else {
+		r_ret = static_cast<MethodBind *>(target.ptr)->call(p_object, p_args, p_argcount, r_err);
+	}
+	return true;
+}
+
+bool GDScriptFunction::_get_named_cached(GDScriptInlineCache *p_cache, Object *p_object, const StringName &p_name, Variant *r_value) {
+	GDScriptInstance *instance = nullptr;
+	if (!p_object || p_cache->is_megamorphic() || !_get_cacheable_instance(p_object, instance) || !instance) {
+		return false;
+	}
+	const GDScript *script = instance->script.ptr();
+
+	const uint32_t epoch = GDScriptInlineCache::get_epoch();
+	GDScriptInlineCache::Target target;
+	if (p_cache->lookup(epoch, script, nullptr, target)) {
+		p_cache->clear_misses();
+	} else {
+		p_cache->add_miss();
+		// Only plain members, see `GDScriptInstance::get()`.
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+		if (!E || E->value.getter) {
+			return false;
+		}
+		target.kind = GDScriptInlineCache::KIND_MEMBER;
+		target.member_index = E->value.index;
+		p_cache->store(epoch, script, nullptr, target);
+	}
+
+	if (unlikely(target.member_index >= instance->members.size())) {
+		return false;
+	}
+	// Copy first, the destination can be the variant holding the last reference to the object.
+	Variant value = instance->members[target.member_index];
+	*r_value = value;
+	return true;
+}
+
+bool GDScriptFunction::_set_named_cached(GDScriptInlineCache *p_cache, Object *p_object, const StringName &p_name, const Variant *p_value) {
+	GDScriptInstance *instance = nullptr;
+	if (!p_object || p_cache->is_megamorphic() || !_get_cacheable_instance(p_object, instance) || !instance) {
+		return false;
+	}
+	const GDScript *script = instance->script.ptr();
+
+	const uint32_t epoch = GDScriptInlineCache::get_epoch();
+	GDScriptInlineCache::Target target;
+	if (p_cache->lookup(epoch, script, nullptr, target)) {
+		p_cache->clear_misses();
+	} else {
+		p_cache->add_miss();
+		// Only untyped members without a setter, see `GDScriptInstance::set()`.
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+		if (!E || E->value.setter || E->value.data_type.has_type) {
+			return false;
+		}
+		target.kind = GDScriptInlineCache::KIND_MEMBER;
+		target.member_index = E->value.index;
+		p_cache->store(epoch, script, nullptr, target);
+	}
+
+	if (unlikely(target.member_index >= instance->members.size())) {
+		return false;
+	}
+#ifdef TOOLS_ENABLED
+	p_object->mark_edited(); // As `Object::set()` does.
+#endif
+	instance->members.write[target.member_index] = *p_value;
+	return true;
+}
+
 void (*type_init_function_table[])(Variant *) = {
 	nullptr, // NIL (shouldn't be called).
 	&VariantInitializer<bool>::init, // BOOL.
@@ -232,6 +373,16 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_ADD_INT,                                \
+		&&OPCODE_SUBTRACT_INT,                           \
+		&&OPCODE_MULTIPLY_INT,                           \
+		&&OPCODE_ADD_FLOAT,                              \
+		&&OPCODE_SUBTRACT_FLOAT,                         \
+		&&OPCODE_MULTIPLY_FLOAT,                         \
+		&&OPCODE_DIVIDE_FLOAT,                           \
+		&&OPCODE_ADD_VECTOR3,                            \
+		&&OPCODE_SUBTRACT_VECTOR3,                       \
+		&&OPCODE_MULTIPLY_VECTOR3_FLOAT,                 \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -292,6 +443,8 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP,                                   \
 		&&OPCODE_JUMP_IF,                                \
 		&&OPCODE_JUMP_IF_NOT,                            \
+		&&OPCODE_JUMP_IF_OPERATOR_VALIDATED,             \
+		&&OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED,         \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                   \
 		&&OPCODE_JUMP_IF_SHARED,                         \
 		&&OPCODE_RETURN,                                 \
@@ -816,6 +969,29 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_TYPED_OPERATOR(m_name, m_left_type, m_right_type, m_result_type, m_op)                                                                                \
+	OPCODE(OPCODE_##m_name) {                                                                                                                                        \
+		CHECK_SPACE(4);                                                                                                                                              \
+		GET_VARIANT_PTR(a, 0);                                                                                                                                       \
+		GET_VARIANT_PTR(b, 1);                                                                                                                                       \
+		GET_VARIANT_PTR(dst, 2);                                                                                                                                     \
+		*VariantGetInternalPtr<m_result_type>::get_ptr(dst) = *VariantGetInternalPtr<m_left_type>::get_ptr(a) m_op *VariantGetInternalPtr<m_right_type>::get_ptr(b); \
+		ip += 4;                                                                                                                                                     \
+	}                                                                                                                                                                \
+	DISPATCH_OPCODE
+
+			// Same as OPCODE_OPERATOR_VALIDATED for the most common typed arithmetic, but without calling the evaluator.
+			OPCODE_TYPED_OPERATOR(ADD_INT, int64_t, int64_t, int64_t, +);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_INT, int64_t, int64_t, int64_t, -);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_INT, int64_t, int64_t, int64_t, *);
+			OPCODE_TYPED_OPERATOR(ADD_FLOAT, double, double, double, +);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_FLOAT, double, double, double, -);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_FLOAT, double, double, double, *);
+			OPCODE_TYPED_OPERATOR(DIVIDE_FLOAT, double, double, double, /);
+			OPCODE_TYPED_OPERATOR(ADD_VECTOR3, Vector3, Vector3, Vector3, +);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_VECTOR3, Vector3, Vector3, Vector3, -);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_VECTOR3_FLOAT, Vector3, double, Vector3, *);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1160,7 +1336,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1170,8 +1346,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-				dst->set_named(*index, *value, valid);
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
+
+				bool valid = true;
+				if (dst->get_type() != Variant::OBJECT || !_set_named_cached(&_inline_caches_ptr[cache_index], dst->get_validated_object(), *index, value)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1192,7 +1373,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1212,7 +1393,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1222,6 +1403,14 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
+
+				if (src->get_type() == Variant::OBJECT && _get_named_cached(&_inline_caches_ptr[cache_index], src->get_validated_object(), *index, dst)) {
+					ip += 5;
+					DISPATCH_OPCODE;
+				}
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
@@ -1237,7 +1426,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1856,7 +2045,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1867,8 +2056,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_index = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
+				GDScriptInlineCache *cache = &_inline_caches_ptr[cache_index];
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
+				Object *base_obj = base->get_type() == Variant::OBJECT ? base->get_validated_object() : nullptr;
 
 #ifdef DEBUG_ENABLED
 				uint64_t call_time = 0;
@@ -1877,7 +2071,6 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					call_time = OS::get_singleton()->get_ticks_usec();
 				}
 				Variant::Type base_type = base->get_type();
-				Object *base_obj = base->get_validated_object();
 				StringName base_class = base_obj ? base_obj->get_class_name() : StringName();
 #endif
 
@@ -1885,7 +2078,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!_call_cached(cache, base_obj, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1914,7 +2109,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						}
 					}
 #endif
-				} else {
+				} else if (!_call_cached(cache, base_obj, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
 					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
@@ -1965,7 +2160,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2698,6 +2893,56 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_JUMP_IF_OPERATOR_VALIDATED) {
+				// OPCODE_OPERATOR_VALIDATED followed by the jump target, for an OPCODE_JUMP_IF on its result.
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				// Only fused when the operator returns a bool, so no need to booleanize.
+				if (*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED) {
+				// OPCODE_OPERATOR_VALIDATED followed by the jump target, for an OPCODE_JUMP_IF_NOT on its result.
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				// Only fused when the operator returns a bool, so no need to booleanize.
+				if (!*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
@@ -32,7 +32,14 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_byte_codegen.h"
+#include "../gdscript_cache.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace GDScriptTests {
 
@@ -69,6 +76,202 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+
+static void write_script_file(const String &p_path, const String &p_source) {
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_string(p_source);
+}
+
+TEST_CASE("[Modules][GDScript] Loading a script reuses the analysis of its dependents") {
+	const String dependency_path = TestUtils::get_temp_path("gdscript_cache_dependency.gd");
+	const String dependent_path = TestUtils::get_temp_path("gdscript_cache_dependent.gd");
+	write_script_file(dependency_path, R"(
+extends RefCounted
+
+func get_value():
+	return 1
+)");
+	write_script_file(dependent_path, R"(
+extends RefCounted
+
+const Dependency = preload("gdscript_cache_dependency.gd")
+
+func get_value():
+	return Dependency.new().get_value()
+)");
+
+	SUBCASE("A preloaded dependency is compiled from the parser its dependent analyzed") {
+		Error err = OK;
+		// Held from before, so it can be told apart from a parser made by a second parse.
+		Ref<GDScriptParserRef> dependency_parser = GDScriptCache::get_parser(dependency_path, GDScriptParserRef::EMPTY, err);
+		REQUIRE(dependency_parser.is_valid());
+
+		Ref<GDScript> dependent = GDScriptCache::get_full_script(dependent_path, err);
+		REQUIRE(err == OK);
+		REQUIRE(dependent.is_valid());
+		CHECK(GDScriptCache::get_cached_script(dependency_path).is_valid());
+		CHECK(dependency_parser->get_status() == GDScriptParserRef::FULLY_SOLVED);
+
+		Ref<RefCounted> object = memnew(RefCounted);
+		object->set_script(dependent);
+		CHECK(int(object->call("get_value")) == 1);
+	}
+
+	SUBCASE("A cached parser of a stale source is not reused") {
+		Error err = OK;
+		Ref<GDScriptParserRef> dependency_parser = GDScriptCache::get_parser(dependency_path, GDScriptParserRef::INTERFACE_SOLVED, err);
+		REQUIRE(err == OK);
+		REQUIRE(dependency_parser.is_valid());
+
+		// Changed on disk after it was parsed.
+		write_script_file(dependency_path, R"(
+extends RefCounted
+
+func get_value():
+	return 2
+)");
+		Ref<GDScript> dependency = GDScriptCache::get_full_script(dependency_path, err);
+		REQUIRE(err == OK);
+		REQUIRE(dependency.is_valid());
+		// Parsed again instead of raising the stale parser.
+		CHECK(dependency_parser->get_status() == GDScriptParserRef::INTERFACE_SOLVED);
+
+		Ref<RefCounted> object = memnew(RefCounted);
+		object->set_script(dependency);
+		CHECK(int(object->call("get_value")) == 2);
+	}
+
+	GDScriptCache::remove_script(dependent_path);
+	GDScriptCache::remove_script(dependency_path);
+	DirAccess::remove_absolute(dependent_path);
+	DirAccess::remove_absolute(dependency_path);
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Fused compare-and-jump opcodes" * doctest::skip()) {
+	const String source = R"(
+extends RefCounted
+
+func math_loop() -> int:
+	var total := 0
+	var i := 0
+	while i < 1000000:
+		if i % 3 == 0:
+			total += i
+		i += 1
+	return total
+
+func vector_math() -> Vector3:
+	var position := Vector3()
+	var velocity := Vector3(1, 2, 3)
+	for i in 1000000:
+		position += velocity * 0.01
+		if position.x > 10.0:
+			position = Vector3()
+	return position
+
+func array_iteration() -> int:
+	var values := PackedInt32Array()
+	values.resize(1000000)
+	var count := 0
+	for value: int in values:
+		if value >= 0 and value < 10:
+			count += 1
+	return count
+)";
+
+	const char *functions[] = { "math_loop", "vector_math", "array_iteration" };
+	uint64_t usec[2][std::size(functions)];
+	for (int fused = 0; fused < 2; fused++) {
+		// Only affects code generation, so compile the script again for each mode.
+		GDScriptByteCodeGenerator::fuse_conditional_jumps = fused == 1;
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(source);
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE(error == OK);
+
+		Ref<RefCounted> object = memnew(RefCounted);
+		object->set_script(gdscript);
+		for (uint32_t i = 0; i < std::size(functions); i++) {
+			const uint64_t start = OS::get_singleton()->get_ticks_usec();
+			object->call(functions[i]);
+			usec[fused][i] = OS::get_singleton()->get_ticks_usec() - start;
+		}
+	}
+	GDScriptByteCodeGenerator::fuse_conditional_jumps = true;
+
+	for (uint32_t i = 0; i < std::size(functions); i++) {
+		MESSAGE(vformat("%s: %d usec with separate opcodes, %d usec fused.", functions[i], usec[0][i], usec[1][i]));
+	}
+}
+
+// Writes scripts which each preload two scripts written before them, so loading them pulls in a dependency tree.
+static Vector<String> make_interdependent_scripts(const String &p_dir, int p_count) {
+	DirAccess::make_dir_recursive_absolute(p_dir);
+
+	Vector<String> paths;
+	for (int i = 0; i < p_count; i++) {
+		paths.push_back(p_dir.path_join(vformat("script_%d.gd", i)));
+	}
+
+	for (int i = 0; i < p_count; i++) {
+		String source = "extends RefCounted\n\n";
+		if (i > 0) {
+			source += vformat("const Parent = preload(\"%s\")\nconst Cousin = preload(\"%s\")\n\n", paths[(i - 1) / 2], paths[i / 3]);
+		}
+		source += vformat("var value: int = %d\n\nfunc compute(p_count: int) -> int:\n\tvar total := value\n\tfor i in p_count:\n\t\ttotal += i * %d\n\treturn total\n", i, i % 7 + 1);
+		if (i > 0) {
+			source += "\nfunc combine() -> int:\n\treturn Parent.new().compute(3) + Cousin.new().compute(2)\n";
+		}
+
+		Ref<FileAccess> file = FileAccess::open(paths[i], FileAccess::WRITE);
+		file->store_string(source);
+	}
+
+	return paths;
+}
+
+struct ScriptLoadBenchmark {
+	Vector<String> paths;
+
+	void load(uint32_t p_index, void *p_userdata) {
+		Error error = OK;
+		GDScriptCache::get_full_script(paths[p_index], error);
+	}
+};
+
+TEST_CASE("[Modules][GDScript][Benchmark] Load interdependent scripts serially and from worker threads" * doctest::skip()) {
+	const int count = 3000;
+
+	uint64_t usec[2];
+	for (int threaded = 0; threaded < 2; threaded++) {
+		ScriptLoadBenchmark benchmark;
+		benchmark.paths = make_interdependent_scripts(TestUtils::get_temp_path(vformat("gdscript_load_benchmark_%d", threaded)), count);
+
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		if (threaded) {
+			WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&benchmark, &ScriptLoadBenchmark::load, (void *)nullptr, count, -1, true);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		} else {
+			for (int i = 0; i < count; i++) {
+				benchmark.load(i, nullptr);
+			}
+		}
+		usec[threaded] = OS::get_singleton()->get_ticks_usec() - start;
+
+		for (const String &path : benchmark.paths) {
+			Ref<GDScript> script = GDScriptCache::get_cached_script(path);
+			CHECK(script.is_valid());
+			CHECK(script->is_valid());
+			GDScriptCache::remove_script(path);
+			DirAccess::remove_absolute(path);
+		}
+	}
+
+	MESSAGE(vformat("Loading %d scripts: %d usec serially, %d usec from worker threads.", count, usec[0], usec[1]));
+}
 #endif // TOOLS_ENABLED
 
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
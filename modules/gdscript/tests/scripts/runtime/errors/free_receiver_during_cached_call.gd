@@ -0,0 +1,12 @@
+#debug-only
+# Calls going through an inline cache lock the receiver like `Object::callp()` does.
+
+class Victim extends Node:
+	func release():
+		free()
+
+func test():
+	var objects = [Victim.new()]
+	for object in objects:
+		object.release()
+		object.free()
@@ -0,0 +1,39 @@
+# Typed comparisons followed by a branch on their result are compiled into fused
+# compare-and-jump opcodes, results must not change.
+
+func count_in_range(values: Array[int], low: int, high: int) -> int:
+	var count := 0
+	for value: int in values:
+		if value >= low and value < high:
+			count += 1
+	return count
+
+func test():
+	var values: Array[int] = []
+	for i in 50:
+		values.append(i)
+
+	var total := 0
+	for i in 100:
+		total += count_in_range(values, i % 10, 40)
+	print(total)
+
+	var i := 0
+	var evens := 0
+	var outside := 0
+	var x := 0.0
+	while i < 5000:
+		if i % 2 == 0:
+			evens += 1
+		if i > 4000 or i < 10:
+			outside += 1
+		x += 0.5 if i < 2500 else -0.25
+		i += 1
+	print(evens, " ", outside, " ", x)
+
+	var negated := 0
+	for j in 3000:
+		var low := j < 1500
+		if not low:
+			negated += 1
+	print(negated)
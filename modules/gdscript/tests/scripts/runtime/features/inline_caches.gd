@@ -0,0 +1,59 @@
+# Untyped member accesses and calls remember what they resolved to per receiver class.
+# Call sites seeing several classes, and script and native methods, must resolve each correctly.
+
+class A:
+	var value = 1
+
+	func describe():
+		return "A%d" % value
+
+class B:
+	var value = 2
+
+	func describe():
+		return "B%d" % value
+
+class C extends A:
+	func describe():
+		return "C" + super()
+
+func describe_new_instance(script):
+	var object = script.new()
+	return object.describe()
+
+func test():
+	var objects = [A.new(), B.new(), C.new(), A.new(), RefCounted.new()]
+	for i in 2:
+		var line = []
+		for object in objects:
+			if object.has_method("describe"):
+				line.append(object.describe())
+			else:
+				line.append(object.get_class())
+		print(line)
+
+	for i in 2:
+		for object in objects.slice(0, 4):
+			object.value += 10
+	print(objects.slice(0, 4).map(func(object): return object.value))
+
+	var node = Node.new()
+	for object in [node, A.new(), node]:
+		print(object.get_class())
+	node.free()
+
+	# More receiver classes than cache entries: the site stops caching, calls must still resolve.
+	var rotation = [A.new(), B.new(), C.new()]
+	var described = []
+	for i in 30:
+		described.append(rotation[i % 3].describe())
+	print(described.slice(27))
+
+	# Reloading a script frees its functions, cached ones must not be called afterwards.
+	var script = GDScript.new()
+	script.source_code = "extends RefCounted\n\nfunc describe():\n\treturn \"before reload\"\n"
+	script.reload()
+	print(describe_new_instance(script))
+	script.source_code = "extends RefCounted\n\nfunc describe():\n\treturn \"after reload\"\n"
+	script.reload()
+	print(describe_new_instance(script))
@@ -0,0 +1,19 @@
+# Typed int, float and Vector3 arithmetic uses dedicated opcodes.
+
+func test():
+	var a := 7
+	var b := 3
+	print(a + b, " ", a - b, " ", a * b)
+
+	var x := 7.5
+	var y := 2.5
+	print(x + y, " ", x - y, " ", x * y, " ", x / y)
+
+	var v := Vector3(1, 2, 3)
+	var w := Vector3(0.5, 0.5, 0.5)
+	print(v + w, " ", v - w, " ", v * 2.0)
+
+	var total := 0
+	for i in 10:
+		total = total * 2 + i - 1
+	print(total)
@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*  audio_mix_kernels.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "audio_mix_kernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIO_MIX_KERNELS_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define AUDIO_MIX_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+#include <cstring>
+
+static_assert(sizeof(AudioFrame) == 2 * sizeof(float), "AudioFrame must be two packed floats for the vector kernels.");
+
+// All vector paths process four frames (eight floats, two registers) per iteration.
+
+void AudioMixKernels::clear(AudioFrame *p_dst, int p_frames) {
+	if (p_frames > 0) {
+		memset((void *)p_dst, 0, sizeof(AudioFrame) * p_frames);
+	}
+}
+
+void AudioMixKernels::copy(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames) {
+	if (p_frames > 0) {
+		memcpy((void *)p_dst, (const void *)p_src, sizeof(AudioFrame) * p_frames);
+	}
+}
+
+void AudioMixKernels::scale(AudioFrame *p_dst, int p_frames, float p_gain) {
+	float *dst = &p_dst->left;
+	int i = 0;
+#if defined(AUDIO_MIX_KERNELS_SSE2)
+	const __m128 gain = _mm_set1_ps(p_gain);
+	for (; i + 4 <= p_frames; i += 4) {
+		float *d = dst + i * 2;
+		_mm_storeu_ps(d, _mm_mul_ps(_mm_loadu_ps(d), gain));
+		_mm_storeu_ps(d + 4, _mm_mul_ps(_mm_loadu_ps(d + 4), gain));
+	}
+#elif defined(AUDIO_MIX_KERNELS_NEON)
+	for (; i + 4 <= p_frames; i += 4) {
+		float *d = dst + i * 2;
+		vst1q_f32(d, vmulq_n_f32(vld1q_f32(d), p_gain));
+		vst1q_f32(d + 4, vmulq_n_f32(vld1q_f32(d + 4), p_gain));
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_dst[i] *= p_gain;
+	}
+}
+
+void AudioMixKernels::mix(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, float p_gain) {
+	float *dst = &p_dst->left;
+	const float *src = &p_src->left;
+	int i = 0;
+#if defined(AUDIO_MIX_KERNELS_SSE2)
+	const __m128 gain = _mm_set1_ps(p_gain);
+	for (; i + 4 <= p_frames; i += 4) {
+		float *d = dst + i * 2;
+		const float *s = src + i * 2;
+		_mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), _mm_mul_ps(_mm_loadu_ps(s), gain)));
+		_mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), _mm_mul_ps(_mm_loadu_ps(s + 4), gain)));
+	}
+#elif defined(AUDIO_MIX_KERNELS_NEON)
+	for (; i + 4 <= p_frames; i += 4) {
+		float *d = dst + i * 2;
+		const float *s = src + i * 2;
+		vst1q_f32(d, vmlaq_n_f32(vld1q_f32(d), vld1q_f32(s), p_gain));
+		vst1q_f32(d + 4, vmlaq_n_f32(vld1q_f32(d + 4), vld1q_f32(s + 4), p_gain));
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i] * p_gain;
+	}
+}
+
+void AudioMixKernels::mix_ramp(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, float p_gain, float p_gain_step) {
+	if (p_gain_step == 0.0f) {
+		mix(p_dst, p_src, p_frames, p_gain);
+		return;
+	}
+
+	// The gain is recomputed from the frame index instead of being accumulated,
+	// so long ramps do not drift away from the scalar result.
+	float *dst = &p_dst->left;
+	const float *src = &p_src->left;
+	int i = 0;
+#if defined(AUDIO_MIX_KERNELS_SSE2)
+	const __m128 gain = _mm_set1_ps(p_gain);
+	const __m128 step = _mm_set1_ps(p_gain_step);
+	const __m128 index_inc = _mm_set1_ps(4.0f);
+	__m128 index_a = _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);
+	__m128 index_b = _mm_setr_ps(2.0f, 2.0f, 3.0f, 3.0f);
+	for (; i + 4 <= p_frames; i += 4) {
+		float *d = dst + i * 2;
+		const float *s = src + i * 2;
+		const __m128 gain_a = _mm_add_ps(gain, _mm_mul_ps(step, index_a));
+		const __m128 gain_b = _mm_add_ps(gain, _mm_mul_ps(step, index_b));
+		_mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), _mm_mul_ps(_mm_loadu_ps(s), gain_a)));
+		_mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), _mm_mul_ps(_mm_loadu_ps(s + 4), gain_b)));
+		index_a = _mm_add_ps(index_a, index_inc);
+		index_b = _mm_add_ps(index_b, index_inc);
+	}
+#elif defined(AUDIO_MIX_KERNELS_NEON)
+	const float32x4_t gain = vdupq_n_f32(p_gain);
+	const float32x4_t index_inc = vdupq_n_f32(4.0f);
+	static const float index_init[8] = { 0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f };
+	float32x4_t index_a = vld1q_f32(index_init);
+	float32x4_t index_b = vld1q_f32(index_init + 4);
+	for (; i + 4 <= p_frames; i += 4) {
+		float *d = dst + i * 2;
+		const float *s = src + i * 2;
+		const float32x4_t gain_a = vmlaq_n_f32(gain, index_a, p_gain_step);
+		const float32x4_t gain_b = vmlaq_n_f32(gain, index_b, p_gain_step);
+		vst1q_f32(d, vmlaq_f32(vld1q_f32(d), vld1q_f32(s), gain_a));
+		vst1q_f32(d + 4, vmlaq_f32(vld1q_f32(d + 4), vld1q_f32(s + 4), gain_b));
+		index_a = vaddq_f32(index_a, index_inc);
+		index_b = vaddq_f32(index_b, index_inc);
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i] * (p_gain + p_gain_step * float(i));
+	}
+}
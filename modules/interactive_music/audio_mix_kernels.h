@@ -0,0 +1,50 @@
+/**************************************************************************/
+/*  audio_mix_kernels.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/audio_frame.h"
+
+// Block kernels shared by the interactive music playbacks to scale and
+// accumulate stereo frames. They use SSE2 or NEON when available and fall
+// back to scalar code otherwise. Buffers do not need any special alignment.
+class AudioMixKernels {
+public:
+	// p_dst[i] = AudioFrame(0, 0)
+	static void clear(AudioFrame *p_dst, int p_frames);
+	// p_dst[i] = p_src[i]
+	static void copy(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames);
+	// p_dst[i] *= p_gain
+	static void scale(AudioFrame *p_dst, int p_frames, float p_gain);
+	// p_dst[i] += p_src[i] * p_gain
+	static void mix(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, float p_gain);
+	// p_dst[i] += p_src[i] * (p_gain + p_gain_step * i)
+	static void mix_ramp(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, float p_gain, float p_gain_step);
+};
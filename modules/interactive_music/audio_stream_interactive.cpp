@@ -30,9 +30,12 @@
 
 #include "audio_stream_interactive.h"
 
+#include "audio_mix_kernels.h"
+
 #include "core/math/math_funcs.h"
 
 AudioStreamInteractive::AudioStreamInteractive() {
+	transition_table_entries.push_back(_resolve_transition(Transition()));
 }
 
 Ref<AudioStreamPlayback> AudioStreamInteractive::instantiate_playback() {
@@ -80,6 +83,8 @@ void AudioStreamInteractive::set_clip_count(int p_count) {
 	clip_count = p_count;
 	AudioServer::get_singleton()->unlock();
 
+	_update_transition_table();
+
 	notify_property_list_changed();
 	emit_signal(SNAME("parameter_list_changed"));
 }
@@ -173,6 +178,7 @@ int AudioStreamInteractive::get_clip_auto_advance_next_clip(int p_clip) const {
 // TRANSITIONS
 
 void AudioStreamInteractive::_set_transitions(const Dictionary &p_transitions) {
+	transition_table_deferred = true;
 	for (const KeyValue<Variant, Variant> &kv : p_transitions) {
 		Vector2i k = kv.key;
 		Dictionary data = kv.value;
@@ -190,6 +196,8 @@ void AudioStreamInteractive::_set_transitions(const Dictionary &p_transitions) {
 
 		add_transition(k.x, k.y, TransitionFromTime(int(data["from_time"])), TransitionToTime(int(data["to_time"])), FadeMode(int(data["fade_mode"])), data["fade_beats"], use_filler_clip, filler_clip, hold_previous);
 	}
+	transition_table_deferred = false;
+	_update_transition_table();
 }
 
 Dictionary AudioStreamInteractive::_get_transitions() const {
@@ -231,6 +239,8 @@ void AudioStreamInteractive::erase_transition(int p_from_clip, int p_to_clip) {
 	AudioDriver::get_singleton()->lock();
 	transition_map.erase(tk);
 	AudioDriver::get_singleton()->unlock();
+
+	_update_transition_table();
 }
 
 PackedInt32Array AudioStreamInteractive::get_transition_list() const {
@@ -264,6 +274,76 @@ void AudioStreamInteractive::add_transition(int p_from_clip, int p_to_clip, Tran
 	AudioDriver::get_singleton()->lock();
 	transition_map[tk] = tr;
 	AudioDriver::get_singleton()->unlock();
+
+	_update_transition_table();
+}
+
+AudioStreamInteractive::Transition AudioStreamInteractive::_resolve_transition(const Transition &p_transition) {
+	Transition transition = p_transition;
+	if (transition.fade_mode == FADE_AUTOMATIC) {
+		// Adjust automatic mode based on context.
+		if (transition.to_time == TRANSITION_TO_TIME_START) {
+			transition.fade_mode = FADE_OUT;
+		} else {
+			transition.fade_mode = FADE_CROSS;
+		}
+	}
+	return transition;
+}
+
+void AudioStreamInteractive::_update_transition_table() {
+	if (transition_table_deferred) {
+		return;
+	}
+
+	// Built aside and swapped in, the audio thread neither waits for the build nor allocates.
+	LocalVector<Transition> entries;
+	entries.push_back(_resolve_transition(Transition())); // Used when no transition matches.
+
+	HashMap<TransitionKey, uint16_t, TransitionKeyHasher> entry_indices;
+	for (const KeyValue<TransitionKey, Transition> &K : transition_map) {
+		entry_indices.insert(K.key, entries.size());
+		entries.push_back(_resolve_transition(K.value));
+	}
+
+	LocalVector<uint16_t> table;
+	table.resize(clip_count * clip_count);
+	for (int from = 0; from < clip_count; from++) {
+		for (int to = 0; to < clip_count; to++) {
+			// Same priority as the lookup order of the transition rules: exact match first, then wildcards.
+			const TransitionKey keys[4] = {
+				TransitionKey(from, to),
+				TransitionKey(from, CLIP_ANY),
+				TransitionKey(CLIP_ANY, to),
+				TransitionKey(CLIP_ANY, CLIP_ANY)
+			};
+
+			uint16_t entry = 0;
+			for (int i = 0; i < 4; i++) {
+				HashMap<TransitionKey, uint16_t, TransitionKeyHasher>::ConstIterator E = entry_indices.find(keys[i]);
+				if (E) {
+					entry = E->value;
+					break;
+				}
+			}
+			table[from * clip_count + to] = entry;
+		}
+	}
+
+	AudioDriver::get_singleton()->lock();
+	SWAP(transition_table, table);
+	SWAP(transition_table_entries, entries);
+	transition_table_clip_count = clip_count;
+	AudioDriver::get_singleton()->unlock();
+	// The previous table is freed here, outside the audio lock.
+}
+
+const AudioStreamInteractive::Transition &AudioStreamInteractive::_get_resolved_transition(int p_from_clip, int p_to_clip) const {
+	if (unlikely(p_from_clip >= transition_table_clip_count || p_to_clip >= transition_table_clip_count)) {
+		// The clip count changed and the rebuilt table hasn't been swapped in yet.
+		return transition_table_entries[0];
+	}
+	return transition_table_entries[transition_table[p_from_clip * transition_table_clip_count + p_to_clip]];
 }
 
 AudioStreamInteractive::TransitionFromTime AudioStreamInteractive::get_transition_from_time(int p_from_clip, int p_to_clip) const {
@@ -379,6 +459,7 @@ void AudioStreamInteractive::_inspector_array_swap_clip(uint32_t p_item_a, uint3
 	}
 
 	SWAP(clips[p_item_a], clips[p_item_b]);
+	_update_transition_table();
 
 	stream_name_cache = "";
 
@@ -555,7 +636,7 @@ void AudioStreamPlaybackInteractive::stop() {
 		}
 		states[i].fade_speed = 0.0;
 		states[i].fade_volume = 0.0;
-		states[i].fade_wait = 0.0;
+		states[i].fade_wait = 0;
 		states[i].reset_fade();
 		states[i].active = false;
 		states[i].auto_advance = -1;
@@ -637,30 +718,8 @@ void AudioStreamPlaybackInteractive::_queue(int p_to_clip_index, bool p_is_auto_
 	State &from_state = states[playback_current];
 	State &to_state = states[p_to_clip_index];
 
-	AudioStreamInteractive::Transition transition; // Use an empty transition by default
-
-	AudioStreamInteractive::TransitionKey tkeys[4] = {
-		AudioStreamInteractive::TransitionKey(playback_current, p_to_clip_index),
-		AudioStreamInteractive::TransitionKey(playback_current, AudioStreamInteractive::CLIP_ANY),
-		AudioStreamInteractive::TransitionKey(AudioStreamInteractive::CLIP_ANY, p_to_clip_index),
-		AudioStreamInteractive::TransitionKey(AudioStreamInteractive::CLIP_ANY, AudioStreamInteractive::CLIP_ANY)
-	};
-
-	for (int i = 0; i < 4; i++) {
-		if (stream->transition_map.has(tkeys[i])) {
-			transition = stream->transition_map[tkeys[i]];
-			break;
-		}
-	}
-
-	if (transition.fade_mode == AudioStreamInteractive::FADE_AUTOMATIC) {
-		// Adjust automatic mode based on context.
-		if (transition.to_time == AudioStreamInteractive::TRANSITION_TO_TIME_START) {
-			transition.fade_mode = AudioStreamInteractive::FADE_OUT;
-		} else {
-			transition.fade_mode = AudioStreamInteractive::FADE_CROSS;
-		}
-	}
+	// Copy, auto advance adjusts it below.
+	AudioStreamInteractive::Transition transition = stream->_get_resolved_transition(playback_current, p_to_clip_index);
 
 	if (p_is_auto_advance) {
 		transition.from_time = AudioStreamInteractive::TRANSITION_FROM_TIME_END;
@@ -669,29 +728,31 @@ void AudioStreamPlaybackInteractive::_queue(int p_to_clip_index, bool p_is_auto_
 		}
 	}
 
-	// Prepare the fadeout
-	float current_pos = from_state.playback->get_playback_position();
+	// Prepare the fadeout. Times are computed in double precision and converted to
+	// frames once, so the switch lands on the exact sample of the beat or bar.
+	double mix_rate = double(AudioServer::get_singleton()->get_mix_rate());
+	double current_pos = from_state.playback->get_playback_position();
 
-	float src_fade_wait = 0;
-	float dst_seek_to = 0;
-	float fade_speed = 0;
+	double src_fade_wait = 0;
+	double dst_seek_to = 0;
+	double fade_speed = 0;
 	bool src_no_loop = false;
 
 	if (from_state.stream->get_bpm()) {
 		// Check if source speed has BPM, if so, transition syncs to BPM
-		float beat_sec = 60 / float(from_state.stream->get_bpm());
+		double beat_sec = 60 / double(from_state.stream->get_bpm());
 		switch (transition.from_time) {
 			case AudioStreamInteractive::TRANSITION_FROM_TIME_IMMEDIATE: {
 				src_fade_wait = 0;
 			} break;
 			case AudioStreamInteractive::TRANSITION_FROM_TIME_NEXT_BEAT: {
-				float remainder = Math::fmod(current_pos, beat_sec);
+				double remainder = Math::fmod(current_pos, beat_sec);
 				src_fade_wait = beat_sec - remainder;
 			} break;
 			case AudioStreamInteractive::TRANSITION_FROM_TIME_NEXT_BAR: {
 				if (from_state.stream->get_bar_beats() > 0) {
-					float bar_sec = beat_sec * from_state.stream->get_bar_beats();
-					float remainder = Math::fmod(current_pos, bar_sec);
+					double bar_sec = beat_sec * from_state.stream->get_bar_beats();
+					double remainder = Math::fmod(current_pos, bar_sec);
 					src_fade_wait = bar_sec - remainder;
 				} else {
 					// Stream does not have a number of beats per bar - avoid NaN, and play immediately.
@@ -699,7 +760,7 @@ void AudioStreamPlaybackInteractive::_queue(int p_to_clip_index, bool p_is_auto_
 				}
 			} break;
 			case AudioStreamInteractive::TRANSITION_FROM_TIME_END: {
-				float end = from_state.stream->get_beat_count() > 0 ? float(from_state.stream->get_beat_count() * beat_sec) : from_state.stream->get_length();
+				double end = from_state.stream->get_beat_count() > 0 ? from_state.stream->get_beat_count() * beat_sec : from_state.stream->get_length();
 				if (end == 0) {
 					// Stream does not have a length.
 					src_fade_wait = 0;
@@ -720,7 +781,7 @@ void AudioStreamPlaybackInteractive::_queue(int p_to_clip_index, bool p_is_auto_
 	} else {
 		// Source has no BPM, so just simple transition.
 		if (transition.from_time == AudioStreamInteractive::TRANSITION_FROM_TIME_END && from_state.stream->get_length() > 0) {
-			float end = from_state.stream->get_length();
+			double end = from_state.stream->get_length();
 			src_fade_wait = end - current_pos;
 			if (!from_state.stream->has_loop()) {
 				src_no_loop = true;
@@ -736,9 +797,9 @@ void AudioStreamPlaybackInteractive::_queue(int p_to_clip_index, bool p_is_auto_
 	} else if (transition.to_time == AudioStreamInteractive::TRANSITION_TO_TIME_SAME_POSITION && transition.from_time != AudioStreamInteractive::TRANSITION_FROM_TIME_END && to_state.stream->get_length() > 0.0) {
 		// Seeking to basically same position as when we start fading.
 		dst_seek_to = current_pos + src_fade_wait;
-		float end;
+		double end;
 		if (to_state.stream->get_bpm() > 0 && to_state.stream->get_beat_count()) {
-			float beat_sec = 60 / float(to_state.stream->get_bpm());
+			double beat_sec = 60 / double(to_state.stream->get_bpm());
 			end = to_state.stream->get_beat_count() * beat_sec;
 		} else {
 			end = to_state.stream->get_length();
@@ -754,6 +815,8 @@ void AudioStreamPlaybackInteractive::_queue(int p_to_clip_index, bool p_is_auto_
 		dst_seek_to = 0.0;
 	}
 
+	int64_t src_fade_wait_frames = MAX(int64_t(0), int64_t(Math::round(src_fade_wait * mix_rate)));
+
 	if (transition.fade_mode == AudioStreamInteractive::FADE_DISABLED || transition.fade_mode == AudioStreamInteractive::FADE_IN) {
 		if (src_no_loop) {
 			// If there is no fade in the source stream, then let it continue until it ends.
@@ -761,12 +824,12 @@ void AudioStreamPlaybackInteractive::_queue(int p_to_clip_index, bool p_is_auto_
 			from_state.fade_speed = 0;
 		} else {
 			// Otherwise force a very quick fade to avoid clicks
-			from_state.fade_wait = src_fade_wait;
+			from_state.fade_wait = src_fade_wait_frames;
 			from_state.fade_speed = 1.0 / -0.001;
 		}
 	} else {
 		// Regular fade.
-		from_state.fade_wait = src_fade_wait;
+		from_state.fade_wait = src_fade_wait_frames;
 		from_state.fade_speed = -fade_speed;
 	}
 	// keep volume, since it may have been fading in from something else.
@@ -804,12 +867,12 @@ void AudioStreamPlaybackInteractive::_queue(int p_to_clip_index, bool p_is_auto_
 		filler_state.fade_volume = 1.0;
 		filler_state.fade_speed = 0.0;
 
-		filler_state.fade_wait = src_fade_wait;
+		filler_state.fade_wait = src_fade_wait_frames;
 		filler_state.first_mix = true;
 
-		float filler_end;
+		double filler_end;
 		if (filler_state.stream->get_bpm() > 0 && filler_state.stream->get_beat_count() > 0) {
-			float filler_beat_sec = 60 / float(filler_state.stream->get_bpm());
+			double filler_beat_sec = 60 / double(filler_state.stream->get_bpm());
 			filler_end = filler_beat_sec * filler_state.stream->get_beat_count();
 		} else {
 			filler_end = filler_state.stream->get_length();
@@ -829,10 +892,10 @@ void AudioStreamPlaybackInteractive::_queue(int p_to_clip_index, bool p_is_auto_
 			to_state.fade_speed = fade_speed;
 		}
 
-		to_state.fade_wait = src_fade_wait + filler_end;
+		to_state.fade_wait = src_fade_wait_frames + MAX(int64_t(0), int64_t(Math::round(filler_end * mix_rate)));
 
 	} else {
-		to_state.fade_wait = src_fade_wait;
+		to_state.fade_wait = src_fade_wait_frames;
 
 		if (transition.fade_mode == AudioStreamInteractive::FADE_DISABLED || transition.fade_mode == AudioStreamInteractive::FADE_OUT) {
 			to_state.fade_volume = 1.0;
@@ -903,10 +966,9 @@ void AudioStreamPlaybackInteractive::_mix_internal_state(int p_state_idx, int p_
 
 	if (state.first_mix) {
 		// Did not start mixing yet, wait.
-		double mix_time = p_frames * frame_inc;
-		if (state.fade_wait < mix_time) {
+		if (state.fade_wait < p_frames) {
 			// time to start!
-			from_frame = state.fade_wait * mix_rate;
+			from_frame = int(state.fade_wait);
 			state.fade_wait = 0;
 			if (state.fade_speed == 0.0) {
 				queue_next = state.auto_advance;
@@ -915,7 +977,7 @@ void AudioStreamPlaybackInteractive::_mix_internal_state(int p_state_idx, int p_
 			state.first_mix = false;
 		} else {
 			// This is for fade in of new stream.
-			state.fade_wait -= mix_time;
+			state.fade_wait -= p_frames;
 			return; // Nothing to do
 		}
 	}
@@ -923,36 +985,57 @@ void AudioStreamPlaybackInteractive::_mix_internal_state(int p_state_idx, int p_
 	state.previous_position = state.playback->get_playback_position();
 	state.playback->mix(temp_buffer + from_frame, 1.0, p_frames - from_frame);
 
+	// Mix in runs of frames that share the same fade behavior, so each run can
+	// be handed to a block kernel instead of being scaled sample by sample.
 	double frame_fade_inc = state.fade_speed * frame_inc;
-	for (int i = from_frame; i < p_frames; i++) {
+	int i = from_frame;
+	while (i < p_frames) {
+		int todo = p_frames - i;
 		if (state.fade_wait) {
-			// This is for fade out of existing stream;
-			state.fade_wait -= frame_inc;
-			if (state.fade_wait < 0.0) {
-				state.fade_wait = 0.0;
-			}
+			// This is for fade out of existing stream, volume is kept while waiting.
+			int run = int(MIN(int64_t(todo), state.fade_wait));
+			AudioMixKernels::mix(mix_buffer + i, temp_buffer + i, run, state.fade_volume);
+			state.fade_wait -= run;
+			i += run;
 		} else if (frame_fade_inc > 0) {
-			state.fade_volume += frame_fade_inc;
-			if (state.fade_volume >= 1.0) {
+			// Last frame of the fade is mixed at full volume.
+			int fade_frames = MAX(1, int(Math::ceil((1.0 - state.fade_volume) / frame_fade_inc)));
+			int run = MIN(todo, fade_frames);
+			if (run < fade_frames) {
+				AudioMixKernels::mix_ramp(mix_buffer + i, temp_buffer + i, run, state.fade_volume + frame_fade_inc, frame_fade_inc);
+				state.fade_volume = MIN(1.0, state.fade_volume + run * frame_fade_inc);
+			} else {
+				AudioMixKernels::mix_ramp(mix_buffer + i, temp_buffer + i, run - 1, state.fade_volume + frame_fade_inc, frame_fade_inc);
+				AudioMixKernels::mix(mix_buffer + i + run - 1, temp_buffer + i + run - 1, 1, 1.0);
 				state.fade_speed = 0.0;
 				frame_fade_inc = 0.0;
 				state.fade_volume = 1.0;
 				queue_next = state.auto_advance;
 			}
+			i += run;
 		} else if (frame_fade_inc < 0.0) {
-			state.fade_volume += frame_fade_inc;
-			if (state.fade_volume <= 0.0) {
+			// Frame at which the volume reaches zero is not mixed.
+			int fade_frames = MAX(1, int(Math::ceil(state.fade_volume / -frame_fade_inc)));
+			int run = MIN(todo, fade_frames);
+			if (run < fade_frames) {
+				AudioMixKernels::mix_ramp(mix_buffer + i, temp_buffer + i, run, state.fade_volume + frame_fade_inc, frame_fade_inc);
+				state.fade_volume += run * frame_fade_inc;
+				i += run;
+			} else {
+				AudioMixKernels::mix_ramp(mix_buffer + i, temp_buffer + i, run - 1, state.fade_volume + frame_fade_inc, frame_fade_inc);
+				i += run - 1;
 				state.fade_speed = 0.0;
 				frame_fade_inc = 0.0;
 				state.fade_volume = 0.0;
 				state.playback->stop(); // Stop playback and break, no point to continue mixing
 				break;
 			}
+		} else {
+			AudioMixKernels::mix(mix_buffer + i, temp_buffer + i, todo, state.fade_volume);
+			i += todo;
 		}
-
-		mix_buffer[i] += temp_buffer[i] * state.fade_volume;
-		state.previous_position += frame_inc;
 	}
+	state.previous_position += (i - from_frame) * frame_inc;
 
 	if (!state.playback->is_playing()) {
 		// It finished because it either reached end or faded out, so deactivate and continue.
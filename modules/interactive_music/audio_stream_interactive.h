@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/templates/local_vector.h"
 #include "servers/audio/audio_stream.h"
 
 class AudioStreamPlaybackInteractive;
@@ -126,6 +127,20 @@ private:
 
 	HashMap<TransitionKey, Transition, TransitionKeyHasher> transition_map;
 
+	// Transitions resolved for every clip pair (CLIP_ANY fallbacks and automatic
+	// fade mode included), so playbacks don't search the map when switching clips.
+	// Each cell indexes transition_table_entries, entry zero is the default transition.
+	// The table is rebuilt on the main thread whenever clips or transitions change and
+	// swapped in under the audio lock, so the audio thread only ever reads it.
+	LocalVector<uint16_t> transition_table;
+	LocalVector<Transition> transition_table_entries;
+	int transition_table_clip_count = 0;
+	bool transition_table_deferred = false; // Set while transitions are loaded in bulk.
+
+	static Transition _resolve_transition(const Transition &p_transition);
+	void _update_transition_table();
+	const Transition &_get_resolved_transition(int p_from_clip, int p_to_clip) const;
+
 	uint64_t version = 1; // Used to stop playback instances for incompatibility.
 	int clip_count = 0;
 
@@ -217,7 +232,7 @@ private:
 		Ref<AudioStream> stream;
 		Ref<AudioStreamPlayback> playback;
 		bool active = false;
-		double fade_wait = 0; // Time to wait until fade kicks-in
+		int64_t fade_wait = 0; // Frames to wait until fade kicks-in
 		double fade_volume = 1.0;
 		double fade_speed = 0; // Fade speed, negative or positive
 		int auto_advance = -1;
@@ -30,6 +30,8 @@
 
 #include "audio_stream_playlist.h"
 
+#include "audio_mix_kernels.h"
+
 #include "core/math/math_funcs.h"
 
 Ref<AudioStreamPlayback> AudioStreamPlaylist::instantiate_playback() {
@@ -256,6 +258,18 @@ void AudioStreamPlaybackPlaylist::seek(double p_time) {
 	start(p_time);
 }
 
+void AudioStreamPlaybackPlaylist::_mix_fade(AudioFrame *p_buffer, const AudioFrame *p_fade, int p_frames, double p_fade_dec) {
+	// Frames left until the fading stream goes silent.
+	int fade_frames = MAX(1, int(Math::ceil(fade_volume / p_fade_dec)));
+	int run = MIN(p_frames, fade_frames);
+	AudioMixKernels::mix_ramp(p_buffer, p_fade, run, fade_volume, run > 1 ? -p_fade_dec : 0.0);
+	fade_volume -= p_fade_dec * run;
+	if (run == fade_frames) {
+		playback[fade_index]->stop();
+		fade_index = -1;
+	}
+}
+
 int AudioStreamPlaybackPlaylist::mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) {
 	if (!active) {
 		return 0;
@@ -276,7 +290,25 @@ int AudioStreamPlaybackPlaylist::mix(AudioFrame *p_buffer, float p_rate_scale, i
 
 		offset += time_dec * to_mix;
 
-		for (int i = 0; i < to_mix; i++) {
+		int i = 0;
+		while (i < to_mix) {
+			// Frames that can be mixed before the current stream runs out.
+			int run = to_mix - i;
+			if (stream_todo < time_dec * run) {
+				run = CLAMP(int(stream_todo / time_dec), 0, run);
+			}
+			if (run > 0) {
+				AudioMixKernels::copy(p_buffer, mix_buffer + i, run);
+				stream_todo -= time_dec * run;
+				if (fade_index != -1) {
+					_mix_fade(p_buffer, fade_buffer + i, run, fade_dec);
+				}
+				p_buffer += run;
+				i += run;
+				continue;
+			}
+
+			// The current stream ends on this frame.
 			*p_buffer = mix_buffer[i];
 			stream_todo -= time_dec;
 			if (stream_todo < 0) {
@@ -288,9 +320,7 @@ int AudioStreamPlaybackPlaylist::mix(AudioFrame *p_buffer, float p_rate_scale, i
 					if (play_index >= playlist->stream_count) {
 						// No loop, exit.
 						if (!playlist->loop) {
-							for (int k = i; k < todo - i; k++) {
-								p_buffer[k] = AudioFrame(0, 0);
-							}
+							AudioMixKernels::clear(p_buffer + 1, todo - i - 1);
 							todo = to_mix;
 							active = false;
 							break;
@@ -352,15 +382,11 @@ int AudioStreamPlaybackPlaylist::mix(AudioFrame *p_buffer, float p_rate_scale, i
 			}
 
 			if (fade_index != -1) {
-				*p_buffer += fade_buffer[i] * fade_volume;
-				fade_volume -= fade_dec;
-				if (fade_volume <= 0.0) {
-					playback[fade_index]->stop();
-					fade_index = -1;
-				}
+				_mix_fade(p_buffer, fade_buffer + i, 1, fade_dec);
 			}
 
 			p_buffer++;
+			i++;
 		}
 
 		todo -= to_mix;
@@ -108,6 +108,8 @@ private:
 
 	void _update_playback_instances();
 
+	void _mix_fade(AudioFrame *p_buffer, const AudioFrame *p_fade, int p_frames, double p_fade_dec);
+
 public:
 	virtual void start(double p_from_pos = 0.0) override;
 	virtual void stop() override;
@@ -30,6 +30,8 @@
 
 #include "audio_stream_synchronized.h"
 
+#include "audio_mix_kernels.h"
+
 #include "core/math/math_funcs.h"
 
 AudioStreamSynchronized::AudioStreamSynchronized() {
@@ -166,7 +168,7 @@ void AudioStreamSynchronized::_bind_methods() {
 
 	for (int i = 0; i < MAX_STREAMS; i++) {
 		ADD_PROPERTYI(PropertyInfo(Variant::OBJECT, "stream_" + itos(i) + "/stream", PROPERTY_HINT_RESOURCE_TYPE, "AudioStream", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_INTERNAL), "set_sync_stream", "get_sync_stream", i);
-		ADD_PROPERTYI(PropertyInfo(Variant::FLOAT, "stream_" + itos(i) + "/volume", PROPERTY_HINT_RANGE, "-60,12,0.01,suffix:db", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_INTERNAL), "set_sync_stream_volume", "get_sync_stream_volume", i);
+		ADD_PROPERTYI(PropertyInfo(Variant::FLOAT, "stream_" + itos(i) + "/volume", PROPERTY_HINT_RANGE, "-60,12,0.01,or_less,suffix:db", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_INTERNAL), "set_sync_stream_volume", "get_sync_stream_volume", i);
 	}
 
 	BIND_CONSTANT(MAX_STREAMS);
@@ -190,6 +192,7 @@ void AudioStreamPlaybackSynchronized::stop() {
 		if (playback[i].is_valid()) {
 			playback[i]->stop();
 		}
+		virtual_voices[i] = VirtualVoice();
 	}
 }
 
@@ -199,6 +202,7 @@ void AudioStreamPlaybackSynchronized::start(double p_from_pos) {
 	}
 
 	for (int i = 0; i < stream->stream_count; i++) {
+		virtual_voices[i] = VirtualVoice();
 		if (playback[i].is_valid()) {
 			playback[i]->start(p_from_pos);
 			active = true;
@@ -208,18 +212,61 @@ void AudioStreamPlaybackSynchronized::start(double p_from_pos) {
 
 void AudioStreamPlaybackSynchronized::seek(double p_time) {
 	for (int i = 0; i < stream->stream_count; i++) {
-		if (playback[i].is_valid()) {
+		if (virtual_voices[i].active) {
+			virtual_voices[i].position = p_time;
+		} else if (playback[i].is_valid()) {
 			playback[i]->seek(p_time);
 		}
 	}
 }
 
+void AudioStreamPlaybackSynchronized::_make_voice_virtual(int p_index) {
+	VirtualVoice &voice = virtual_voices[p_index];
+	voice.active = true;
+	voice.position = playback[p_index]->get_playback_position();
+}
+
+void AudioStreamPlaybackSynchronized::_make_voice_real(int p_index) {
+	VirtualVoice &voice = virtual_voices[p_index];
+	voice.active = false;
+	playback[p_index]->seek(voice.position);
+}
+
+void AudioStreamPlaybackSynchronized::_advance_virtual_voice(int p_index, double p_time) {
+	VirtualVoice &voice = virtual_voices[p_index];
+	const Ref<AudioStream> &sub_stream = stream->audio_streams[p_index];
+
+	// Same length the sub-stream loops at when it is decoded.
+	double length;
+	if (sub_stream->get_bpm() > 0 && sub_stream->get_beat_count() > 0) {
+		length = sub_stream->get_beat_count() * 60.0 / sub_stream->get_bpm();
+	} else {
+		length = sub_stream->get_length();
+	}
+
+	voice.position += p_time;
+	if (length <= 0.0 || voice.position < length) {
+		return;
+	}
+
+	if (sub_stream->has_loop()) {
+		int loops = int(voice.position / length);
+		voice.loops += loops;
+		voice.position -= loops * length;
+	} else {
+		// Reached the end while silent, finish it like a decoded stream would.
+		voice.active = false;
+		playback[p_index]->stop();
+	}
+}
+
 int AudioStreamPlaybackSynchronized::mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) {
 	if (!active) {
 		return 0;
 	}
 
 	int todo = p_frames;
+	double frame_time = p_rate_scale / double(AudioServer::get_singleton()->get_mix_rate());
 
 	bool any_active = false;
 	while (todo) {
@@ -228,28 +275,36 @@ int AudioStreamPlaybackSynchronized::mix(AudioFrame *p_buffer, float p_rate_scal
 		bool first = true;
 		for (int i = 0; i < stream->stream_count; i++) {
 			if (playback[i].is_valid() && playback[i]->is_playing()) {
+				if (stream->audio_stream_volume_db[i] <= VIRTUAL_VOICE_VOLUME_DB) {
+					// Silent, skip decoding and only keep track of where it would be.
+					if (!virtual_voices[i].active) {
+						_make_voice_virtual(i);
+					}
+					_advance_virtual_voice(i, to_mix * frame_time);
+					any_active = any_active || virtual_voices[i].active;
+					continue;
+				}
+
+				if (virtual_voices[i].active) {
+					_make_voice_real(i);
+				}
+
 				float volume = Math::db_to_linear(stream->audio_stream_volume_db[i]);
 				if (first) {
 					playback[i]->mix(p_buffer, p_rate_scale, to_mix);
-					for (int j = 0; j < to_mix; j++) {
-						p_buffer[j] *= volume;
-					}
+					AudioMixKernels::scale(p_buffer, to_mix, volume);
 					first = false;
 					any_active = true;
 				} else {
 					playback[i]->mix(mix_buffer, p_rate_scale, to_mix);
-					for (int j = 0; j < to_mix; j++) {
-						p_buffer[j] += mix_buffer[j] * volume;
-					}
+					AudioMixKernels::mix(p_buffer, mix_buffer, to_mix, volume);
 				}
 			}
 		}
 
 		if (first) {
 			// Nothing mixed, put zeroes.
-			for (int j = 0; j < to_mix; j++) {
-				p_buffer[j] = AudioFrame(0, 0);
-			}
+			AudioMixKernels::clear(p_buffer, to_mix);
 		}
 
 		p_buffer += to_mix;
@@ -266,7 +321,7 @@ void AudioStreamPlaybackSynchronized::tag_used_streams() {
 	if (active) {
 		for (int i = 0; i < stream->stream_count; i++) {
 			if (playback[i].is_valid() && playback[i]->is_playing()) {
-				stream->audio_streams[i]->tag_used(playback[i]->get_playback_position());
+				stream->audio_streams[i]->tag_used(virtual_voices[i].active ? virtual_voices[i].position : playback[i]->get_playback_position());
 			}
 		}
 		stream->tag_used(0);
@@ -278,7 +333,7 @@ int AudioStreamPlaybackSynchronized::get_loop_count() const {
 	bool min_loops_found = false;
 	for (int i = 0; i < stream->stream_count; i++) {
 		if (playback[i].is_valid() && playback[i]->is_playing()) {
-			int loops = playback[i]->get_loop_count();
+			int loops = playback[i]->get_loop_count() + virtual_voices[i].loops;
 			if (!min_loops_found || loops < min_loops) {
 				min_loops = loops;
 				min_loops_found = true;
@@ -293,7 +348,7 @@ double AudioStreamPlaybackSynchronized::get_playback_position() const {
 	bool pos_found = false;
 	for (int i = 0; i < stream->stream_count; i++) {
 		if (playback[i].is_valid() && playback[i]->is_playing()) {
-			float pos = playback[i]->get_playback_position();
+			float pos = virtual_voices[i].active ? virtual_voices[i].position : playback[i]->get_playback_position();
 			if (!pos_found || pos > max_pos) {
 				max_pos = pos;
 				pos_found = true;
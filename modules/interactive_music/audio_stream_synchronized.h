@@ -101,6 +101,22 @@ private:
 
 	bool active = false;
 
+	// Sub-streams at or below this volume are not mixed (nor decoded). Only their
+	// position is tracked, and they are seeked back in place once audible again.
+	static constexpr float VIRTUAL_VOICE_VOLUME_DB = -80.0;
+
+	struct VirtualVoice {
+		bool active = false;
+		double position = 0.0;
+		int loops = 0; // Loops done while virtual, the real playback does not count them.
+	};
+
+	VirtualVoice virtual_voices[AudioStreamSynchronized::MAX_STREAMS];
+
+	void _make_voice_virtual(int p_index);
+	void _make_voice_real(int p_index);
+	void _advance_virtual_voice(int p_index, double p_time);
+
 	void _update_playback_instances();
 
 public:
@@ -0,0 +1,162 @@
+/**************************************************************************/
+/*  test_audio_mix_kernels.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../audio_mix_kernels.h"
+
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioMixKernels {
+
+static void fill_frames(LocalVector<AudioFrame> &r_frames, int p_count, float p_seed) {
+	r_frames.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		r_frames[i] = AudioFrame(Math::sin(p_seed + i * 0.37f), Math::cos(p_seed - i * 0.11f));
+	}
+}
+
+static bool frames_equal_approx(const AudioFrame *p_a, const AudioFrame *p_b, int p_count) {
+	for (int i = 0; i < p_count; i++) {
+		if (!Math::is_equal_approx(p_a[i].left, p_b[i].left, 1e-5f) || !Math::is_equal_approx(p_a[i].right, p_b[i].right, 1e-5f)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Frame counts around the vector width, with an odd offset so buffers are not 16-byte aligned.
+static const int test_frame_counts[] = { 0, 1, 3, 4, 5, 7, 8, 63, 64, 65, 1023 };
+static const int test_offset = 1;
+
+TEST_CASE("[AudioMixKernels] Clear, copy and scale") {
+	for (int count : test_frame_counts) {
+		LocalVector<AudioFrame> src;
+		LocalVector<AudioFrame> dst;
+		fill_frames(src, count + test_offset, 0.5f);
+		fill_frames(dst, count + test_offset, 1.5f);
+
+		AudioMixKernels::copy(dst.ptr() + test_offset, src.ptr() + test_offset, count);
+		CHECK(frames_equal_approx(dst.ptr() + test_offset, src.ptr() + test_offset, count));
+
+		LocalVector<AudioFrame> expected = src;
+		for (int i = 0; i < count; i++) {
+			expected[test_offset + i] *= 0.25f;
+		}
+		AudioMixKernels::scale(dst.ptr() + test_offset, count, 0.25f);
+		CHECK_MESSAGE(frames_equal_approx(dst.ptr() + test_offset, expected.ptr() + test_offset, count), vformat("Scaling %d frames should match the scalar result.", count));
+
+		AudioMixKernels::clear(dst.ptr() + test_offset, count);
+		bool all_zero = true;
+		for (int i = 0; i < count; i++) {
+			all_zero = all_zero && dst[test_offset + i].left == 0.0f && dst[test_offset + i].right == 0.0f;
+		}
+		CHECK(all_zero);
+	}
+}
+
+TEST_CASE("[AudioMixKernels] Mix and mix with ramp match scalar mixing") {
+	for (int count : test_frame_counts) {
+		LocalVector<AudioFrame> src;
+		LocalVector<AudioFrame> dst;
+		fill_frames(src, count + test_offset, 0.25f);
+		fill_frames(dst, count + test_offset, 2.0f);
+
+		LocalVector<AudioFrame> expected = dst;
+		for (int i = 0; i < count; i++) {
+			expected[test_offset + i] += src[test_offset + i] * 0.7f;
+		}
+		AudioMixKernels::mix(dst.ptr() + test_offset, src.ptr() + test_offset, count, 0.7f);
+		CHECK_MESSAGE(frames_equal_approx(dst.ptr(), expected.ptr(), count + test_offset), vformat("Mixing %d frames should match the scalar result.", count));
+
+		// Fade out from full volume, as done when crossfading clips.
+		const float step = -1.0f / 1024.0f;
+		for (int i = 0; i < count; i++) {
+			expected[test_offset + i] += src[test_offset + i] * (1.0f + step * i);
+		}
+		AudioMixKernels::mix_ramp(dst.ptr() + test_offset, src.ptr() + test_offset, count, 1.0f, step);
+		CHECK_MESSAGE(frames_equal_approx(dst.ptr(), expected.ptr(), count + test_offset), vformat("Mixing %d frames with a ramp should match the scalar result.", count));
+	}
+}
+
+TEST_CASE("[AudioMixKernels] Ramp with zero step is a constant mix") {
+	LocalVector<AudioFrame> src;
+	LocalVector<AudioFrame> a;
+	fill_frames(src, 37, 3.0f);
+	fill_frames(a, 37, 4.0f);
+	LocalVector<AudioFrame> b = a;
+
+	AudioMixKernels::mix(a.ptr(), src.ptr(), 37, 0.3f);
+	AudioMixKernels::mix_ramp(b.ptr(), src.ptr(), 37, 0.3f, 0.0f);
+	CHECK(frames_equal_approx(a.ptr(), b.ptr(), 37));
+}
+
+TEST_CASE("[AudioMixKernels][Benchmark] Crossfade mixing throughput" * doctest::skip()) {
+	// Mirrors AudioStreamPlaybackInteractive: many clip states faded into one 1024 frame mix buffer.
+	const int frames = 1024;
+	const int states = 64;
+	const int iterations = 200;
+
+	LocalVector<AudioFrame> src;
+	LocalVector<AudioFrame> dst;
+	fill_frames(src, frames, 0.0f);
+	dst.resize(frames);
+
+	const float step = 1.0f / (frames * 4);
+	const uint64_t total_frames = uint64_t(frames) * states * iterations;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		for (int s = 0; s < states; s++) {
+			float volume = s * step;
+			for (int i = 0; i < frames; i++) {
+				volume += step;
+				dst[i] += src[i] * volume;
+			}
+		}
+	}
+	uint64_t scalar_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int it = 0; it < iterations; it++) {
+		for (int s = 0; s < states; s++) {
+			AudioMixKernels::mix_ramp(dst.ptr(), src.ptr(), frames, (s + 1) * step, step);
+		}
+	}
+	uint64_t kernel_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+	MESSAGE(vformat("Scalar ramp mixing: %.1f Mframes/s.", double(total_frames) / scalar_usec));
+	MESSAGE(vformat("Kernel ramp mixing: %.1f Mframes/s.", double(total_frames) / kernel_usec));
+}
+
+} // namespace TestAudioMixKernels
@@ -0,0 +1,165 @@
+/**************************************************************************/
+/*  test_audio_mix_kernels.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#pragma once
+
+#include "../audio_stream_synchronized.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioStreamSynchronized {
+
+class TestToneStream;
+
+// Writes a constant frame and keeps track of how often it has been decoded.
+class TestTonePlayback : public AudioStreamPlayback {
+	GDCLASS(TestTonePlayback, AudioStreamPlayback);
+
+public:
+	bool playing = false;
+	double position = 0.0;
+	int mix_calls = 0;
+
+	virtual void start(double p_from_pos = 0.0) override {
+		playing = true;
+		position = p_from_pos;
+	}
+	virtual void stop() override { playing = false; }
+	virtual bool is_playing() const override { return playing; }
+	virtual int get_loop_count() const override { return 0; }
+	virtual double get_playback_position() const override { return position; }
+	virtual void seek(double p_time) override { position = p_time; }
+
+	virtual int mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) override {
+		mix_calls++;
+		for (int i = 0; i < p_frames; i++) {
+			p_buffer[i] = AudioFrame(1, 1);
+		}
+		position += p_frames * p_rate_scale / double(AudioServer::get_singleton()->get_mix_rate());
+		return p_frames;
+	}
+};
+
+class TestToneStream : public AudioStream {
+	GDCLASS(TestToneStream, AudioStream);
+
+public:
+	double length = 10.0;
+	bool loop = false;
+	Ref<TestTonePlayback> last_playback;
+
+	virtual Ref<AudioStreamPlayback> instantiate_playback() override {
+		last_playback.instantiate();
+		return last_playback;
+	}
+	virtual String get_stream_name() const override { return "TestTone"; }
+	virtual double get_length() const override { return length; }
+	virtual bool has_loop() const override { return loop; }
+};
+
+static void mix_seconds(const Ref<AudioStreamPlayback> &p_playback, double p_seconds) {
+	AudioFrame buffer[512];
+	int frames = int(p_seconds * AudioServer::get_singleton()->get_mix_rate());
+	while (frames > 0) {
+		const int to_mix = MIN(frames, 512);
+		p_playback->mix(buffer, 1.0, to_mix);
+		frames -= to_mix;
+	}
+}
+
+TEST_CASE("[Audio][AudioStreamSynchronized] Silent streams are not mixed and stay in sync") {
+	Ref<TestToneStream> audible;
+	audible.instantiate();
+	Ref<TestToneStream> silent;
+	silent.instantiate();
+
+	Ref<AudioStreamSynchronized> synchronized;
+	synchronized.instantiate();
+	synchronized->set_stream_count(2);
+	synchronized->set_sync_stream(0, audible);
+	synchronized->set_sync_stream(1, silent);
+	synchronized->set_sync_stream_volume(1, -90);
+
+	Ref<AudioStreamPlayback> playback = synchronized->instantiate_playback();
+	REQUIRE(audible->last_playback.is_valid());
+	REQUIRE(silent->last_playback.is_valid());
+	playback->start();
+
+	mix_seconds(playback, 1.0);
+	CHECK(audible->last_playback->mix_calls > 0);
+	CHECK(silent->last_playback->mix_calls == 0);
+	CHECK(playback->is_playing());
+	CHECK(playback->get_playback_position() == doctest::Approx(1.0).epsilon(0.01));
+
+	synchronized->set_sync_stream_volume(1, 0);
+	mix_seconds(playback, 0.5);
+	CHECK(silent->last_playback->mix_calls > 0);
+	CHECK_MESSAGE(silent->last_playback->position == doctest::Approx(audible->last_playback->position), "A voice made audible again should resume where the other streams are.");
+}
+
+TEST_CASE("[Audio][AudioStreamSynchronized] Silent streams loop and end like decoded ones") {
+	Ref<TestToneStream> audible;
+	audible.instantiate();
+	audible->length = 100.0;
+	Ref<TestToneStream> silent;
+	silent.instantiate();
+	silent->length = 0.5;
+
+	Ref<AudioStreamSynchronized> synchronized;
+	synchronized.instantiate();
+	synchronized->set_stream_count(2);
+	synchronized->set_sync_stream(0, audible);
+	synchronized->set_sync_stream(1, silent);
+	synchronized->set_sync_stream_volume(1, -80);
+
+	Ref<AudioStreamPlayback> playback = synchronized->instantiate_playback();
+	playback->start();
+
+	SUBCASE("Looping") {
+		silent->loop = true;
+		mix_seconds(playback, 1.2);
+		CHECK(silent->last_playback->is_playing());
+		CHECK(playback->get_loop_count() == 0); // The audible stream hasn't looped.
+
+		synchronized->set_sync_stream_volume(1, 0);
+		mix_seconds(playback, 0.01);
+		CHECK(silent->last_playback->position == doctest::Approx(0.21).epsilon(0.05));
+	}
+
+	SUBCASE("Not looping") {
+		mix_seconds(playback, 1.0);
+		CHECK_FALSE(silent->last_playback->is_playing());
+		CHECK(silent->last_playback->mix_calls == 0);
+		CHECK(playback->is_playing());
+	}
+}
+
+} // namespace TestAudioStreamSynchronized
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/io/resource.h"
+#include "core/templates/small_vector.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -64,8 +65,10 @@ class SceneState : public RefCounted {
 			int value = 0;
 		};
 
-		Vector<Property> properties;
-		Vector<int> groups;
+		// Most nodes override only a few properties and belong to few groups,
+		// so keep those inline instead of allocating for every node.
+		SmallVector<Property, 4> properties;
+		SmallVector<int, 2> groups;
 	};
 
 	struct DeferredNodePathProperties {
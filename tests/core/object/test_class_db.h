@@ -36,6 +36,53 @@
 
 #include "tests/test_macros.h"
 
+// Declared in global namespace because of GDCLASS macro warning (Windows).
+class _TestShadowBase : public Object {
+	GDCLASS(_TestShadowBase, Object);
+
+	int value = 0;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("get_id"), &_TestShadowBase::get_id);
+		ClassDB::bind_method(D_METHOD("set_value", "value"), &_TestShadowBase::set_value);
+		ClassDB::bind_method(D_METHOD("get_value"), &_TestShadowBase::get_value);
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "value"), "set_value", "get_value");
+		ClassDB::bind_integer_constant(get_class_static(), StringName(), "KIND", 1);
+		ClassDB::bind_integer_constant(get_class_static(), StringName(), "count", 10);
+		ADD_SIGNAL(MethodInfo("changed"));
+	}
+
+public:
+	int get_id() const { return 1; }
+	void set_value(int p_value) { value = p_value; }
+	int get_value() const { return value; }
+};
+
+class _TestShadowDerived : public _TestShadowBase {
+	GDCLASS(_TestShadowDerived, _TestShadowBase);
+
+	int changed = 0;
+
+protected:
+	static void _bind_methods() {
+		// Same kind of member as in the base class.
+		ClassDB::bind_method(D_METHOD("get_id"), &_TestShadowDerived::get_id);
+		ClassDB::bind_integer_constant(get_class_static(), StringName(), "KIND", 2);
+		// Different kinds of members than in the base class.
+		ClassDB::bind_method(D_METHOD("set_changed", "changed"), &_TestShadowDerived::set_changed);
+		ClassDB::bind_method(D_METHOD("get_changed"), &_TestShadowDerived::get_changed);
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "changed"), "set_changed", "get_changed");
+		ClassDB::bind_method(D_METHOD("count"), &_TestShadowDerived::count);
+	}
+
+public:
+	int get_id() const { return 2; }
+	void set_changed(int p_changed) { changed = p_changed; }
+	int get_changed() const { return changed; }
+	int count() const { return 3; }
+};
+
 namespace TestClassDB {
 
 struct TypeReference {
@@ -879,6 +926,71 @@ void add_global_enums(Context &r_context) {
 	}
 }
 
+static void check_member_shadowing() {
+	_TestShadowBase base;
+	_TestShadowDerived derived;
+	Variant ret;
+
+	// Methods of derived classes shadow the ones of their base classes.
+	MethodBind *base_get_id = ClassDB::get_method(_TestShadowBase::get_class_static(), "get_id");
+	MethodBind *derived_get_id = ClassDB::get_method(_TestShadowDerived::get_class_static(), "get_id");
+	REQUIRE(base_get_id);
+	REQUIRE(derived_get_id);
+	CHECK(base_get_id != derived_get_id);
+	CHECK(base.call("get_id") == Variant(1));
+	CHECK(derived.call("get_id") == Variant(2));
+	CHECK(ClassDB::get_method(_TestShadowDerived::get_class_static(), "get_value") == ClassDB::get_method(_TestShadowBase::get_class_static(), "get_value"));
+	CHECK(ClassDB::get_method(_TestShadowDerived::get_class_static(), "nonexistent") == nullptr);
+
+	// So do constants.
+	CHECK(ClassDB::get_property(&base, "KIND", ret));
+	CHECK(ret == Variant(1));
+	CHECK(ClassDB::get_property(&derived, "KIND", ret));
+	CHECK(ret == Variant(2));
+
+	// Inherited properties are found.
+	CHECK(ClassDB::set_property(&derived, "value", 5));
+	CHECK(derived.get_value() == 5);
+	CHECK(ClassDB::get_property(&derived, "value", ret));
+	CHECK(ret == Variant(5));
+
+	// The closest member wins whatever its kind: a property over a signal, a method over a constant.
+	CHECK(ClassDB::get_property(&base, "changed", ret));
+	CHECK(ret.get_type() == Variant::SIGNAL);
+	CHECK(ClassDB::set_property(&derived, "changed", 7));
+	CHECK(ClassDB::get_property(&derived, "changed", ret));
+	CHECK(ret == Variant(7));
+	CHECK_FALSE(ClassDB::set_property(&base, "changed", 7));
+
+	CHECK(ClassDB::get_property(&base, "count", ret));
+	CHECK(ret == Variant(10));
+	CHECK(ClassDB::get_property(&derived, "count", ret));
+	CHECK(ret.get_type() == Variant::CALLABLE);
+
+	CHECK_FALSE(ClassDB::get_property(&derived, "nonexistent", ret));
+	CHECK_FALSE(ClassDB::set_property(&derived, "nonexistent", 1));
+}
+
+TEST_CASE("[ClassDB] Members of derived classes shadow inherited ones") {
+	GDREGISTER_CLASS(_TestShadowBase);
+	GDREGISTER_CLASS(_TestShadowDerived);
+
+	const ClassDB::APIType api = ClassDB::get_current_api();
+
+	SUBCASE("With flattened lookup tables") {
+		ClassDB::set_current_api(ClassDB::API_NONE);
+		check_member_shadowing();
+	}
+
+	SUBCASE("Walking the inheritance chain") {
+		// Lookup tables are only used once registration is done.
+		ClassDB::set_current_api(ClassDB::API_EXTENSION);
+		check_member_shadowing();
+	}
+
+	ClassDB::set_current_api(api);
+}
+
 TEST_SUITE("[ClassDB]") {
 	TEST_CASE("[ClassDB] Add exposed classes, builtin types, and global enums") {
 		Context context;
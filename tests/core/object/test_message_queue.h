@@ -0,0 +1,257 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/message_queue.h"
+#include "core/object/object.h"
+#include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+// Declared in global namespace because of GDCLASS macro warning (Windows):
+// "Unqualified friend declaration referring to type outside of the nearest enclosing namespace
+// is a Microsoft extension; add a nested name specifier".
+class _TestCallQueueRecorder : public Object {
+	GDCLASS(_TestCallQueueRecorder, Object);
+
+public:
+	LocalVector<int> last_index;
+	uint32_t calls = 0;
+	uint32_t out_of_order = 0;
+
+	void record(int p_thread, int p_index) {
+		if (p_index != last_index[p_thread] + 1) {
+			out_of_order++;
+		}
+		last_index[p_thread] = p_index;
+		calls++;
+	}
+
+	void add(int p_value) {
+		calls += p_value;
+	}
+
+	LocalVector<int> order;
+
+	void append(int p_value) {
+		order.push_back(p_value);
+	}
+};
+
+namespace TestMessageQueue {
+
+struct ProducerData {
+	CallQueue *queue = nullptr;
+	_TestCallQueueRecorder *recorder = nullptr;
+	int thread = 0;
+	int count = 0;
+	bool native = true;
+	bool variant = true;
+	SafeFlag done;
+};
+
+static void producer_thread(void *p_userdata) {
+	ProducerData *data = static_cast<ProducerData *>(p_userdata);
+	for (int i = 0; i < data->count; i++) {
+		if (data->native && (!data->variant || i % 2 == 0)) {
+			data->queue->push_call_native(data->recorder, &_TestCallQueueRecorder::record, data->thread, i);
+		} else {
+			data->queue->push_callable(callable_mp(data->recorder, &_TestCallQueueRecorder::record), data->thread, i);
+		}
+	}
+	data->done.set();
+}
+
+// Runs the producers while flushing on this thread, returns the time it took.
+static uint64_t run_producers(CallQueue &p_queue, _TestCallQueueRecorder *p_recorder, int p_threads, int p_count, bool p_native, bool p_variant) {
+	p_recorder->last_index.resize(p_threads);
+	for (int &index : p_recorder->last_index) {
+		index = -1;
+	}
+	p_recorder->calls = 0;
+	p_recorder->out_of_order = 0;
+
+	LocalVector<ProducerData> data;
+	data.resize(p_threads);
+	LocalVector<Thread> threads;
+	threads.resize(p_threads);
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_threads; i++) {
+		data[i].queue = &p_queue;
+		data[i].recorder = p_recorder;
+		data[i].thread = i;
+		data[i].count = p_count;
+		data[i].native = p_native;
+		data[i].variant = p_variant;
+		threads[i].start(producer_thread, &data[i]);
+	}
+
+	bool running = true;
+	while (running) {
+		running = false;
+		for (const ProducerData &producer : data) {
+			running = running || !producer.done.is_set();
+		}
+		p_queue.flush();
+	}
+	p_queue.flush();
+	const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+	return MAX(usec, (uint64_t)1);
+}
+
+TEST_CASE("[CallQueue] Calls from other threads keep their order") {
+	CallQueue queue;
+	_TestCallQueueRecorder *recorder = memnew(_TestCallQueueRecorder);
+
+	// Plenty of messages, so the thread buffers need several pages.
+	run_producers(queue, recorder, 4, 5000, true, true);
+	CHECK(recorder->calls == 4 * 5000);
+	CHECK(recorder->out_of_order == 0);
+	CHECK_FALSE(queue.has_messages());
+
+	memdelete(recorder);
+}
+
+struct CausalData {
+	CallQueue *queue = nullptr;
+	_TestCallQueueRecorder *recorder = nullptr;
+	Semaphore posted;
+	Semaphore registered;
+	int rounds = 0;
+};
+
+// Posts a message each time the other thread has posted one, so the two always alternate.
+static void causal_follower_thread(void *p_userdata) {
+	CausalData *data = static_cast<CausalData *>(p_userdata);
+	// Post first, so the buffer of this thread is the first one the queue reads from.
+	data->queue->push_call_native(data->recorder, &_TestCallQueueRecorder::append, -1);
+	data->registered.post();
+	for (int i = 0; i < data->rounds; i++) {
+		data->posted.wait();
+		data->queue->push_call_native(data->recorder, &_TestCallQueueRecorder::append, i * 2 + 1);
+	}
+}
+
+static void causal_leader_thread(void *p_userdata) {
+	CausalData *data = static_cast<CausalData *>(p_userdata);
+	data->registered.wait();
+	for (int i = 0; i < data->rounds; i++) {
+		data->queue->push_call_native(data->recorder, &_TestCallQueueRecorder::append, i * 2);
+		data->posted.post();
+	}
+}
+
+TEST_CASE("[CallQueue] Calls from other threads run after the calls they were posted after") {
+	CallQueue queue;
+	_TestCallQueueRecorder *recorder = memnew(_TestCallQueueRecorder);
+
+	CausalData data;
+	data.queue = &queue;
+	data.recorder = recorder;
+	data.rounds = 1000;
+
+	Thread follower;
+	Thread leader;
+	follower.start(causal_follower_thread, &data);
+	leader.start(causal_leader_thread, &data);
+	follower.wait_to_finish();
+	leader.wait_to_finish();
+	queue.flush();
+
+	// Each call of the follower was posted after the call of the leader with the number before it.
+	REQUIRE(recorder->order.size() == uint32_t(data.rounds * 2 + 1));
+	LocalVector<int> position;
+	position.resize(data.rounds * 2);
+	for (uint32_t i = 1; i < recorder->order.size(); i++) {
+		position[recorder->order[i]] = i;
+	}
+	int out_of_order = 0;
+	for (int i = 0; i < data.rounds; i++) {
+		if (position[i * 2] > position[i * 2 + 1]) {
+			out_of_order++;
+		}
+	}
+	CHECK(recorder->order[0] == -1);
+	CHECK(out_of_order == 0);
+
+	memdelete(recorder);
+}
+
+TEST_CASE("[CallQueue] Native calls") {
+	CallQueue queue;
+	_TestCallQueueRecorder *recorder = memnew(_TestCallQueueRecorder);
+
+	CHECK(queue.push_call_native(recorder, &_TestCallQueueRecorder::add, 3) == OK);
+	CHECK(queue.push_call_native(recorder->get_instance_id(), &_TestCallQueueRecorder::add, 4) == OK);
+	CHECK(queue.has_messages());
+	CHECK(recorder->calls == 0);
+	queue.flush();
+	CHECK(recorder->calls == 7);
+
+	// Calls to deleted objects are skipped.
+	_TestCallQueueRecorder *deleted = memnew(_TestCallQueueRecorder);
+	queue.push_call_native(deleted, &_TestCallQueueRecorder::add, 1);
+	memdelete(deleted);
+	queue.flush();
+	CHECK_FALSE(queue.has_messages());
+
+	// Cleared calls are not made.
+	queue.push_call_native(recorder, &_TestCallQueueRecorder::add, 100);
+	queue.clear();
+	queue.flush();
+	CHECK(recorder->calls == 7);
+
+	memdelete(recorder);
+}
+
+TEST_CASE("[CallQueue][Benchmark] Deferred calls from many threads" * doctest::skip()) {
+	CallQueue queue;
+	_TestCallQueueRecorder *recorder = memnew(_TestCallQueueRecorder);
+	const int count = 200000;
+
+	for (int threads = 1; threads <= OS::get_singleton()->get_processor_count(); threads *= 2) {
+		const uint64_t variant_usec = run_producers(queue, recorder, threads, count, false, true);
+		const uint64_t native_usec = run_producers(queue, recorder, threads, count, true, false);
+		MESSAGE(vformat("%d producer threads: %.2f M calls/s with Variant arguments, %.2f M calls/s with native arguments.",
+				threads, double(threads) * count / variant_usec, double(threads) * count / native_usec));
+	}
+
+	memdelete(recorder);
+}
+
+} // namespace TestMessageQueue
@@ -66,6 +66,37 @@ public:
 	int get_property() const { return property_value; }
 };
 
+class _TestSignalTarget : public Object {
+	GDCLASS(_TestSignalTarget, Object);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("on_signal", "value"), &_TestSignalTarget::on_signal);
+	}
+
+public:
+	int calls = 0;
+	int last_value = 0;
+
+	// Disconnected from, or freed, when this target receives the signal.
+	Object *emitter = nullptr;
+	_TestSignalTarget *victim = nullptr;
+	bool free_victim = false;
+
+	void on_signal(int p_value) {
+		calls++;
+		last_value = p_value;
+		if (victim) {
+			if (free_victim) {
+				memdelete(victim);
+			} else {
+				emitter->disconnect("my_custom_signal", Callable(victim, "on_signal"));
+			}
+			victim = nullptr;
+		}
+	}
+};
+
 namespace TestObject {
 
 class _MockScriptInstance : public ScriptInstance {
@@ -431,6 +462,81 @@ TEST_CASE("[Object] Signals") {
 		SIGNAL_UNWATCH(&object, "my_custom_signal");
 	}
 
+	SUBCASE("Emitting a signal connected to a native method should call it") {
+		Object target;
+		object.connect("my_custom_signal", Callable(&target, "set_meta"));
+
+		// Arguments of the exact type, and ones needing a conversion.
+		object.emit_signal("my_custom_signal", StringName("exact"), 1);
+		object.emit_signal("my_custom_signal", String("converted"), 2);
+		CHECK(target.get_meta("exact") == Variant(1));
+		CHECK(target.get_meta("converted") == Variant(2));
+
+		// Emitting again after the connections change should see the change.
+		object.disconnect("my_custom_signal", Callable(&target, "set_meta"));
+		object.emit_signal("my_custom_signal", StringName("exact"), 3);
+		CHECK(target.get_meta("exact") == Variant(1));
+	}
+
+	SUBCASE("One-shot connections should only be called once") {
+		Object target;
+		object.connect("my_custom_signal", Callable(&target, "set_meta"), Object::CONNECT_ONE_SHOT);
+
+		object.emit_signal("my_custom_signal", StringName("value"), 1);
+		CHECK_FALSE(object.is_connected("my_custom_signal", Callable(&target, "set_meta")));
+		object.emit_signal("my_custom_signal", StringName("value"), 2);
+		CHECK(target.get_meta("value") == Variant(1));
+	}
+
+	SUBCASE("Disconnecting a target during emission should only affect the next emission") {
+		GDREGISTER_CLASS(_TestSignalTarget);
+		_TestSignalTarget trigger;
+		_TestSignalTarget victim;
+		trigger.emitter = &object;
+		trigger.victim = &victim;
+		object.connect("my_custom_signal", Callable(&trigger, "on_signal"));
+		object.connect("my_custom_signal", Callable(&victim, "on_signal"));
+
+		// The emission already in progress still reaches the disconnected target.
+		object.emit_signal("my_custom_signal", 1);
+		CHECK(trigger.calls == 1);
+		CHECK(victim.calls == 1);
+		CHECK_FALSE(object.is_connected("my_custom_signal", Callable(&victim, "on_signal")));
+
+		object.emit_signal("my_custom_signal", 2);
+		CHECK(trigger.calls == 2);
+		CHECK(trigger.last_value == 2);
+		CHECK(victim.calls == 1);
+		CHECK(victim.last_value == 1);
+	}
+
+	SUBCASE("Freeing a target during emission should skip it") {
+		GDREGISTER_CLASS(_TestSignalTarget);
+		_TestSignalTarget trigger;
+		_TestSignalTarget *victim = memnew(_TestSignalTarget);
+		_TestSignalTarget after;
+		trigger.victim = victim;
+		trigger.free_victim = true;
+		object.connect("my_custom_signal", Callable(&trigger, "on_signal"));
+		object.connect("my_custom_signal", Callable(victim, "on_signal"));
+		object.connect("my_custom_signal", Callable(&after, "on_signal"));
+
+		Error err = object.emit_signal("my_custom_signal", 1);
+		CHECK(err == OK);
+		CHECK(trigger.calls == 1);
+		// The targets after the freed one are still called.
+		CHECK(after.calls == 1);
+
+		List<Object::Connection> signal_connections;
+		object.get_all_signal_connections(&signal_connections);
+		CHECK(signal_connections.size() == 2);
+
+		object.emit_signal("my_custom_signal", 2);
+		CHECK(trigger.calls == 2);
+		CHECK(after.calls == 2);
+		CHECK(after.last_value == 2);
+	}
+
 	SUBCASE("Connecting and then disconnecting many signals should not leave anything behind") {
 		List<Object::Connection> signal_connections;
 		Object targets[100];
@@ -0,0 +1,164 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/frame_arena.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Bump allocation and alignment") {
+	FrameArena::end_frame();
+	CHECK(FrameArena::get_thread_usage() == 0);
+
+	uint8_t *a = (uint8_t *)FrameArena::alloc(3);
+	uint8_t *b = (uint8_t *)FrameArena::alloc(5);
+	uint8_t *c = (uint8_t *)FrameArena::alloc(8, 64);
+	REQUIRE(a != nullptr);
+	REQUIRE(b != nullptr);
+	REQUIRE(c != nullptr);
+
+	CHECK(((uintptr_t)a % FrameArena::DEFAULT_ALIGNMENT) == 0);
+	CHECK(((uintptr_t)b % FrameArena::DEFAULT_ALIGNMENT) == 0);
+	CHECK(((uintptr_t)c % 64) == 0);
+	CHECK(b >= a + 3);
+	CHECK(c >= b + 5);
+	CHECK(FrameArena::get_thread_usage() >= 16);
+}
+
+TEST_CASE("[FrameArena] Zero-size allocations") {
+	FrameArena::release_thread_memory();
+
+	// No block is allocated yet, the allocation must still be valid and distinct.
+	uint8_t *a = (uint8_t *)FrameArena::alloc(0);
+	uint8_t *b = (uint8_t *)FrameArena::alloc(0);
+	REQUIRE(a != nullptr);
+	REQUIRE(b != nullptr);
+	CHECK(a != b);
+	CHECK(FrameArena::get_thread_usage() > 0);
+}
+
+TEST_CASE("[FrameArena] Realloc and free of the latest allocation") {
+	FrameArena::end_frame();
+
+	uint32_t *a = (uint32_t *)FrameArena::alloc(sizeof(uint32_t) * 4);
+	for (uint32_t i = 0; i < 4; i++) {
+		a[i] = i;
+	}
+	CHECK_MESSAGE(FrameArena::realloc(a, sizeof(uint32_t) * 4, sizeof(uint32_t) * 64) == a, "The latest allocation should grow in place.");
+
+	void *b = FrameArena::alloc(16);
+	uint32_t *moved = (uint32_t *)FrameArena::realloc(a, sizeof(uint32_t) * 64, sizeof(uint32_t) * 128);
+	CHECK_MESSAGE(moved != a, "Older allocations should move.");
+	bool kept = true;
+	for (uint32_t i = 0; i < 4; i++) {
+		kept &= moved[i] == i;
+	}
+	CHECK(kept);
+
+	FrameArena::free(b); // Not the latest anymore, ignored.
+	const size_t usage = FrameArena::get_thread_usage();
+	void *c = FrameArena::alloc(32);
+	FrameArena::free(c);
+	CHECK_MESSAGE(FrameArena::get_thread_usage() == usage, "Freeing the latest allocation should give it back.");
+}
+
+TEST_CASE("[FrameArena] Blocks are reused across frames") {
+	FrameArena::end_frame();
+	uint8_t *first = (uint8_t *)FrameArena::alloc(64);
+
+	// Spill over several blocks.
+	for (int i = 0; i < 64; i++) {
+		REQUIRE(FrameArena::alloc(16 * 1024) != nullptr);
+	}
+	CHECK(FrameArena::get_thread_usage() >= 64 * 16 * 1024);
+
+	FrameArena::end_frame();
+	CHECK(FrameArena::get_thread_usage() == 0);
+
+	// After a rewind the blocks are merged into one, so the whole frame fits again.
+	uint8_t *start = (uint8_t *)FrameArena::alloc(64);
+	for (int i = 0; i < 64; i++) {
+		uint8_t *mem = (uint8_t *)FrameArena::alloc(16 * 1024);
+		REQUIRE(mem != nullptr);
+		CHECK(mem < start + 2 * 1024 * 1024);
+		CHECK(mem > start);
+	}
+	(void)first;
+
+	FrameArena::release_thread_memory();
+	CHECK(FrameArena::get_thread_usage() == 0);
+}
+
+static SafeNumeric<uint32_t> thread_failures;
+
+static void static_thread_alloc(void *p_userdata, uint32_t p_index) {
+	uint32_t *mem = (uint32_t *)FrameArena::alloc(sizeof(uint32_t) * 64);
+	for (uint32_t i = 0; i < 64; i++) {
+		mem[i] = p_index;
+	}
+	for (uint32_t i = 0; i < 64; i++) {
+		if (mem[i] != p_index) {
+			thread_failures.increment();
+			break;
+		}
+	}
+	// Pool threads don't have a frame loop, each element ends its own frame.
+	FrameArena::end_frame();
+}
+
+TEST_CASE("[FrameArena] Per-thread arenas") {
+	thread_failures.set(0);
+	for (int frame = 0; frame < 4; frame++) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_thread_alloc, nullptr, 10000, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		FrameArena::end_frame();
+	}
+	CHECK(thread_failures.get() == 0);
+}
+
+TEST_CASE("[FrameArena] Frames are owned by threads") {
+	FrameArena::end_frame();
+	const FrameArena::Frame frame = FrameArena::get_frame();
+	CHECK(FrameArena::is_current(frame));
+
+	// Pool threads ending their own frames don't end the one of this thread.
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_thread_alloc, nullptr, 1000, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	CHECK(FrameArena::is_current(frame));
+
+	FrameArena::end_frame();
+	CHECK_FALSE(FrameArena::is_current(frame));
+}
+
+} // namespace TestFrameArena
@@ -0,0 +1,214 @@
+/**************************************************************************/
+/*  test_small_allocator.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/os/small_allocator.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallAllocator {
+
+TEST_CASE("[SmallAllocator] Size classes") {
+	CHECK(SmallAllocator::get_block_size(nullptr) == 0);
+
+	const size_t sizes[] = { 1, 8, 16, 17, 100, 250, 257, 700, 1000, 1024 };
+	const size_t expected[] = { 16, 16, 16, 32, 112, 256, 320, 768, 1024, 1024 };
+	for (int i = 0; i < 10; i++) {
+		uint8_t *mem = (uint8_t *)SmallAllocator::alloc(sizes[i]);
+		REQUIRE(mem != nullptr);
+		CHECK_MESSAGE(SmallAllocator::get_block_size(mem) == expected[i], vformat("Block size for %d bytes.", (int64_t)sizes[i]));
+		CHECK_MESSAGE(((uintptr_t)mem & 15) == 0, "Blocks should be 16-byte aligned.");
+		memset(mem, 0xAB, sizes[i]);
+		SmallAllocator::free(mem);
+	}
+
+	void *large = SmallAllocator::alloc(SmallAllocator::MAX_SMALL_SIZE + 1);
+	REQUIRE(large != nullptr);
+	CHECK_MESSAGE(SmallAllocator::get_block_size(large) == 0, "Large blocks should come from the system allocator.");
+	SmallAllocator::free(large);
+
+	// Freeing blocks it did not allocate is allowed.
+	SmallAllocator::free(malloc(32));
+	SmallAllocator::free(nullptr);
+}
+
+TEST_CASE("[SmallAllocator] Reuse and distinct blocks") {
+	LocalVector<uint32_t *> blocks;
+	for (uint32_t i = 0; i < 10000; i++) {
+		uint32_t *block = (uint32_t *)SmallAllocator::alloc(sizeof(uint32_t) * 4);
+		block[0] = i;
+		block[3] = i;
+		blocks.push_back(block);
+	}
+
+	bool intact = true;
+	for (uint32_t i = 0; i < blocks.size(); i++) {
+		intact &= blocks[i][0] == i && blocks[i][3] == i;
+	}
+	CHECK_MESSAGE(intact, "Blocks should not overlap.");
+
+	for (uint32_t *block : blocks) {
+		SmallAllocator::free(block);
+	}
+
+	void *reused = SmallAllocator::alloc(16);
+	CHECK_MESSAGE(blocks.has((uint32_t *)reused), "Freed blocks should be reused.");
+	SmallAllocator::free(reused);
+}
+
+TEST_CASE("[SmallAllocator] Realloc") {
+	uint8_t *mem = (uint8_t *)SmallAllocator::realloc(nullptr, 20);
+	REQUIRE(mem != nullptr);
+	for (int i = 0; i < 20; i++) {
+		mem[i] = i;
+	}
+
+	CHECK_MESSAGE(SmallAllocator::realloc(mem, 32) == mem, "Growing within the size class should keep the block.");
+
+	mem = (uint8_t *)SmallAllocator::realloc(mem, 600);
+	REQUIRE(mem != nullptr);
+	CHECK(SmallAllocator::get_block_size(mem) == 640);
+
+	mem = (uint8_t *)SmallAllocator::realloc(mem, 4096);
+	REQUIRE(mem != nullptr);
+	CHECK(SmallAllocator::get_block_size(mem) == 0);
+
+	bool kept = true;
+	for (int i = 0; i < 20; i++) {
+		kept &= mem[i] == i;
+	}
+	CHECK_MESSAGE(kept, "Contents should be kept when moving between size classes.");
+
+	CHECK(SmallAllocator::realloc(SmallAllocator::alloc(64), 0) == nullptr);
+	SmallAllocator::free(mem);
+}
+
+static LocalVector<void *> cross_thread_blocks;
+
+static void static_alloc_task(void *p_userdata, uint32_t p_index) {
+	cross_thread_blocks[p_index] = SmallAllocator::alloc(16 + (p_index % 64) * 16);
+}
+
+static void static_free_task(void *p_userdata, uint32_t p_index) {
+	SmallAllocator::free(cross_thread_blocks[p_index]);
+	cross_thread_blocks[p_index] = nullptr;
+}
+
+TEST_CASE("[SmallAllocator] Blocks freed on another thread") {
+	const uint32_t count = 20000;
+	cross_thread_blocks.clear();
+	cross_thread_blocks.resize(count);
+
+	for (int round = 0; round < 3; round++) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_alloc_task, nullptr, count, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+		bool sizes_match = true;
+		for (uint32_t i = 0; i < count; i++) {
+			sizes_match &= SmallAllocator::get_block_size(cross_thread_blocks[i]) == 16 + (i % 64) * 16;
+		}
+		CHECK(sizes_match);
+
+		if (round == 1) {
+			// Free on this thread what the pool allocated.
+			for (uint32_t i = 0; i < count; i++) {
+				static_free_task(nullptr, i);
+			}
+		} else {
+			group = WorkerThreadPool::get_singleton()->add_native_group_task(static_free_task, nullptr, count, -1, true);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		}
+	}
+
+	cross_thread_blocks.reset();
+}
+
+TEST_CASE("[SmallAllocator] Usage statistics") {
+	const uint64_t usage = SmallAllocator::get_usage();
+	const uint64_t allocs = SmallAllocator::get_alloc_count();
+
+	SmallAllocator::add_usage(1 << 20, 3);
+	CHECK(SmallAllocator::get_usage() >= usage + (1 << 20));
+	CHECK(SmallAllocator::get_alloc_count() >= allocs + 3);
+	CHECK(SmallAllocator::get_max_usage() >= usage + (1 << 20));
+
+	SmallAllocator::add_usage(-(1 << 20), -3);
+	CHECK(SmallAllocator::get_max_usage() >= SmallAllocator::get_usage());
+}
+
+static void static_benchmark_task(void *p_use_small_allocator, uint32_t p_index) {
+	void *blocks[64];
+	for (int round = 0; round < 32; round++) {
+		if (p_use_small_allocator) {
+			for (int i = 0; i < 64; i++) {
+				blocks[i] = SmallAllocator::alloc(16 + ((p_index + i) % 16) * 32);
+			}
+			for (int i = 0; i < 64; i++) {
+				SmallAllocator::free(blocks[i]);
+			}
+		} else {
+			for (int i = 0; i < 64; i++) {
+				blocks[i] = malloc(16 + ((p_index + i) % 16) * 32);
+			}
+			for (int i = 0; i < 64; i++) {
+				free(blocks[i]);
+			}
+		}
+	}
+}
+
+TEST_CASE("[SmallAllocator][Benchmark] Allocation throughput under WorkerThreadPool load" * doctest::skip()) {
+	const uint32_t element_count = 20000;
+	const double allocations = element_count * 32.0 * 64.0;
+
+	for (int use_small_allocator = 0; use_small_allocator < 2; use_small_allocator++) {
+		void *userdata = (void *)(uintptr_t)use_small_allocator;
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < element_count; i++) {
+			static_benchmark_task(userdata, i);
+		}
+		uint64_t single_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_benchmark_task, userdata, element_count, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		uint64_t pool_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+		MESSAGE(vformat("%s: %.1f M allocs/s on one thread, %.1f M allocs/s on %d pool threads.",
+				use_small_allocator ? "SmallAllocator" : "malloc",
+				allocations / single_usec, allocations / pool_usec, WorkerThreadPool::get_singleton()->get_thread_count()));
+	}
+}
+
+} // namespace TestSmallAllocator
@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "test_string_name_interning";
+	const StringName b = String("test_string_name_interning");
+	const StringName c = StringName(StaticCString::create("test_string_name_interning"));
+	CHECK(a == b);
+	CHECK(a == c);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(StringName::search("test_string_name_interning") == a);
+	CHECK(StringName::search("test_string_name_never_interned") == StringName());
+	CHECK(StringName() == StringName(""));
+}
+
+static const uint32_t NAME_COUNT = 2048;
+static LocalVector<String> names;
+static LocalVector<StringName> interned;
+static SafeNumeric<uint32_t> mismatches;
+
+static void static_intern_task(void *p_userdata, uint32_t p_index) {
+	const uint32_t name_index = p_index % NAME_COUNT;
+	StringName name = names[name_index];
+	if (name.data_unique_pointer() != interned[name_index].data_unique_pointer()) {
+		mismatches.increment();
+	}
+	// Create and drop a name only this element uses, so removal races with lookups too.
+	StringName unique = vformat("%s_%d", names[name_index], p_index);
+	if (unique != StringName::search(String(unique))) {
+		mismatches.increment();
+	}
+}
+
+TEST_CASE("[StringName] Interning from many threads") {
+	names.resize(NAME_COUNT);
+	interned.resize(NAME_COUNT);
+	for (uint32_t i = 0; i < NAME_COUNT; i++) {
+		names[i] = vformat("test_string_name_threads_%d", i);
+		interned[i] = names[i];
+	}
+	mismatches.set(0);
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_intern_task, nullptr, NAME_COUNT * 16, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	CHECK(mismatches.get() == 0);
+
+	interned.reset();
+	names.reset();
+}
+
+static void static_benchmark_task(void *p_userdata, uint32_t p_index) {
+	for (uint32_t i = 0; i < 64; i++) {
+		StringName name = names[(p_index * 64 + i) % NAME_COUNT];
+	}
+}
+
+TEST_CASE("[StringName][Benchmark] Interning contention from multiple threads" * doctest::skip()) {
+	names.resize(NAME_COUNT);
+	for (uint32_t i = 0; i < NAME_COUNT; i++) {
+		names[i] = vformat("test_string_name_benchmark_%d", i);
+	}
+	const uint32_t element_count = 100000;
+
+	// Names don't exist yet on the first pass, so it measures inserts and removals, the second one lookups.
+	LocalVector<StringName> kept;
+	for (int pass = 0; pass < 2; pass++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < element_count; i++) {
+			static_benchmark_task(nullptr, i);
+		}
+		uint64_t single_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_benchmark_task, nullptr, element_count, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		uint64_t pool_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+		MESSAGE(vformat("%s: %.2f M names/s on one thread, %.2f M names/s on %d pool threads.",
+				pass == 0 ? "Insert and remove" : "Lookup",
+				element_count * 64.0 / single_usec, element_count * 64.0 / pool_usec, WorkerThreadPool::get_singleton()->get_thread_count()));
+
+		for (const String &name : names) {
+			kept.push_back(name);
+		}
+	}
+
+	kept.reset();
+	names.reset();
+}
+
+} // namespace TestStringName
@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  test_frame_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/frame_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameHashMap {
+
+TEST_CASE("[FrameHashMap] Insert, lookup and erase.") {
+	FrameHashMap<int, int> map;
+	CHECK(map.is_empty());
+
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i * 2);
+	}
+	CHECK(map.size() == 1000);
+
+	bool found = true;
+	for (int i = 0; i < 1000; i++) {
+		const int *value = map.getptr(i);
+		found &= value && *value == i * 2;
+	}
+	CHECK(found);
+	CHECK_FALSE(map.has(1000));
+
+	map[5] = 7;
+	CHECK(map.get(5) == 7);
+	map[2000] += 3;
+	CHECK(map.get(2000) == 3);
+	CHECK(map.size() == 1001);
+
+	for (int i = 0; i < 1000; i += 2) {
+		CHECK(map.erase(i));
+	}
+	CHECK_FALSE(map.erase(0));
+	CHECK(map.size() == 501);
+
+	bool remaining = true;
+	for (int i = 0; i < 1000; i++) {
+		remaining &= map.has(i) == (i % 2 == 1);
+	}
+	CHECK(remaining);
+
+	int count = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(map.get(E.key) == E.value);
+		count++;
+	}
+	CHECK(count == 501);
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK_FALSE(map.has(1));
+}
+
+TEST_CASE("[FrameHashMap] Insertion order.") {
+	FrameHashMap<int, int> map;
+	map.insert(30, 0);
+	map.insert(10, 1);
+	map.insert(20, 2);
+
+	int expected = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.value == expected);
+		expected++;
+	}
+}
+
+TEST_CASE("[FrameHashMap] Contents are dropped at the end of the frame.") {
+	FrameHashMap<int, int> map;
+	map.insert(1, 1);
+	CHECK(map.has(1));
+
+	FrameArena::end_frame();
+	CHECK(map.is_empty());
+	CHECK_FALSE(map.has(1));
+	CHECK(map.begin() == map.end());
+
+	map.insert(2, 2);
+	CHECK(map.size() == 1);
+	CHECK(map.get(2) == 2);
+}
+
+} // namespace TestFrameHashMap
@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*  test_frame_local_vector.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/semaphore.h"
+#include "core/templates/frame_local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameLocalVector {
+
+TEST_CASE("[FrameLocalVector] Push back, resize and sort.") {
+	FrameLocalVector<int> vector;
+	CHECK(vector.is_empty());
+
+	for (int i = 0; i < 100; i++) {
+		vector.push_back(99 - i);
+	}
+	CHECK(vector.size() == 100);
+	CHECK(vector[0] == 99);
+	CHECK(vector.has(42));
+	CHECK(vector.find(42) == 57);
+
+	vector.sort();
+	bool sorted = true;
+	for (int i = 0; i < 100; i++) {
+		sorted &= vector[i] == i;
+	}
+	CHECK(sorted);
+
+	vector.resize(10);
+	CHECK(vector.size() == 10);
+	CHECK(vector[9] == 9);
+
+	CHECK(vector.erase_unordered(0));
+	CHECK(vector.size() == 9);
+	CHECK(vector[0] == 9);
+
+	int sum = 0;
+	for (int value : vector) {
+		sum += value;
+	}
+	CHECK(sum == 45);
+
+	vector.clear();
+	CHECK(vector.is_empty());
+}
+
+TEST_CASE("[FrameLocalVector] Contents are dropped at the end of the frame.") {
+	FrameLocalVector<uint64_t> vector;
+	vector.push_back(1);
+	vector.push_back(2);
+	CHECK(vector.size() == 2);
+
+	FrameArena::end_frame();
+	CHECK(vector.is_empty());
+	CHECK(vector.ptr() == nullptr);
+
+	vector.push_back(3);
+	CHECK(vector.size() == 1);
+	CHECK(vector[0] == 3);
+}
+
+TEST_CASE("[FrameLocalVector] Iterating a vector from an ended frame is empty.") {
+	FrameLocalVector<int> vector;
+	vector.push_back(1);
+	FrameArena::end_frame();
+
+	int iterations = 0;
+	for (int value : vector) {
+		iterations += value;
+	}
+	CHECK(iterations == 0);
+}
+
+struct FillAcrossFrameData {
+	FrameLocalVector<uint32_t> values;
+	Semaphore half_filled;
+	Semaphore main_frame_ended;
+};
+
+static void fill_across_main_frame(void *p_userdata) {
+	FillAcrossFrameData *data = (FillAcrossFrameData *)p_userdata;
+	for (uint32_t i = 0; i < 100; i++) {
+		data->values.push_back(i);
+	}
+	data->half_filled.post();
+	data->main_frame_ended.wait();
+	for (uint32_t i = 100; i < 1000; i++) {
+		data->values.push_back(i);
+	}
+}
+
+TEST_CASE("[FrameLocalVector] Ending the main thread frame keeps vectors filled by other threads.") {
+	FillAcrossFrameData data;
+	WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(fill_across_main_frame, &data, true);
+	data.half_filled.wait();
+	FrameArena::end_frame();
+	data.main_frame_ended.post();
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+
+	REQUIRE(data.values.size() == 1000);
+	bool kept = true;
+	for (uint32_t i = 0; i < 1000; i++) {
+		kept &= data.values[i] == i;
+	}
+	CHECK(kept);
+}
+
+} // namespace TestFrameLocalVector
@@ -0,0 +1,120 @@
+/**************************************************************************/
+/*  test_perfect_hash_map.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/string_name.h"
+#include "core/templates/perfect_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPerfectHashMap {
+
+TEST_CASE("[PerfectHashMap] Empty map") {
+	PerfectHashMap<int, int> map;
+	CHECK(map.build(LocalVector<Pair<int, int>>()));
+	CHECK(map.is_empty());
+	CHECK(map.size() == 0);
+	CHECK(map.getptr(42) == nullptr);
+	CHECK_FALSE(map.has(42));
+}
+
+TEST_CASE("[PerfectHashMap] Build and lookup") {
+	for (int count : { 1, 2, 3, 17, 100, 1000, 10000 }) {
+		LocalVector<Pair<int, int>> entries;
+		for (int i = 0; i < count; i++) {
+			entries.push_back(Pair<int, int>(i * 7, i));
+		}
+
+		PerfectHashMap<int, int> map;
+		REQUIRE(map.build(entries));
+		CHECK(map.size() == uint32_t(count));
+
+		bool all_found = true;
+		bool none_extra = true;
+		for (int i = 0; i < count; i++) {
+			const int *value = map.getptr(i * 7);
+			all_found = all_found && value && *value == i;
+			none_extra = none_extra && !map.has(i * 7 + 1);
+		}
+		CHECK_MESSAGE(all_found, vformat("All %d keys should be found with their value.", count));
+		CHECK_MESSAGE(none_extra, vformat("Keys missing from a map of %d entries should not be found.", count));
+	}
+}
+
+TEST_CASE("[PerfectHashMap] StringName keys") {
+	LocalVector<Pair<StringName, int>> entries;
+	entries.push_back(Pair<StringName, int>("position", 0));
+	entries.push_back(Pair<StringName, int>("rotation", 1));
+	entries.push_back(Pair<StringName, int>("scale", 2));
+
+	PerfectHashMap<StringName, int> map;
+	REQUIRE(map.build(entries));
+	REQUIRE(map.getptr("rotation"));
+	CHECK(*map.getptr("rotation") == 1);
+	CHECK(*map.getptr("scale") == 2);
+	CHECK_FALSE(map.has("skew"));
+}
+
+TEST_CASE("[PerfectHashMap] Rebuild and clear") {
+	LocalVector<Pair<int, int>> entries;
+	entries.push_back(Pair<int, int>(1, 10));
+	PerfectHashMap<int, int> map;
+	REQUIRE(map.build(entries));
+
+	entries.clear();
+	entries.push_back(Pair<int, int>(2, 20));
+	entries.push_back(Pair<int, int>(3, 30));
+	REQUIRE(map.build(entries));
+	CHECK(map.size() == 2);
+	CHECK_FALSE(map.has(1));
+	CHECK(*map.getptr(3) == 30);
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK_FALSE(map.has(3));
+}
+
+struct CollidingHasher {
+	static _FORCE_INLINE_ uint32_t hash(int p_key) { return 1234; }
+};
+
+TEST_CASE("[PerfectHashMap] Colliding hashes fail to build") {
+	LocalVector<Pair<int, int>> entries;
+	entries.push_back(Pair<int, int>(1, 10));
+	entries.push_back(Pair<int, int>(2, 20));
+
+	PerfectHashMap<int, int, CollidingHasher> map;
+	CHECK_FALSE(map.build(entries));
+	CHECK(map.is_empty());
+	CHECK_FALSE(map.has(1));
+}
+
+} // namespace TestPerfectHashMap
@@ -251,6 +251,68 @@ TEST_CASE("[RID_Owner] Thread safety") {
 		tester.test();
 	}
 }
+
+static uint64_t churn_rids(RID_Owner<uint64_t, true> &p_owner, uint32_t p_thread_count, uint32_t p_iterations, SafeNumeric<uint32_t> &r_errors) {
+	struct ChurnData {
+		RID_Owner<uint64_t, true> *owner = nullptr;
+		uint32_t iterations = 0;
+		SafeNumeric<uint32_t> *errors = nullptr;
+	} data = { &p_owner, p_iterations, &r_errors };
+
+	TightLocalVector<Thread> threads;
+	threads.resize(p_thread_count);
+	const uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (Thread &thread : threads) {
+		thread.start(
+				[](void *p_data) {
+					ChurnData *cd = (ChurnData *)p_data;
+					LocalVector<RID> rids;
+					for (uint32_t i = 0; i < cd->iterations; i++) {
+						// Keep a few RIDs alive, so frees interleave with allocations.
+						if (rids.size() < 32 && i % 3 != 2) {
+							rids.push_back(cd->owner->make_rid(i));
+						} else if (!rids.is_empty()) {
+							RID rid = rids[rids.size() - 1];
+							rids.resize(rids.size() - 1);
+							if (cd->owner->get_or_null(rid) == nullptr) {
+								cd->errors->increment();
+							}
+							cd->owner->free(rid);
+							if (cd->owner->owns(rid)) {
+								cd->errors->increment();
+							}
+						}
+					}
+					for (const RID &rid : rids) {
+						cd->owner->free(rid);
+					}
+				},
+				&data);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+	return OS::get_singleton()->get_ticks_usec() - start;
+}
+
+TEST_CASE("[RID_Owner] Making and freeing from multiple threads") {
+	RID_Owner<uint64_t, true> owner(sizeof(uint64_t) * 16);
+	SafeNumeric<uint32_t> errors;
+	churn_rids(owner, 4, 10000, errors);
+
+	CHECK(errors.get() == 0);
+	CHECK(owner.get_rid_count() == 0);
+}
+
+TEST_CASE("[RID_Owner][Benchmark] Making and freeing from multiple threads" * doctest::skip()) {
+	const uint32_t iterations = 1000000;
+	for (int threads = 1; threads <= OS::get_singleton()->get_processor_count(); threads *= 2) {
+		RID_Owner<uint64_t, true> owner;
+		SafeNumeric<uint32_t> errors;
+		const uint64_t usec = churn_rids(owner, threads, iterations, errors);
+		MESSAGE(vformat("%d threads: %.2f M operations/s.", threads, double(threads) * iterations / usec));
+	}
+}
 #endif // THREADS_ENABLED
 
 } // namespace TestRID
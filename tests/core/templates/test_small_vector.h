@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*  test_small_vector.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/small_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallVector {
+
+TEST_CASE("[SmallVector] Push back and spill to heap") {
+	SmallVector<int, 4> vector;
+	CHECK(vector.is_empty());
+	CHECK(vector.is_inline());
+
+	for (int i = 0; i < 4; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == 4);
+	CHECK(vector.is_inline());
+
+	vector.push_back(4);
+	CHECK(vector.size() == 5);
+	CHECK_FALSE(vector.is_inline());
+	for (int i = 0; i < 5; i++) {
+		CHECK(vector[i] == i);
+	}
+}
+
+TEST_CASE("[SmallVector] Remove and return inline") {
+	SmallVector<String, 2> vector = { "a", "b", "c" };
+	CHECK_FALSE(vector.is_inline());
+
+	vector.remove_at(0);
+	CHECK(vector.is_inline());
+	CHECK(vector.size() == 2);
+	CHECK(vector[0] == "b");
+	CHECK(vector[1] == "c");
+
+	CHECK(vector.erase("c"));
+	CHECK_FALSE(vector.erase("c"));
+	CHECK(vector.size() == 1);
+	CHECK(vector.find("b") == 0);
+	CHECK_FALSE(vector.has("a"));
+}
+
+TEST_CASE("[SmallVector] Resize") {
+	SmallVector<int, 4> vector;
+	vector.resize(3);
+	CHECK(vector.is_inline());
+	vector.write[2] = 7;
+
+	vector.resize(10);
+	CHECK_FALSE(vector.is_inline());
+	CHECK(vector.size() == 10);
+	CHECK(vector[2] == 7);
+
+	vector.resize(2);
+	CHECK(vector.is_inline());
+	CHECK(vector.size() == 2);
+
+	vector.clear();
+	CHECK(vector.is_empty());
+}
+
+TEST_CASE("[SmallVector] Copy on write") {
+	SmallVector<int, 2> vector = { 1, 2, 3, 4 };
+	SmallVector<int, 2> copy = vector;
+	// Heap contents are shared until written to.
+	CHECK(copy.ptr() == vector.ptr());
+
+	copy.write[0] = 9;
+	CHECK(copy.ptr() != vector.ptr());
+	CHECK(vector[0] == 1);
+	CHECK(copy[0] == 9);
+
+	SmallVector<int, 2> small = { 1 };
+	SmallVector<int, 2> small_copy = small;
+	small_copy.write[0] = 2;
+	CHECK(small[0] == 1);
+}
+
+TEST_CASE("[SmallVector] Conversion from and to Vector") {
+	Vector<int> vector = { 1, 2, 3 };
+	SmallVector<int, 2> from_large = vector;
+	CHECK(from_large.ptr() == vector.ptr());
+
+	SmallVector<int, 4> from_small = vector;
+	CHECK(from_small.is_inline());
+
+	Vector<int> back = from_small.to_vector();
+	CHECK(back == vector);
+	CHECK(from_large.to_vector().ptr() == vector.ptr());
+}
+
+TEST_CASE("[SmallVector] Iteration") {
+	SmallVector<int, 3> vector = { 1, 2, 3 };
+	int sum = 0;
+	for (int &value : vector) {
+		value *= 2;
+	}
+	for (const int &value : vector) {
+		sum += value;
+	}
+	CHECK(sum == 12);
+}
+
+} // namespace TestSmallVector
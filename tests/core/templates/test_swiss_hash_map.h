@@ -0,0 +1,277 @@
+/**************************************************************************/
+/*  test_swiss_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/oa_hash_map.h"
+#include "core/templates/swiss_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSwissHashMap {
+
+TEST_CASE("[SwissHashMap] List initialization") {
+	SwissHashMap<int, String> map{ { 0, "A" }, { 1, "B" }, { 2, "C" }, { 3, "D" }, { 4, "E" } };
+
+	CHECK(map.size() == 5);
+	CHECK(map[0] == "A");
+	CHECK(map[1] == "B");
+	CHECK(map[2] == "C");
+	CHECK(map[3] == "D");
+	CHECK(map[4] == "E");
+}
+
+TEST_CASE("[SwissHashMap] Insert, overwrite and erase") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+
+	map.insert(42, 1234);
+	CHECK(map.size() == 1);
+	CHECK(map[42] == 1234);
+
+	CHECK(map.erase(42));
+	CHECK_FALSE(map.erase(42));
+	CHECK_FALSE(map.has(42));
+	CHECK_FALSE(map.find(42));
+	CHECK(map.is_empty());
+
+	e = map.insert(7, 8);
+	map.remove(e);
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[SwissHashMap] Many elements") {
+	SwissHashMap<int, int> map;
+	const int count = 50000;
+	for (int i = 0; i < count; i++) {
+		map.insert(i * 3, i);
+	}
+	CHECK(map.size() == count);
+	CHECK(map.get_capacity() >= count);
+
+	bool all_found = true;
+	bool none_extra = true;
+	for (int i = 0; i < count; i++) {
+		const int *value = map.getptr(i * 3);
+		all_found = all_found && value && *value == i;
+		none_extra = none_extra && !map.has(i * 3 + 1);
+	}
+	CHECK(all_found);
+	CHECK(none_extra);
+
+	// Erasing and adding again goes through slots marked as deleted.
+	for (int i = 0; i < count; i += 2) {
+		map.erase(i * 3);
+	}
+	for (int i = 0; i < count; i += 4) {
+		map.insert(i * 3, -i);
+	}
+	CHECK(map.size() == count / 2 + count / 4);
+	CHECK(map[0] == 0);
+	CHECK(map[12] == -4);
+	CHECK(map[3] == 1);
+	CHECK_FALSE(map.has(6));
+}
+
+TEST_CASE("[SwissHashMap] Iteration order") {
+	SwissHashMap<int, int, HashMapHasherDefault, HashMapComparatorDefault<int>, true> stable;
+	for (int i = 0; i < 100; i++) {
+		stable.insert(i, i);
+	}
+	for (int i = 0; i < 100; i += 3) {
+		stable.erase(i);
+	}
+	stable.insert(1000, 1000);
+
+	// Insertion order is kept when erasing, even after rehashing.
+	int last = -1;
+	bool ordered = true;
+	uint32_t count = 0;
+	for (const KeyValue<int, int> &E : stable) {
+		ordered = ordered && E.key > last && E.key % 3 != 0;
+		last = E.key;
+		count++;
+	}
+	CHECK(ordered);
+	CHECK(count == stable.size());
+	stable.reserve(1000);
+	CHECK(stable.begin()->key == 1);
+
+	// Without stable order, the last element takes the place of an erased one.
+	SwissHashMap<int, int> map;
+	map.insert(1, 1);
+	map.insert(2, 2);
+	map.insert(3, 3);
+	map.erase(1);
+	SwissHashMap<int, int>::Iterator it = map.begin();
+	CHECK(it->key == 3);
+	++it;
+	CHECK(it->key == 2);
+	++it;
+	CHECK_FALSE(it);
+}
+
+TEST_CASE("[SwissHashMap] StringName and Variant keys") {
+	SwissHashMap<StringName, int> names;
+	names.insert("position", 1);
+	names.insert(StringName("rotation"), 2);
+	CHECK(names.has("position"));
+	CHECK(names["rotation"] == 2);
+	CHECK_FALSE(names.has("scale"));
+
+	SwissHashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator, true> variants;
+	variants.insert(1, "int");
+	variants.insert("text", 2.5);
+	variants.insert(Vector2(1, 2), Variant());
+	CHECK(variants[1] == Variant("int"));
+	CHECK(variants.has(StringName("text")));
+	CHECK(variants.has(Vector2(1, 2)));
+	CHECK_FALSE(variants.has(2));
+}
+
+TEST_CASE("[SwissHashMap] Copy and clear") {
+	SwissHashMap<int, String> map;
+	map.insert(1, "A");
+	map.insert(2, "B");
+
+	SwissHashMap<int, String> copy = map;
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK_FALSE(map.has(1));
+	CHECK(copy.size() == 2);
+	CHECK(copy[2] == "B");
+
+	map = copy;
+	CHECK(map[1] == "A");
+	map.reset();
+	CHECK(map.is_empty());
+	map.insert(3, "C");
+	CHECK(map[3] == "C");
+}
+
+template <typename TKey>
+static TKey make_key(int p_index);
+
+template <>
+int make_key<int>(int p_index) {
+	return p_index * 7919;
+}
+
+template <>
+StringName make_key<StringName>(int p_index) {
+	return StringName(vformat("benchmark_key_%d", p_index));
+}
+
+template <typename TMap, typename TKey>
+static void map_insert(TMap &r_map, const TKey &p_key, int p_value) {
+	r_map.insert(p_key, p_value);
+}
+
+template <typename TKey>
+static void map_insert(OAHashMap<TKey, int> &r_map, const TKey &p_key, int p_value) {
+	r_map.set(p_key, p_value);
+}
+
+template <typename TMap, typename TKey>
+static const int *map_get(const TMap &p_map, const TKey &p_key) {
+	return p_map.getptr(p_key);
+}
+
+template <typename TKey>
+static const int *map_get(const OAHashMap<TKey, int> &p_map, const TKey &p_key) {
+	return p_map.lookup_ptr(p_key);
+}
+
+template <typename TMap, typename TKey>
+static void benchmark_map(const char *p_name, const LocalVector<TKey> &p_keys, const LocalVector<TKey> &p_missing) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	TMap map;
+	for (uint32_t i = 0; i < p_keys.size(); i++) {
+		map_insert(map, p_keys[i], i);
+	}
+	const uint64_t insert_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int64_t sum = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int pass = 0; pass < 4; pass++) {
+		for (const TKey &key : p_keys) {
+			sum += *map_get(map, key);
+		}
+	}
+	const uint64_t hit_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int pass = 0; pass < 4; pass++) {
+		for (const TKey &key : p_missing) {
+			sum += map_get(map, key) != nullptr;
+		}
+	}
+	const uint64_t miss_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(sum == 4 * int64_t(p_keys.size()) * (p_keys.size() - 1) / 2);
+	const double ops = p_keys.size();
+	MESSAGE(vformat("%s: insert %.1f ns, hit %.1f ns, miss %.1f ns.", p_name,
+			insert_usec * 1000.0 / ops, hit_usec * 1000.0 / (ops * 4), miss_usec * 1000.0 / (ops * 4)));
+}
+
+template <typename TKey>
+static void benchmark_maps(int p_count) {
+	LocalVector<TKey> keys;
+	LocalVector<TKey> missing;
+	for (int i = 0; i < p_count; i++) {
+		keys.push_back(make_key<TKey>(i));
+		missing.push_back(make_key<TKey>(i + p_count));
+	}
+
+	benchmark_map<HashMap<TKey, int>>("HashMap", keys, missing);
+	benchmark_map<AHashMap<TKey, int>>("AHashMap", keys, missing);
+	benchmark_map<OAHashMap<TKey, int>>("OAHashMap", keys, missing);
+	benchmark_map<SwissHashMap<TKey, int>>("SwissHashMap", keys, missing);
+}
+
+TEST_CASE("[SwissHashMap][Benchmark] Compared with the other hash maps" * doctest::skip()) {
+	for (int count : { 100, 10000, 1000000 }) {
+		MESSAGE(vformat("%d int keys:", count));
+		benchmark_maps<int>(count);
+		MESSAGE(vformat("%d StringName keys:", count));
+		benchmark_maps<StringName>(count);
+	}
+}
+
+} // namespace TestSwissHashMap
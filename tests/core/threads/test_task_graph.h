@@ -0,0 +1,162 @@
+/**************************************************************************/
+/*  test_task_graph.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/task_graph.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTaskGraph {
+
+struct StageData {
+	SafeNumeric<uint32_t> clock;
+	uint32_t finished_at[8] = {};
+	LocalVector<uint32_t> values;
+	uint32_t sum = 0;
+};
+
+static StageData *stage_data = nullptr;
+
+static void stage_task(void *p_stage) {
+	stage_data->finished_at[(uintptr_t)p_stage] = stage_data->clock.increment();
+}
+
+static void fill_element(void *p_userdata, uint32_t p_index) {
+	stage_data->values[p_index] = p_index + 1;
+}
+
+static void sum_elements(void *p_userdata) {
+	uint32_t sum = 0;
+	for (uint32_t value : stage_data->values) {
+		sum += value;
+	}
+	stage_data->sum = sum;
+	stage_task(p_userdata);
+}
+
+TEST_CASE("[TaskGraph] Nodes run after their dependencies") {
+	StageData data;
+	stage_data = &data;
+	data.values.resize(1000);
+
+	TaskGraph graph;
+	// 0 -> fill (group) -> 2 (sum) -> 4
+	// 0 -> 3 -----------------------> 4
+	TaskGraph::NodeID first = graph.add_native_node(stage_task, (void *)0);
+	TaskGraph::NodeID fill = graph.add_native_group_node(fill_element, nullptr, data.values.size());
+	TaskGraph::NodeID sum = graph.add_native_node(sum_elements, (void *)2);
+	TaskGraph::NodeID side = graph.add_native_node(stage_task, (void *)3);
+	TaskGraph::NodeID last = graph.add_native_node(stage_task, (void *)4);
+	graph.add_dependency(fill, first);
+	graph.add_dependency(sum, fill);
+	graph.add_dependency(side, first);
+	graph.add_dependency(last, sum);
+	graph.add_dependency(last, side);
+
+	for (int run = 0; run < 20; run++) {
+		data.clock.set(0);
+		data.sum = 0;
+		memset(data.finished_at, 0, sizeof(data.finished_at));
+		for (uint32_t &value : data.values) {
+			value = 0;
+		}
+
+		CHECK(graph.run() == OK);
+		graph.wait();
+
+		CHECK(data.finished_at[0] == 1);
+		CHECK(data.finished_at[2] > data.finished_at[0]);
+		CHECK(data.finished_at[3] > data.finished_at[0]);
+		CHECK(data.finished_at[4] == 4);
+		CHECK_MESSAGE(data.sum == 1000 * 1001 / 2, "The group node should have completed before its dependent ran.");
+	}
+
+	stage_data = nullptr;
+}
+
+TEST_CASE("[TaskGraph] Empty group nodes and empty graphs") {
+	StageData data;
+	stage_data = &data;
+
+	TaskGraph graph;
+	CHECK(graph.run() == OK);
+	graph.wait();
+
+	TaskGraph::NodeID fill = graph.add_native_group_node(fill_element, nullptr, 0);
+	TaskGraph::NodeID after = graph.add_native_node(stage_task, (void *)1);
+	graph.add_dependency(after, fill);
+	CHECK(graph.run() == OK);
+	graph.wait();
+	CHECK(data.finished_at[1] == 1);
+
+	stage_data = nullptr;
+}
+
+TEST_CASE("[TaskGraph] Critical path") {
+	TaskGraph graph;
+	TaskGraph::NodeID a = graph.add_native_node(stage_task, nullptr);
+	TaskGraph::NodeID b = graph.add_native_node(stage_task, nullptr);
+	TaskGraph::NodeID c = graph.add_native_node(stage_task, nullptr);
+	TaskGraph::NodeID d = graph.add_native_node(stage_task, nullptr);
+	graph.add_dependency(b, a);
+	graph.add_dependency(c, a);
+	graph.add_dependency(d, b);
+	graph.add_dependency(d, c);
+	graph.set_node_cost(b, 1.0);
+	graph.set_node_cost(c, 5.0);
+
+	LocalVector<TaskGraph::NodeID> path = graph.get_critical_path();
+	REQUIRE(path.size() == 3);
+	CHECK(path[0] == a);
+	CHECK(path[1] == c);
+	CHECK(path[2] == d);
+	CHECK(graph.get_critical_path_cost() == doctest::Approx(7.0));
+
+	graph.set_node_cost(b, 10.0);
+	path = graph.get_critical_path();
+	REQUIRE(path.size() == 3);
+	CHECK(path[1] == b);
+}
+
+TEST_CASE("[TaskGraph] Cycles are rejected") {
+	TaskGraph graph;
+	TaskGraph::NodeID a = graph.add_native_node(stage_task, nullptr);
+	TaskGraph::NodeID b = graph.add_native_node(stage_task, nullptr);
+	graph.add_dependency(b, a);
+	graph.add_dependency(a, b);
+
+	ERR_PRINT_OFF;
+	CHECK(graph.run() == ERR_CYCLIC_LINK);
+	ERR_PRINT_ON;
+	CHECK_FALSE(graph.is_running());
+}
+
+} // namespace TestTaskGraph
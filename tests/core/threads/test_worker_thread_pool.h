@@ -84,6 +84,13 @@ static void static_callable_group_test(uint32_t p_index) {
 	counter[p_index].increment();
 	counter[0].sub(2);
 }
+static void static_uneven_group_test(void *p_arg, uint32_t p_index) {
+	if (p_index < 64) {
+		OS::get_singleton()->delay_usec(200);
+	}
+	counter[p_index].increment();
+}
+
 TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	for (int iterations = 0; iterations < 500; iterations++) {
 		const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
@@ -172,4 +179,63 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+TEST_CASE("[WorkerThreadPool] Group tasks with uneven element costs") {
+	// Elements at the start are much more expensive, so tasks that finish their own share have to steal.
+	const int count = 4096;
+	counter.clear();
+	counter.resize(count);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_uneven_group_test, nullptr, count);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	bool all_run_once = true;
+	for (int i = 0; i < count; i++) {
+		all_run_once &= counter[i].get() == 1;
+	}
+	CHECK(all_run_once);
+}
+
+static void static_benchmark_task(void *p_arg) {
+	counter[0].increment();
+}
+
+static void static_benchmark_group_task(void *p_arg, uint32_t p_index) {
+	((uint32_t *)p_arg)[p_index] = p_index * 2654435761u;
+}
+
+TEST_CASE("[WorkerThreadPool][Benchmark] Scaling from one thread to all cores" * doctest::skip()) {
+	const int task_count = 20000;
+	const int element_count = 1 << 22;
+	LocalVector<uint32_t> elements;
+	elements.resize(element_count);
+
+	const int max_threads = OS::get_singleton()->get_processor_count();
+	for (int thread_count = 1; thread_count <= max_threads; thread_count = thread_count < max_threads ? MIN(thread_count * 2, max_threads) : max_threads + 1) {
+		WorkerThreadPool pool(false);
+		pool.init(thread_count);
+
+		counter.clear();
+		counter.resize(1);
+		LocalVector<WorkerThreadPool::TaskID> task_ids;
+		task_ids.resize(task_count);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < task_count; i++) {
+			task_ids[i] = pool.add_native_task(static_benchmark_task, nullptr, true);
+		}
+		for (int i = 0; i < task_count; i++) {
+			pool.wait_for_task_completion(task_ids[i]);
+		}
+		uint64_t task_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = pool.add_native_group_task(static_benchmark_group_task, elements.ptr(), element_count, -1, true);
+		pool.wait_for_group_task_completion(group);
+		uint64_t group_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+		pool.finish();
+
+		MESSAGE(vformat("%d threads: %.0f tasks/s, %.1f M group elements/s.", thread_count, task_count * 1000000.0 / task_usec, double(element_count) / group_usec));
+		CHECK(counter[0].get() == task_count);
+	}
+}
+
 } // namespace TestWorkerThreadPool
@@ -2233,4 +2233,32 @@ TEST_CASE("[Variant] Operator NOT") {
 	}
 }
 
+TEST_CASE("[Variant] Packed array math") {
+	Variant a = PackedFloat32Array({ 1, 2, 3, 4, 5 });
+	Variant b = PackedFloat32Array({ 5, 4, 3, 2, 1 });
+
+	CHECK_EQ(a.call("elementwise_add", b), Variant(PackedFloat32Array({ 6, 6, 6, 6, 6 })));
+	CHECK_EQ(a.call("elementwise_multiply", b), Variant(PackedFloat32Array({ 5, 8, 9, 8, 5 })));
+	CHECK_EQ(a.call("scaled", 2), Variant(PackedFloat32Array({ 2, 4, 6, 8, 10 })));
+	CHECK_EQ(a.call("lerp", b, 0.5), Variant(PackedFloat32Array({ 3, 3, 3, 3, 3 })));
+	CHECK_EQ(a.call("select", PackedByteArray({ 1, 0, 1, 0, 1 }), b), Variant(PackedFloat32Array({ 1, 4, 3, 2, 5 })));
+	CHECK_EQ(a.call("sum"), Variant(15.0));
+	CHECK_EQ(a.call("min"), Variant(1.0));
+	CHECK_EQ(a.call("max"), Variant(5.0));
+
+	ERR_PRINT_OFF;
+	CHECK(PackedFloat32Array(a.call("elementwise_add", PackedFloat32Array({ 1 }))).is_empty());
+	ERR_PRINT_ON;
+
+	Variant points = PackedVector3Array({ Vector3(1, 5, 0), Vector3(3, -1, 2) });
+	CHECK_EQ(points.call("sum"), Variant(Vector3(4, 4, 2)));
+	CHECK_EQ(points.call("min"), Variant(Vector3(1, -1, 0)));
+	CHECK_EQ(points.call("max"), Variant(Vector3(3, 5, 2)));
+	CHECK_EQ(points.call("scaled", 2), Variant(PackedVector3Array({ Vector3(2, 10, 0), Vector3(6, -2, 4) })));
+
+	Variant empty = PackedFloat64Array();
+	CHECK_EQ(empty.call("sum"), Variant(0.0));
+	CHECK_EQ(empty.call("min"), Variant(0.0));
+}
+
 } // namespace TestVariant
@@ -30,6 +30,9 @@
 
 #pragma once
 
+#include "core/os/os.h"
+#include "core/templates/small_vector.h"
+#include "scene/2d/node_2d.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
@@ -280,4 +283,113 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+struct BenchmarkProperty {
+	int name = 0;
+	int value = 0;
+};
+
+template <typename TProperties, typename TGroups>
+struct BenchmarkNodeData {
+	TProperties properties;
+	TGroups groups;
+};
+
+// Fills per node storage the way SceneState::set_bundled_scene() does, to compare containers on the same scene.
+template <typename TProperties, typename TGroups>
+static void _benchmark_node_storage(const char *p_container, const LocalVector<Pair<int, int>> &p_counts) {
+	const uint64_t allocs_before = Memory::get_alloc_count();
+	const uint64_t usage_before = Memory::get_mem_usage();
+	const uint64_t start = OS::get_singleton()->get_ticks_usec();
+
+	LocalVector<BenchmarkNodeData<TProperties, TGroups>> nodes;
+	nodes.resize(p_counts.size());
+	for (uint32_t i = 0; i < p_counts.size(); i++) {
+		BenchmarkNodeData<TProperties, TGroups> &nd = nodes[i];
+		nd.properties.resize(p_counts[i].first);
+		for (int j = 0; j < nd.properties.size(); j++) {
+			nd.properties.write[j].name = j;
+			nd.properties.write[j].value = i;
+		}
+		nd.groups.resize(p_counts[i].second);
+		for (int j = 0; j < nd.groups.size(); j++) {
+			nd.groups.write[j] = j;
+		}
+	}
+
+	const uint64_t usec = OS::get_singleton()->get_ticks_usec() - start;
+	const uint64_t allocs = Memory::get_alloc_count() - allocs_before;
+	const uint64_t usage = Memory::get_mem_usage() - usage_before;
+
+	MESSAGE(vformat("%s node storage: filled in %d usec with %d live allocations (%s).",
+			p_container, usec, allocs, String::humanize_size(usage)));
+}
+
+TEST_CASE("[PackedScene][Benchmark] Loading and instantiating a large scene" * doctest::skip()) {
+	const int node_count = 20000;
+
+	// Nodes override 0 to 8 properties and belong to 0 to 3 groups, so some of them
+	// don't fit in SceneState's inline storage.
+	const Pair<StringName, Variant> overrides[] = {
+		{ "position", Vector2(1, 2) },
+		{ "rotation", 0.5 },
+		{ "scale", Vector2(2, 2) },
+		{ "skew", 0.1 },
+		{ "z_index", 3 },
+		{ "modulate", Color(1, 0, 0) },
+		{ "self_modulate", Color(0, 1, 0) },
+		{ "y_sort_enabled", true },
+	};
+	const int override_count = std::size(overrides);
+	const StringName groups[] = { "benchmark", "enemies", "persistent" };
+	const int group_count = std::size(groups);
+
+	Node *scene = memnew(Node);
+	scene->set_name("TestScene");
+	for (int i = 0; i < node_count; i++) {
+		Node2D *node = memnew(Node2D);
+		node->set_name(vformat("Node%d", i));
+		for (int j = 0; j < i % (override_count + 1); j++) {
+			node->set(overrides[j].first, overrides[j].second);
+		}
+		for (int j = 0; j < i % (group_count + 1); j++) {
+			node->add_to_group(groups[j], true);
+		}
+		scene->add_child(node);
+		node->set_owner(scene);
+	}
+
+	PackedScene packed_scene;
+	CHECK(packed_scene.pack(scene) == OK);
+	memdelete(scene);
+	const Dictionary bundle = packed_scene.get_state()->get_bundled_scene();
+
+	const uint64_t allocs_before = Memory::get_alloc_count();
+	const uint64_t usage_before = Memory::get_mem_usage();
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	Ref<SceneState> state;
+	state.instantiate();
+	state->set_bundled_scene(bundle);
+	const uint64_t load_usec = OS::get_singleton()->get_ticks_usec() - start;
+	const uint64_t allocs = Memory::get_alloc_count() - allocs_before;
+	const uint64_t usage = Memory::get_mem_usage() - usage_before;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	Node *instance = state->instantiate(SceneState::GEN_EDIT_STATE_DISABLED);
+	const uint64_t instantiate_usec = OS::get_singleton()->get_ticks_usec() - start;
+	CHECK(instance->get_child_count() == node_count);
+	memdelete(instance);
+
+	MESSAGE(vformat("%d nodes: loaded in %d usec with %d live allocations (%s), instantiated in %d usec.",
+			node_count, load_usec, allocs, String::humanize_size(usage), instantiate_usec));
+
+	// Baseline: the same per node data stored in Vectors, as SceneState did before SmallVector.
+	LocalVector<Pair<int, int>> counts;
+	counts.resize(state->get_node_count());
+	for (int i = 0; i < state->get_node_count(); i++) {
+		counts[i] = Pair<int, int>(state->get_node_property_count(i), state->get_node_groups(i).size());
+	}
+	_benchmark_node_storage<Vector<BenchmarkProperty>, Vector<int>>("Vector", counts);
+	_benchmark_node_storage<SmallVector<BenchmarkProperty, 4>, SmallVector<int, 2>>("SmallVector", counts);
+}
+
 } // namespace TestPackedScene